@@ -58,6 +58,7 @@ Test profiles are organized under benchmark/tests/:
   tests/server/<name>/   Server benchmarks (h2load → h2agent server under test)
     test.json              metadata (description, requestMethod, requestUri, requestBody, requestHeaders)
     server-provision.json  server provision configuration
+    server-matching.json (optional) server matching configuration (FullMatching by default)
     vault.json   (optional) vault entries
 
   tests/client/<name>/   Client benchmarks (h2agent client under test → h2agent server mock)
@@ -295,7 +296,11 @@ if [ "${BENCH_MODE}" = "server" ]; then
   fi
 
   # Configure server
-  echo '{"algorithm":"FullMatching"}' > ${TMP_DIR}/server-matching.json
+  if [ -f "${TEST_DIR}/server-matching.json" ]; then
+    cp "${TEST_DIR}/server-matching.json" ${TMP_DIR}/server-matching.json
+  else
+    echo '{"algorithm":"FullMatching"}' > ${TMP_DIR}/server-matching.json
+  fi
   h2a_admin_curl DELETE admin/v1/server-provision
   h2a_admin_curl DELETE admin/v1/vault
   h2a_admin_curl POST admin/v1/server-matching 201 ${TMP_DIR}/server-matching.json || exit 1
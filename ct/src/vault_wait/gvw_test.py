@@ -119,3 +119,64 @@ def test_004_wait_specific_value_via_traffic(h2ac_admin, h2ac_traffic, admin_ser
     assert response["status"] == 200
     assert response["body"]["result"] == True
     assert response["body"]["value"] == "ready"
+
+
+def async_wait_uri(key, timeout_ms=None, value=None):
+    q = ["key={}".format(key)]
+    if timeout_ms is not None:
+        q.append("timeoutMs={}".format(timeout_ms))
+    if value is not None:
+        q.append("value={}".format(value))
+    return ADMIN_VAULT_URI + "/wait?" + "&".join(q)
+
+
+@pytest.mark.admin
+def test_005_async_wait_timeout(h2ac_admin):
+    """Asynchronous form: variable never changes => 408 after short timeout"""
+    h2ac_admin.postDict(ADMIN_VAULT_URI, {"ASYNC_STUCK": "initial"})
+
+    response = h2ac_admin.get(async_wait_uri("ASYNC_STUCK", timeout_ms=200, value="never"))
+    assert response["status"] == 408
+    body = response["body"]
+    assert body["result"] == False
+    assert body["key"] == "ASYNC_STUCK"
+    assert body["value"] == "initial"
+    assert body["previousValue"] == "initial"
+
+
+@pytest.mark.admin
+def test_006_async_wait_any_change(h2ac_admin):
+    """Asynchronous form: wait for any change on its own key only"""
+    h2ac_admin.postDict(ADMIN_VAULT_URI, {"ASYNC_SIGNAL": "before"})
+
+    result = {}
+
+    def waiter():
+        h2ac_wait = RestClient(H2AGENT_ENDPOINT__admin)
+        result["response"] = h2ac_wait.get(async_wait_uri("ASYNC_SIGNAL", timeout_ms=5000))
+        h2ac_wait.close()
+
+    t = threading.Thread(target=waiter)
+    t.start()
+
+    time.sleep(0.3)
+    h2ac_admin.postDict(ADMIN_VAULT_URI, {"ASYNC_OTHER": "after"})
+    h2ac_admin.postDict(ADMIN_VAULT_URI, {"ASYNC_SIGNAL": "after"})
+
+    t.join(timeout=6)
+    assert not t.is_alive()
+
+    response = result["response"]
+    assert response["status"] == 200
+    body = response["body"]
+    assert body["result"] == True
+    assert body["key"] == "ASYNC_SIGNAL"
+    assert body["previousValue"] == "before"
+    assert body["value"] == "after"
+
+
+@pytest.mark.admin
+def test_007_async_wait_missing_key(h2ac_admin):
+    """Asynchronous form requires the key query parameter"""
+    response = h2ac_admin.get(ADMIN_VAULT_URI + "/wait?timeoutMs=100")
+    assert response["status"] == 400
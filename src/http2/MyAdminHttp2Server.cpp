@@ -76,6 +76,46 @@ bool statusCodeOK(int statusCode) {
     return (statusCode >= ert::http2comm::ResponseCode::OK && statusCode < ert::http2comm::ResponseCode::MULTIPLE_CHOICES); // [200,300)
 }
 
+namespace
+{
+// Vault wait query parameters: 'value' (json, or string if not json) and 'timeoutMs'
+void vaultWaitParameters(const std::string &queryParams, nlohmann::json &targetValue, unsigned int &timeoutMs) {
+    std::string targetValueStr = "";
+    std::string timeoutMsStr = "";
+    if (!queryParams.empty()) {
+        std::map<std::string, std::string> qmap = h2agent::model::extractQueryParameters(queryParams);
+        auto it = qmap.find("value");
+        if (it != qmap.end()) targetValueStr = it->second;
+        it = qmap.find("timeoutMs");
+        if (it != qmap.end()) timeoutMsStr = it->second;
+    }
+
+    timeoutMs = 30000;
+    if (!timeoutMsStr.empty()) {
+        bool negative = false;
+        std::uint64_t t = 0;
+        if (h2agent::model::string2uint64andSign(timeoutMsStr, t, negative) && !negative) timeoutMs = (unsigned int)t;
+    }
+
+    // targetValue: null means "any change", otherwise match the provided value as json
+    targetValue = nullptr;
+    if (!targetValueStr.empty()) {
+        // Try to parse as JSON, fall back to string
+        targetValue = nlohmann::json::parse(targetValueStr, nullptr, false);
+        if (targetValue.is_discarded()) targetValue = nlohmann::json(targetValueStr);
+    }
+}
+
+std::string vaultWaitResult(bool met, const std::string &key, const nlohmann::json &value, const nlohmann::json &previousValue) {
+    nlohmann::json result;
+    result["result"] = met;
+    result["key"] = key;
+    result["value"] = value;
+    result["previousValue"] = previousValue;
+    return result.dump();
+}
+}
+
 MyAdminHttp2Server::MyAdminHttp2Server(const std::string &name, size_t workerThreads):
     ert::http2comm::Http2Server(name, workerThreads, workerThreads, nullptr) {
 
@@ -548,45 +588,20 @@ void MyAdminHttp2Server::receiveGET(const std::string &uri, const std::string &p
         responseBody = jsonSchema.dump();
         statusCode = ert::http2comm::ResponseCode::OK; // 200
     }
-    else if (std::regex_match(pathSuffix, matches, vaultWait)) { // vault/<key>/wait
+    else if (std::regex_match(pathSuffix, matches, vaultWait)) { // vault/<key>/wait (blocks a worker thread; vault/wait?key=<key> is the asynchronous form)
         if (!wait_manager_) { statusCode = ert::http2comm::ResponseCode::NOT_FOUND; return; }
 
-        std::string targetValueStr = "";
-        std::string timeoutMsStr = "";
-        if (!queryParams.empty()) {
-            std::map<std::string, std::string> qmap = h2agent::model::extractQueryParameters(queryParams);
-            auto it = qmap.find("value");
-            if (it != qmap.end()) targetValueStr = it->second;
-            it = qmap.find("timeoutMs");
-            if (it != qmap.end()) timeoutMsStr = it->second;
-        }
-
-        unsigned int timeoutMs = 30000;
-        if (!timeoutMsStr.empty()) {
-            bool negative = false;
-            std::uint64_t t = 0;
-            if (h2agent::model::string2uint64andSign(timeoutMsStr, t, negative) && !negative) timeoutMs = (unsigned int)t;
-        }
-
-        // targetValue: null means "any change", otherwise match the provided value as json
         nlohmann::json targetValue = nullptr;
-        if (!targetValueStr.empty()) {
-            // Try to parse as JSON, fall back to string
-            targetValue = nlohmann::json::parse(targetValueStr, nullptr, false);
-            if (targetValue.is_discarded()) targetValue = nlohmann::json(targetValueStr);
-        }
+        unsigned int timeoutMs{};
+        vaultWaitParameters(queryParams, targetValue, timeoutMs);
 
         nlohmann::json resultValue, previousValue;
-        bool met = wait_manager_->waitForVault(matches.str(1), targetValue, timeoutMs, resultValue, previousValue);
+        bool rejected{};
+        bool met = wait_manager_->waitForVault(matches.str(1), targetValue, timeoutMs, resultValue, previousValue, &rejected);
 
-        nlohmann::json result;
-        result["result"] = met;
-        result["key"] = matches.str(1);
-        result["value"] = resultValue;
-        result["previousValue"] = previousValue;
-        responseBody = result.dump();
+        responseBody = vaultWaitResult(met, matches.str(1), resultValue, previousValue);
 
-        if (!met && wait_manager_->isFull()) {
+        if (rejected) {
             statusCode = ert::http2comm::ResponseCode::TOO_MANY_REQUESTS; // 429
         }
         else {
@@ -902,6 +917,8 @@ void MyAdminHttp2Server::receivePUT(const std::string &pathSuffix, const std::st
         std::string discard;
         std::string discardKeyHistory;
         std::string disablePurge;
+        std::string maxEventsPerKey;
+        std::string maxBytes;
 
         if (!queryParams.empty()) { // https://stackoverflow.com/questions/978061/http-get-with-request-body#:~:text=Yes.,semantic%20meaning%20to%20the%20request.
             std::map<std::string, std::string> qmap = h2agent::model::extractQueryParameters(queryParams);
@@ -911,23 +928,42 @@ void MyAdminHttp2Server::receivePUT(const std::string &pathSuffix, const std::st
             if (it != qmap.end()) discardKeyHistory = it->second;
             it = qmap.find("disablePurge");
             if (it != qmap.end()) disablePurge = it->second;
+            it = qmap.find("maxEventsPerKey");
+            if (it != qmap.end()) maxEventsPerKey = it->second;
+            it = qmap.find("maxBytes");
+            if (it != qmap.end()) maxBytes = it->second;
         }
 
         bool b_discard = (discard == "true");
         bool b_discardKeyHistory = (discardKeyHistory == "true");
         bool b_disablePurge = (disablePurge == "true");
 
-        success = (!discard.empty() || !discardKeyHistory.empty() || !disablePurge.empty());
+        success = (!discard.empty() || !discardKeyHistory.empty() || !disablePurge.empty() || !maxEventsPerKey.empty() || !maxBytes.empty());
 
         if (success) {
             if (!discard.empty() && !discardKeyHistory.empty())
                 success = !(b_discard && !b_discardKeyHistory); // it has no sense to try to keep history if whole data is discarded
         }
 
+        // Retention limits (non-negative integers, zero for no limit):
+        std::uint64_t u_maxEventsPerKey{};
+        std::uint64_t u_maxBytes{};
+        bool negative{};
+        if (success && !maxEventsPerKey.empty()) success = (h2agent::model::string2uint64andSign(maxEventsPerKey, u_maxEventsPerKey, negative) && !negative);
+        if (success && !maxBytes.empty()) success = (h2agent::model::string2uint64andSign(maxBytes, u_maxBytes, negative) && !negative);
+
         bool serverMode = (pathSuffix == "server-data/configuration"); // true: server mode, false: client mode
         if (serverMode && !getHttp2Server()) { statusCode = ert::http2comm::ResponseCode::NOT_FOUND; return; }
         const char *mode = (serverMode ? "server":"client");
 
+        if (success && (!maxEventsPerKey.empty() || !maxBytes.empty())) {
+            h2agent::model::MockData *data = (serverMode ? static_cast<h2agent::model::MockData*>(getMockServerData()):static_cast<h2agent::model::MockData*>(getMockClientData()));
+            if (maxEventsPerKey.empty()) u_maxEventsPerKey = data->getMaxEventsPerKey();
+            if (maxBytes.empty()) u_maxBytes = data->getMaxBytes();
+            data->setRetention(u_maxEventsPerKey, u_maxBytes);
+            LOGWARNING(ert::tracing::Logger::warning(ert::tracing::Logger::asString("%s-data retention: max events per key %llu, max bytes %llu (0: no limit)", mode, (unsigned long long)u_maxEventsPerKey, (unsigned long long)u_maxBytes), ERT_FILE_LOCATION));
+        }
+
         if (success) {
             if (!discard.empty()) {
                 if (serverMode) getHttp2Server()->discardData(b_discard);
@@ -1210,6 +1246,7 @@ void MyAdminHttp2Server::triggerClientOperation(const std::string &clientProvisi
     std::string sequenceEnd = "";
     std::string cps = "";
     std::string repeat = "";
+    std::string arrival = "";
 
     if (!queryParams.empty()) { // https://stackoverflow.com/questions/978061/http-get-with-request-body#:~:text=Yes.,semantic%20meaning%20to%20the%20request.
         std::map<std::string, std::string> qmap = h2agent::model::extractQueryParameters(queryParams);
@@ -1225,12 +1262,14 @@ void MyAdminHttp2Server::triggerClientOperation(const std::string &clientProvisi
         if (it != qmap.end()) cps = it->second;
         it = qmap.find("repeat");
         if (it != qmap.end()) repeat = it->second;
+        it = qmap.find("arrival");
+        if (it != qmap.end()) arrival = it->second;
     }
 
     // Validate exclusivity: 'sequence' cannot be mixed with async dynamics parameters
-    bool hasDynamics = (!sequenceBegin.empty() || !sequenceEnd.empty() || !cps.empty() || !repeat.empty());
+    bool hasDynamics = (!sequenceBegin.empty() || !sequenceEnd.empty() || !cps.empty() || !repeat.empty() || !arrival.empty());
     if (!sequence.empty() && hasDynamics) {
-        LOGWARNING(ert::tracing::Logger::warning("Parameter 'sequence' is exclusive and cannot be mixed with 'sequenceBegin', 'sequenceEnd', 'cps' or 'repeat'", ERT_FILE_LOCATION));
+        LOGWARNING(ert::tracing::Logger::warning("Parameter 'sequence' is exclusive and cannot be mixed with 'sequenceBegin', 'sequenceEnd', 'cps', 'repeat' or 'arrival'", ERT_FILE_LOCATION));
         statusCode = ert::http2comm::ResponseCode::BAD_REQUEST; // 400
         return;
     }
@@ -1260,7 +1299,7 @@ void MyAdminHttp2Server::triggerClientOperation(const std::string &clientProvisi
     }
 
     if (hasDynamics) {
-        if (provision->updateTriggering(sequenceBegin, sequenceEnd, cps, repeat)) {
+        if (provision->updateTriggering(sequenceBegin, sequenceEnd, cps, repeat, arrival)) {
             statusCode = ert::http2comm::ResponseCode::ACCEPTED; // 202; "sender" operates asynchronously
         }
         else {
@@ -1286,6 +1325,14 @@ void MyAdminHttp2Server::triggerClientOperation(const std::string &clientProvisi
     // Timer-based triggering (cps > 0) or single request
     if (statusCode == ert::http2comm::ResponseCode::ACCEPTED && provision->getCps() > 0) {
         if (!provision->isTicking()) {
+            if (client_provision_cps_gauge_family_) {
+                const std::string &source = common_resources_.ApplicationName;
+                const std::string &id = provision->getClientProvisionId();
+                provision->setSchedulerGauges(&(client_provision_cps_gauge_family_->Add({{"source", source}, {"client_provision_id", id}, {"type", "target"}})),
+                                              &(client_provision_cps_gauge_family_->Add({{"source", source}, {"client_provision_id", id}, {"type", "achieved"}})),
+                                              &(client_provision_scheduling_lag_gauge_family_->Add({{"source", source}, {"client_provision_id", id}})));
+                provision->setSchedulerCounters(&(client_provision_dropped_sequences_counter_family_->Add({{"source", source}, {"client_provision_id", id}})));
+            }
             provision->startTicking(timers_io_context_, [this, provision, inState, clientEndpoint]() -> bool {
                 auto tickSeq = provision->getSeq(); // capture BEFORE post (timer thread)
                 if (client_worker_io_context_) {
@@ -1299,7 +1346,7 @@ void MyAdminHttp2Server::triggerClientOperation(const std::string &clientProvisi
                 }
             });
         }
-        // else: already ticking — cps_ was updated atomically by updateTriggering,
+        // else: already ticking — cps_ (and arrival profile) was updated atomically by updateTriggering,
         // the timer will pick up the new rate on the next scheduleTick cycle.
     }
     else if (statusCode == ert::http2comm::ResponseCode::ACCEPTED && provision->getCps() == 0) {
@@ -1316,21 +1363,26 @@ std::string MyAdminHttp2Server::clientDataConfigurationAsJsonString() const {
     result["storeEvents"] = client_data_;
     result["storeEventsKeyHistory"] = client_data_key_history_;
     result["purgeExecution"] = purge_execution_;
+    // Retention limits (only when configured):
+    if (getMockClientData()->getMaxEventsPerKey() != 0) result["maxEventsPerKey"] = getMockClientData()->getMaxEventsPerKey();
+    if (getMockClientData()->getMaxBytes() != 0) result["maxBytes"] = getMockClientData()->getMaxBytes();
     result["needsStorage"] = admin_data_->getClientProvisionData().needsStorage();
 
     return result.dump();
 }
 
 void MyAdminHttp2Server::registerHandlers() {
-    if (!sse_manager_) return;
-
     std::string apiPath = getApiPath(); // e.g. "/admin/v1"
 
+    if (wait_manager_) registerVaultWaitHandler(apiPath);
+    if (!sse_manager_) return;
+
     server_.handle(apiPath + "/vault/events", [this](const nghttp2::asio_http2::server::request &req,
                                                       const nghttp2::asio_http2::server::response &res) {
         LOGDEBUG(ert::tracing::Logger::debug("SSE handler invoked", ERT_FILE_LOCATION));
-        // Parse key= query parameters from URI
+        // Parse key= (repeatable) and coalesce= query parameters from URI
         std::unordered_set<std::string> keys;
+        bool coalesce = false;
         std::string query = req.uri().raw_query;
         if (!query.empty()) {
             std::istringstream iss(query);
@@ -1339,23 +1391,35 @@ void MyAdminHttp2Server::registerHandlers() {
                 if (param.rfind("key=", 0) == 0) {
                     keys.insert(param.substr(4));
                 }
+                else if (param == "coalesce=true") {
+                    coalesce = true;
+                }
             }
         }
 
-        // Shared buffer between generator and notify callback
-        auto buffer = std::make_shared<std::string>();
-        auto buffer_mutex = std::make_shared<std::mutex>();
-
         // Send SSE headers
         nghttp2::asio_http2::header_map headers;
         headers.emplace("content-type", nghttp2::asio_http2::header_value{"text/event-stream", false});
         headers.emplace("cache-control", nghttp2::asio_http2::header_value{"no-cache", false});
         res.write_head(200, std::move(headers));
 
-        // Generator callback: called by nghttp2 when ready to send data
-        res.end([buffer, buffer_mutex](uint8_t *buf, size_t len, uint32_t *data_flags) -> ssize_t {
-            std::lock_guard<std::mutex> lock(*buffer_mutex);
-            if (buffer->empty()) {
+        // Register SSE connection: events are queued by the manager dispatcher, which
+        // resumes the stream when the connection queue stops being empty
+        auto sse_manager = sse_manager_;
+        auto closed = std::make_shared<bool>(false); // only accessed from the event loop thread
+        auto &ioContext = ert::http2comm::asio_compat::io_context(res);
+        uint64_t connId = sse_manager_->addConnection(std::move(keys), coalesce, [&ioContext, &res, closed] {
+            // resume() must run on the nghttp2 event loop thread
+            boost::asio::post(ioContext, [&res, closed] {
+                if (!*closed) res.resume();
+            });
+        });
+
+        // Generator callback: called by nghttp2 (event loop thread) when ready to send data.
+        // Pending events are drained from the connection queue only when the former ones are sent.
+        auto buffer = std::make_shared<std::string>();
+        res.end([sse_manager, connId, buffer](uint8_t *buf, size_t len, uint32_t *data_flags) -> ssize_t {
+            if (buffer->empty() && !sse_manager->take(connId, *buffer)) {
                 return NGHTTP2_ERR_DEFERRED; // no data, pause stream
             }
             size_t n = std::min(len, buffer->size());
@@ -1364,27 +1428,90 @@ void MyAdminHttp2Server::registerHandlers() {
             return static_cast<ssize_t>(n);
         });
 
-        // Register SSE connection: on notify, buffer data and resume stream
-        auto sse_manager = sse_manager_;
-        uint64_t connId = sse_manager_->addConnection(std::move(keys),
-            [buffer, buffer_mutex, &res](const std::string &data) {
-                LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("SSE notify callback: buffering %zu bytes", data.size()), ERT_FILE_LOCATION));
-                {
-                    std::lock_guard<std::mutex> lock(*buffer_mutex);
-                    buffer->append(data);
-                }
-                // resume() must run on the nghttp2 event loop thread
-                boost::asio::post(ert::http2comm::asio_compat::io_context(res), [&res] {
-                    res.resume();
-                });
-            });
-
         // On stream close, remove the connection
-        res.on_close([sse_manager, connId](uint32_t) {
+        res.on_close([sse_manager, connId, closed](uint32_t) {
+            *closed = true;
             sse_manager->removeConnection(connId);
         });
     });
 }
 
+void MyAdminHttp2Server::registerVaultWaitHandler(const std::string &apiPath) {
+
+    server_.handle(apiPath + "/vault/wait", [this](const nghttp2::asio_http2::server::request &req,
+                                                    const nghttp2::asio_http2::server::response &res) {
+        LOGDEBUG(ert::tracing::Logger::debug("Vault wait handler invoked", ERT_FILE_LOCATION));
+        const std::string &query = req.uri().raw_query;
+
+        std::string key{};
+        if (!query.empty()) {
+            std::map<std::string, std::string> qmap = h2agent::model::extractQueryParameters(query);
+            auto it = qmap.find("key");
+            if (it != qmap.end()) key = it->second;
+        }
+
+        if (key.empty()) {
+            res.write_head(ert::http2comm::ResponseCode::BAD_REQUEST); // 400
+            res.end();
+            return;
+        }
+
+        nghttp2::asio_http2::header_map headers;
+        headers.emplace("content-type", nghttp2::asio_http2::header_value{"application/json", false});
+
+        nlohmann::json targetValue = nullptr;
+        unsigned int timeoutMs{};
+        vaultWaitParameters(query, targetValue, timeoutMs);
+        timeoutMs = std::min(timeoutMs, model::WaitManager::MAX_TIMEOUT_MS);
+
+        // Stream state is only accessed from the nghttp2 event loop thread (completions are posted there):
+        struct WaitStream {
+            std::uint64_t id{};
+            bool answered{};
+            bool closed{};
+        };
+        auto stream = std::make_shared<WaitStream>();
+        auto &ioContext = ert::http2comm::asio_compat::io_context(res);
+        auto timer = std::make_shared<boost::asio::steady_timer>(ioContext, std::chrono::milliseconds(timeoutMs));
+
+        auto answer = [stream, timer, headers, &res](unsigned int statusCode, const std::string &body) {
+            if (stream->answered || stream->closed) return;
+            stream->answered = true;
+            timer->cancel();
+            res.write_head(statusCode, headers);
+            res.end(body);
+        };
+
+        model::WaitManager *waitManager = wait_manager_;
+        stream->id = waitManager->watch(key, targetValue, [&ioContext, answer, key](bool met, const nlohmann::json &value, const nlohmann::json &previousValue) {
+            // Called from the vault writer thread (or on shutdown): answer from the event loop
+            std::string body = vaultWaitResult(met, key, value, previousValue);
+            boost::asio::post(ioContext, [answer, met, body] {
+                answer(met ? ert::http2comm::ResponseCode::OK : ert::http2comm::ResponseCode::REQUEST_TIMEOUT, body); // 200 or 408
+            });
+        });
+
+        if (stream->id == 0) {
+            answer(ert::http2comm::ResponseCode::TOO_MANY_REQUESTS, vaultWaitResult(false, key, nullptr, nullptr)); // 429
+            return;
+        }
+
+        timer->async_wait([this, waitManager, stream, key, answer](const boost::system::error_code& e) {
+            if (e) return; // cancelled (already answered or closed)
+            nlohmann::json value = nullptr, previousValue = nullptr;
+            if (!waitManager->cancel(key, stream->id, previousValue)) return; // completion already posted
+            getVault()->tryGet(key, value);
+            answer(ert::http2comm::ResponseCode::REQUEST_TIMEOUT, vaultWaitResult(false, key, value, previousValue)); // 408
+        });
+
+        res.on_close([waitManager, stream, timer, key](uint32_t) {
+            stream->closed = true;
+            timer->cancel();
+            nlohmann::json previousValue;
+            waitManager->cancel(key, stream->id, previousValue);
+        });
+    });
+}
+
 }
 }
@@ -98,6 +98,11 @@ class MyAdminHttp2Server: public ert::http2comm::Http2Server
     uint64_t max_pending_pool_dispatches_{0}; // 0 = unlimited
     prometheus::Counter *discarded_dispatches_counter_{}; // prometheus metric
 
+    // Client provisions scheduler metrics (instances added per provision when ticking starts):
+    ert::metrics::gauge_family_t *client_provision_cps_gauge_family_{};
+    ert::metrics::gauge_family_t *client_provision_scheduling_lag_gauge_family_{};
+    ert::metrics::counter_family_t *client_provision_dropped_sequences_counter_family_{};
+
     // Client data storage:
     bool client_data_{};
     bool client_data_key_history_{};
@@ -113,6 +118,9 @@ class MyAdminHttp2Server: public ert::http2comm::Http2Server
     void receivePUT(const std::string &pathSuffix, const std::string &queryParams, unsigned int& statusCode, nghttp2::asio_http2::header_map& headers, std::string &responseBody);
 
     void triggerClientOperation(const std::string &clientProvisionId, const std::string &queryParams, unsigned int& statusCode) const;
+    // Asynchronous vault wait (long-poll) on /admin/v1/vault/wait?key=<key> (no worker thread parked per waiter):
+    void registerVaultWaitHandler(const std::string &apiPath);
+
     void sendClientRequest(std::shared_ptr<model::AdminClientProvision> provision, const std::string &inState, std::shared_ptr<model::AdminClientEndpoint> clientEndpoint, std::int64_t seq = -1, std::shared_ptr<std::map<std::string, std::string>> chainVariables = nullptr, std::shared_ptr<std::vector<std::pair<model::DataKey, std::uint64_t>>> purgeKeys = nullptr) const;
 
 public:
@@ -176,6 +184,10 @@ public:
             ert::metrics::labels_t familyLabels = {};
             ert::metrics::counter_family_t& cf = metrics->addCounterFamily("h2agent_traffic_client_discarded_dispatches_counter", "Ticks discarded due to pool congestion in h2agent_traffic_client", familyLabels);
             discarded_dispatches_counter_ = &(cf.Add({{"source", applicationName}}));
+
+            client_provision_cps_gauge_family_ = &(metrics->addGaugeFamily("h2agent_traffic_client_provision_cps_gauge", "Target and achieved rate for client provisions triggering in h2agent_traffic_client", familyLabels));
+            client_provision_scheduling_lag_gauge_family_ = &(metrics->addGaugeFamily("h2agent_traffic_client_provision_scheduling_lag_seconds_gauge", "Timer expiration lag for client provisions triggering in h2agent_traffic_client", familyLabels));
+            client_provision_dropped_sequences_counter_family_ = &(metrics->addCounterFamily("h2agent_traffic_client_provision_dropped_sequences_counter", "Sequences due but not triggered due to congestion for client provisions in h2agent_traffic_client", familyLabels));
         }
     }
 
@@ -201,7 +213,8 @@ public:
     void setSseManager(model::SseManager *p) { sse_manager_ = p; }
 
     /**
-     * Registers the SSE handler for /admin/v1/vault/events on the nghttp2 server.
+     * Registers the SSE handler for /admin/v1/vault/events and the asynchronous
+     * vault wait handler for /admin/v1/vault/wait on the nghttp2 server.
      * Called automatically via registerHandlers() (after generic handler registration).
      */
     void registerHandlers() override;
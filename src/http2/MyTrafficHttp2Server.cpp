@@ -90,6 +90,15 @@ void MyTrafficHttp2Server::enableMyMetrics(ert::metrics::Metrics *metrics, const
 
         purged_contexts_successful_counter_ = &(cf2.Add({{"source", src}, {"result", "successful"}}));
         purged_contexts_failed_counter_ = &(cf2.Add({{"source", src}, {"result", "failed"}}));
+
+        ert::metrics::counter_family_t& cf3 = metrics->addCounterFamily("h2agent_traffic_server_dropped_sending_timestamps_counter", "Events missing sending timestamp due to pending table overflow in h2agent_traffic_server", familyLabels);
+
+        dropped_sending_timestamps_counter_ = &(cf3.Add({{"source", src}}));
+
+        ert::metrics::counter_family_t& cf4 = metrics->addCounterFamily("h2agent_traffic_server_regex_replace_cache_counter", "Memoized FullMatchingRegexReplace classifications lookups in h2agent_traffic_server", familyLabels);
+
+        regex_replace_cache_hits_counter_ = &(cf4.Add({{"source", src}, {"result", "hit"}}));
+        regex_replace_cache_misses_counter_ = &(cf4.Add({{"source", src}, {"result", "miss"}}));
     }
 }
 
@@ -129,6 +138,9 @@ std::string MyTrafficHttp2Server::dataConfigurationAsJsonString() const {
     result["storeEvents"] = server_data_;
     result["storeEventsKeyHistory"] = server_data_key_history_;
     result["purgeExecution"] = purge_execution_;
+    // Retention limits (only when configured):
+    if (getMockServerData()->getMaxEventsPerKey() != 0) result["maxEventsPerKey"] = getMockServerData()->getMaxEventsPerKey();
+    if (getMockServerData()->getMaxBytes() != 0) result["maxBytes"] = getMockServerData()->getMaxBytes();
     result["needsStorage"] = admin_data_->getServerProvisionData().needsStorage();
 
     return result.dump();
@@ -146,12 +158,148 @@ std::string MyTrafficHttp2Server::configurationAsJsonString() const {
 bool MyTrafficHttp2Server::receiveDataLen(const nghttp2::asio_http2::server::request& req) {
     LOGDEBUG(ert::tracing::Logger::debug("receiveRequestBody()",  ERT_FILE_LOCATION));
 
-    // TODO: we could analyze req to get the provision and find out if request body is actually needed.
-    // To cache the analysis, we should use complete URI as map key (data/len could be received in
-    // chunks and that's why data/len reception sequence id is not valid and it is not provided by
-    // http2comm library through this virtual method).
+    if (!receive_request_body_.load()) return false;
+
+    // Stored events keep the request body:
+    if (server_data_) return true;
+
+    // Classification below assumes the initial state for every key:
+    if (getMockServerData()->sessionsSize() != 0) return true;
+
+    const std::string &method = req.method();
+    const std::string &uriPath = req.uri().path;
+    const std::string &uriQuery = req.uri().raw_query;
+
+    // Cache key: method and complete URI (data/len could be received in chunks, and reception
+    // sequence id is not provided by http2comm library through this virtual method):
+    thread_local std::string key;
+    key.clear();
+    key += method;
+    key += ' ';
+    key += uriPath;
+    if (!uriQuery.empty()) {
+        key += '?';
+        key += uriQuery;
+    }
+
+    // Snapshots taken before classification, so a concurrent update just invalidates the result:
+    std::uint64_t generation = getAdminData()->getServerProvisionData().getGeneration();
+    auto matchingConfig = getAdminData()->getServerMatchingData().getConfig();
+
+    {
+        h2agent::model::read_guard_t guard(request_body_policy_mutex_);
+        if (request_body_policy_generation_ == generation && request_body_policy_matching_config_ == matchingConfig) {
+            auto it = request_body_policy_.find(key);
+            if (it != request_body_policy_.end()) return it->second;
+        }
+    }
+
+    bool result = classifyRequestBody(method, uriPath, uriQuery, *matchingConfig);
+
+    LOGDEBUG(
+        std::string msg = ert::tracing::Logger::asString("Request body reception policy for '%s': %s", key.c_str(), result ? "receive":"discard");
+        ert::tracing::Logger::debug(msg, ERT_FILE_LOCATION);
+    );
+
+    h2agent::model::write_guard_t guard(request_body_policy_mutex_);
+    if (request_body_policy_generation_ != generation || request_body_policy_matching_config_ != matchingConfig) {
+        request_body_policy_.clear();
+        request_body_policy_generation_ = generation;
+        request_body_policy_matching_config_ = std::move(matchingConfig);
+    }
+    else if (request_body_policy_.size() >= RequestBodyPolicyCacheCapacity) {
+        request_body_policy_.clear(); // bounded: URIs could carry variable parts
+    }
+    request_body_policy_.emplace(key, result);
+
+    return result;
+}
+
+bool MyTrafficHttp2Server::classifyRequestBody(const std::string &method, const std::string &uriPath, const std::string &uriQuery, const h2agent::model::AdminServerMatchingData::Config &matchingConfig) const {
+
+    std::string classificationUri = uriPath;
+    if (!uriQuery.empty()) {
+        switch (matchingConfig.uri_path_query_parameters_filter) {
+        case h2agent::model::AdminServerMatchingData::PassBy:
+            classificationUri += "?";
+            classificationUri += uriQuery;
+            break;
+        case h2agent::model::AdminServerMatchingData::Sort:
+        {
+            char separator = ((matchingConfig.uri_path_query_parameters_separator == h2agent::model::AdminServerMatchingData::Ampersand) ? '&':';');
+            thread_local std::vector<h2agent::model::QueryParameter> queryParameters;
+            h2agent::model::splitQueryParameters(uriQuery, queryParameters, separator);
+            classificationUri += "?";
+            h2agent::model::appendQueryParameters(classificationUri, queryParameters, separator);
+            break;
+        }
+        case h2agent::model::AdminServerMatchingData::Ignore:
+            break;
+        }
+    }
+
+    // Without storage, the reception is always processed in initial state:
+    auto provision = findProvision(matchingConfig, DEFAULT_ADMIN_PROVISION_STATE, method, classificationUri, false /* counted on reception classification */);
+
+    // Unprovisioned receptions are answered with 501 (and nothing is stored):
+    return (provision && provision->needsRequestBody());
+}
+
+std::shared_ptr<h2agent::model::AdminServerProvision> MyTrafficHttp2Server::findProvision(const h2agent::model::AdminServerMatchingData::Config &matchingConfig, const std::string &inState, const std::string &method, std::string &classificationUri, bool observeCache) const {
+
+    const h2agent::model::AdminServerProvisionData & provisionData = getAdminData()->getServerProvisionData();
+    std::shared_ptr<h2agent::model::AdminServerProvision> provision(nullptr);
+
+    switch (matchingConfig.algorithm) {
+    case h2agent::model::AdminServerMatchingData::FullMatching:
+        LOGDEBUG(
+            std::string msg = ert::tracing::Logger::asString("Searching 'FullMatching' provision for method '%s', classification uri '%s' and state '%s'", method.c_str(), classificationUri.c_str(), inState.c_str());
+            ert::tracing::Logger::debug(msg, ERT_FILE_LOCATION);
+        );
+        provision = provisionData.find(inState, method, classificationUri);
+        break;
+
+    case h2agent::model::AdminServerMatchingData::FullMatchingRegexReplace:
+        // In this case, our classification URI is pending to be transformed:
+        {
+            bool cached = matchingConfig.regexReplace(classificationUri); // memoized replacement
+            // metrics
+            if(metrics_ && observeCache) {
+                if (cached) regex_replace_cache_hits_counter_->Increment();
+                else regex_replace_cache_misses_counter_->Increment();
+            }
+        }
+        LOGDEBUG(
+            std::string msg = ert::tracing::Logger::asString("Classification Uri (after regex-replace transformation): %s", classificationUri.c_str());
+            ert::tracing::Logger::debug(msg, ERT_FILE_LOCATION);
+            msg = ert::tracing::Logger::asString("Searching 'FullMatchingRegexReplace' provision for method '%s', classification uri '%s' and state '%s'", method.c_str(), classificationUri.c_str(), inState.c_str());
+            ert::tracing::Logger::debug(msg, ERT_FILE_LOCATION);
+        );
+        provision = provisionData.find(inState, method, classificationUri);
+        break;
+    case h2agent::model::AdminServerMatchingData::RegexMatching:
+        LOGDEBUG(
+            std::string msg = ert::tracing::Logger::asString("Searching 'RegexMatching' provision for method '%s', classification uri '%s' and state '%s'", method.c_str(), classificationUri.c_str(), inState.c_str());
+            ert::tracing::Logger::debug(msg, ERT_FILE_LOCATION);
+        );
+
+        // as provision key is built combining inState, method and uri fields, a regular expression could also be provided for inState
+        //  (method is strictly checked). TODO could we avoid this rare and unpredictable usage ?
+        provision = provisionData.findRegexMatching(inState, method, classificationUri);
+        break;
+    }
+
+    // Fall back to possible default provision (empty URI):
+    if (!provision) {
+        LOGDEBUG(
+            std::string msg = ert::tracing::Logger::asString("No provision found for classification URI. Trying with default fallback provision for '%s'", method.c_str());
+            ert::tracing::Logger::debug(msg, ERT_FILE_LOCATION);
+        );
+
+        provision = provisionData.find(inState, method, "");
+    }
 
-    return receive_request_body_.load();
+    return provision;
 }
 
 bool MyTrafficHttp2Server::preReserveRequestBody() {
@@ -213,33 +361,35 @@ ss << "TRAFFIC REQUEST RECEIVED"
 // Matching configuration snapshot (held for the duration of this request):
     auto matchingConfig = getAdminData()->getServerMatchingData().getConfig();
 
-    // Normalized URI: original URI with query parameters normalized (ordered) / Classification URI: may ignore, sort or pass by query parameters
-    std::string normalizedUri = uriPath;
-    std::string classificationUri = uriPath;
+    // Normalized URI: original URI with query parameters normalized (ordered) / Classification URI: may ignore, sort or pass by query parameters.
+    // Buffers are reused by the worker thread, and query parameters are views over the original query string:
+    thread_local std::string normalizedUri;
+    thread_local std::string classificationUri;
+    thread_local std::vector<h2agent::model::QueryParameter> queryParameters;
 
-    // Query parameters transformation:
-    std::map<std::string, std::string> qmap; // query parameters map
+    normalizedUri.assign(uriPath);
+    queryParameters.clear();
     if (!uriQuery.empty()) {
         char separator = ((matchingConfig->uri_path_query_parameters_separator == h2agent::model::AdminServerMatchingData::Ampersand) ? '&':';');
-        std::string uriQueryNormalized;
-        std::string *ptr_uriQueryNormalized = &uriQueryNormalized;
-        qmap = h2agent::model::extractQueryParameters(uriQuery, ptr_uriQueryNormalized, separator); // needed even for 'Ignore' QParam filter type
-
-        normalizedUri += "?";
-        normalizedUri += uriQueryNormalized;
+        h2agent::model::splitQueryParameters(uriQuery, queryParameters, separator); // needed even for 'Ignore' QParam filter type
+        normalizedUri += '?';
+        h2agent::model::appendQueryParameters(normalizedUri, queryParameters, separator);
+    }
 
-        switch (matchingConfig->uri_path_query_parameters_filter) {
-        case h2agent::model::AdminServerMatchingData::PassBy:
-            classificationUri += "?";
+    switch (matchingConfig->uri_path_query_parameters_filter) {
+    case h2agent::model::AdminServerMatchingData::PassBy:
+        classificationUri.assign(uriPath);
+        if (!uriQuery.empty()) {
+            classificationUri += '?';
             classificationUri += uriQuery;
-            break;
-        case h2agent::model::AdminServerMatchingData::Sort:
-            classificationUri += "?";
-            classificationUri += uriQueryNormalized;
-            break;
-        case h2agent::model::AdminServerMatchingData::Ignore:
-            break;
         }
+        break;
+    case h2agent::model::AdminServerMatchingData::Sort:
+        classificationUri.assign(normalizedUri);
+        break;
+    case h2agent::model::AdminServerMatchingData::Ignore:
+        classificationUri.assign(uriPath);
+        break;
     }
 
     LOGDEBUG(
@@ -248,15 +398,13 @@ ss << "TRAFFIC REQUEST RECEIVED"
         ert::tracing::Logger::debug(ss.str(), ERT_FILE_LOCATION);
     );
 
-// Admin provision:
-    const h2agent::model::AdminServerProvisionData & provisionData = getAdminData()->getServerProvisionData();
-
 // Find mock context:
-    std::string inState{};
-    std::map<std::string, std::string> chainVariables{};
-    h2agent::model::DataKey normalizedKey(method, normalizedUri);
+    static const std::string initialState(DEFAULT_ADMIN_PROVISION_STATE);
+    h2agent::model::CompositeKeyView normalizedKeyView(method, normalizedUri); // events data key is only built when storing
 
-    /*bool requestFound = */getMockServerData()->findLastRegisteredRequestState(normalizedKey, inState, chainVariables); // if not found, inState will be 'initial'
+    // Session shared (immutable) to avoid copies: if not found, inState will be 'initial'
+    auto session = getMockServerData()->findSession(normalizedKeyView);
+    const std::string &inState = session ? session->state : initialState;
 
 // Matching algorithm:
     h2agent::model::AdminServerMatchingData::AlgorithmType algorithmType = matchingConfig->algorithm;
@@ -270,47 +418,7 @@ ss << "TRAFFIC REQUEST RECEIVED"
     }
     );
 
-    switch (algorithmType) {
-    case h2agent::model::AdminServerMatchingData::FullMatching:
-        LOGDEBUG(
-            std::string msg = ert::tracing::Logger::asString("Searching 'FullMatching' provision for method '%s', classification uri '%s' and state '%s'", method.c_str(), classificationUri.c_str(), inState.c_str());
-            ert::tracing::Logger::debug(msg, ERT_FILE_LOCATION);
-        );
-        provision = provisionData.find(inState, method, classificationUri);
-        break;
-
-    case h2agent::model::AdminServerMatchingData::FullMatchingRegexReplace:
-        // In this case, our classification URI is pending to be transformed:
-        classificationUri = std::regex_replace(classificationUri, matchingConfig->rgx, matchingConfig->fmt);
-        LOGDEBUG(
-            std::string msg = ert::tracing::Logger::asString("Classification Uri (after regex-replace transformation): %s", classificationUri.c_str());
-            ert::tracing::Logger::debug(msg, ERT_FILE_LOCATION);
-            msg = ert::tracing::Logger::asString("Searching 'FullMatchingRegexReplace' provision for method '%s', classification uri '%s' and state '%s'", method.c_str(), classificationUri.c_str(), inState.c_str());
-            ert::tracing::Logger::debug(msg, ERT_FILE_LOCATION);
-        );
-        provision = provisionData.find(inState, method, classificationUri);
-        break;
-    case h2agent::model::AdminServerMatchingData::RegexMatching:
-        LOGDEBUG(
-            std::string msg = ert::tracing::Logger::asString("Searching 'RegexMatching' provision for method '%s', classification uri '%s' and state '%s'", method.c_str(), classificationUri.c_str(), inState.c_str());
-            ert::tracing::Logger::debug(msg, ERT_FILE_LOCATION);
-        );
-
-        // as provision key is built combining inState, method and uri fields, a regular expression could also be provided for inState
-        //  (method is strictly checked). TODO could we avoid this rare and unpredictable usage ?
-        provision = provisionData.findRegexMatching(inState, method, classificationUri);
-        break;
-    }
-
-    // Fall back to possible default provision (empty URI):
-    if (!provision) {
-        LOGDEBUG(
-            std::string msg = ert::tracing::Logger::asString("No provision found for classification URI. Trying with default fallback provision for '%s'", method.c_str());
-            ert::tracing::Logger::debug(msg, ERT_FILE_LOCATION);
-        );
-
-        provision = provisionData.find(inState, method, "");
-    }
+    provision = findProvision(*matchingConfig, inState, method, classificationUri);
 
     if (provision) {
 
@@ -322,6 +430,14 @@ ss << "TRAFFIC REQUEST RECEIVED"
         std::string outStateUri;
         std::vector<std::pair<std::string, std::string>> clientProvisionTriggers;
 
+        // Chain variables are only copied when the session carries them:
+        std::map<std::string, std::string> chainVariables{};
+        if (session && session->chainVariables) chainVariables = *(session->chainVariables);
+
+        // Query parameters map is only materialized for 'request.uri.param' sources:
+        std::map<std::string, std::string> qmap;
+        if (provision->needsQueryParametersMap()) qmap = h2agent::model::queryParametersMap(queryParameters);
+
         // Process provision
         provision->transform(normalizedUri, uriPath, qmap, requestBodyDataPart, req.header(), receptionId,
                              statusCode, headers, responseBody, responseDelayMs, outState, outStateMethod, outStateUri, clientProvisionTriggers, chainVariables);
@@ -338,7 +454,7 @@ ss << "TRAFFIC REQUEST RECEIVED"
             bool somethingDeleted = false;
 
             // Purge current key:
-            getMockServerData()->clear(somethingDeleted, h2agent::model::EventKey(normalizedKey, ""));
+            getMockServerData()->clear(somethingDeleted, h2agent::model::EventKey(method, normalizedUri, ""));
 
             LOGDEBUG(
                 std::string msg = ert::tracing::Logger::asString("Requested purge in out-state. Removal %s", somethingDeleted ? "successful":"failed");
@@ -352,33 +468,40 @@ ss << "TRAFFIC REQUEST RECEIVED"
         }
         else {
             bool hasVirtualMethod = !outStateMethod.empty();
+            const std::string &keyOutState = (hasVirtualMethod ? provision->getOutState():outState);
 
             // Store event context information
             if (server_data_) {
+                h2agent::model::DataKey normalizedKey(method, normalizedUri);
                 normalizedKey.setProvisionUri(provision->getRequestUri()); // additional context
-                getMockServerData()->loadEvent(normalizedKey, inState, (hasVirtualMethod ? provision->getOutState():outState), receptionTimestampUs, statusCode, req.header(), headers, requestBodyDataPart, responseBody, receptionId, responseDelayMs, server_data_key_history_ /* history enabled */);
+                auto event = getMockServerData()->loadEvent(normalizedKey, inState, keyOutState, receptionTimestampUs, statusCode, req.header(), headers, requestBodyDataPart, responseBody, receptionId, responseDelayMs, server_data_key_history_ /* history enabled */);
 
                 // Register for sendingTimestampUs capture in streamClose:
-                {
-                    std::lock_guard<std::mutex> guard(pending_events_mutex_);
-                    pending_events_[receptionId] = getMockServerData()->getLastLoadedEvent();
-                }
+                addPendingEvent(receptionId, std::move(event));
+            }
 
-                // Store chain variables for next outState link:
-                getMockServerData()->storeChainVariables(normalizedKey, chainVariables);
+            // Session for next outState link (chain variables included). As state is server data, nothing
+            // is kept when storage is discarded (stateless traffic does not grow memory per request):
+            if (server_data_) {
+                std::shared_ptr<const std::map<std::string, std::string>> nextChainVariables{};
+                if (!chainVariables.empty()) nextChainVariables = std::make_shared<const std::map<std::string, std::string>>(std::move(chainVariables));
+                getMockServerData()->updateSession(normalizedKeyView, keyOutState, std::move(nextChainVariables));
+            }
 
-                // Virtual storage:
-                if (hasVirtualMethod) {
-                    LOGWARNING(
-                        if (outStateMethod == method && outStateUri.empty()) ert::tracing::Logger::warning(ert::tracing::Logger::asString("Redundant 'outState' foreign method with current provision one: '%s'", method.c_str()), ERT_FILE_LOCATION);
-                    );
-                    if (outStateUri.empty()) {
-                        outStateUri = normalizedUri; // by default
-                    }
+            // Virtual storage:
+            if (hasVirtualMethod) {
+                LOGWARNING(
+                    if (outStateMethod == method && outStateUri.empty()) ert::tracing::Logger::warning(ert::tracing::Logger::asString("Redundant 'outState' foreign method with current provision one: '%s'", method.c_str()), ERT_FILE_LOCATION);
+                );
+                if (outStateUri.empty()) {
+                    outStateUri = normalizedUri; // by default
+                }
 
+                if (server_data_) {
                     h2agent::model::DataKey foreignKey(outStateMethod /* foreign method */, outStateUri /* foreign uri */);
                     foreignKey.setProvisionUri(provision->getRequestUri()); // additional context
                     getMockServerData()->loadEvent(foreignKey, inState, outState, receptionTimestampUs, statusCode, req.header(), headers, requestBodyDataPart, responseBody, receptionId, responseDelayMs, server_data_key_history_ /* history enabled */, method /* virtual method origin*/, normalizedUri /* virtual uri origin */);
+                    getMockServerData()->updateSessionState(h2agent::model::CompositeKeyView(outStateMethod, outStateUri), outState);
                 }
             }
         }
@@ -395,15 +518,17 @@ ss << "TRAFFIC REQUEST RECEIVED"
         );
 
         statusCode = ert::http2comm::ResponseCode::NOT_IMPLEMENTED; // 501
+
+        // Unprovisioned reception breaks the state machine for this key:
+        getMockServerData()->removeSession(normalizedKeyView);
+
         // Store even if not provision was identified (helps to troubleshoot design problems in test configuration):
         if (server_data_) {
-            getMockServerData()->loadEvent(normalizedKey, ""/* empty inState, which will be omitted in server data register */, ""/*outState (same as before)*/, receptionTimestampUs, statusCode, req.header(), headers, requestBodyDataPart, responseBody, receptionId, responseDelayMs, true /* history enabled ALWAYS FOR UNKNOWN EVENTS */);
+            h2agent::model::DataKey normalizedKey(method, normalizedUri);
+            auto event = getMockServerData()->loadEvent(normalizedKey, ""/* empty inState, which will be omitted in server data register */, ""/*outState (same as before)*/, receptionTimestampUs, statusCode, req.header(), headers, requestBodyDataPart, responseBody, receptionId, responseDelayMs, true /* history enabled ALWAYS FOR UNKNOWN EVENTS */);
 
             // Register for sendingTimestampUs capture in streamClose:
-            {
-                std::lock_guard<std::mutex> guard(pending_events_mutex_);
-                pending_events_[receptionId] = getMockServerData()->getLastLoadedEvent();
-            }
+            addPendingEvent(receptionId, std::move(event));
         }
         // metrics
         if(metrics_) {
@@ -424,19 +549,23 @@ ss << "TRAFFIC REQUEST RECEIVED"
     );
 }
 
+void MyTrafficHttp2Server::addPendingEvent(const std::uint64_t &receptionId, std::shared_ptr<model::MockServerEvent> event) {
+
+    if (pending_events_.add(receptionId, std::move(event))) {
+        LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("Pending events table overflow (capacity %zu): older event will miss its sending timestamp", pending_events_.capacity()), ERT_FILE_LOCATION));
+        if (metrics_) dropped_sending_timestamps_counter_->Increment();
+    }
+}
+
 void MyTrafficHttp2Server::streamClose(const std::uint64_t &receptionId) {
 
-    if (server_data_ && mock_server_events_data_) {
+    // Dynamic response delay (if any) is not needed anymore:
+    if (vault_ptr_) vault_ptr_->releaseResponseDelay(receptionId);
+
+    // Pending events are released even if storage was disabled meanwhile (they would hold the slot until overwritten):
+    if (!pending_events_.empty()) {
         std::shared_ptr<model::MockServerEvent> event;
-        {
-            std::lock_guard<std::mutex> guard(pending_events_mutex_);
-            auto it = pending_events_.find(receptionId);
-            if (it != pending_events_.end()) {
-                event = it->second;
-                pending_events_.erase(it);
-            }
-        }
-        if (event) {
+        if (pending_events_.take(receptionId, event) && event) {
             auto sendingTimestampUs = std::chrono::duration_cast<std::chrono::microseconds>(
                 std::chrono::system_clock::now().time_since_epoch());
             event->setSendingTimestampUs(sendingTimestampUs);
@@ -470,35 +599,18 @@ void MyTrafficHttp2Server::streamError(uint32_t errorCode, const std::string &se
 
 std::chrono::milliseconds MyTrafficHttp2Server::responseDelayMs(const std::uint64_t &receptionId) {
 
-    bool exists{};
-    long long ms_count{};
-
-    if (vault_ptr_) {
-        static const std::string varPrefix = "__core:response-delay-ms:";
-        std::string var = varPrefix + std::to_string(receptionId);
-        nlohmann::json val = vault_ptr_->get(var, exists);
-        if (exists) {
-            std::string valStr = h2agent::model::jsonToString(val);
-            try {
-                ms_count = std::stoll(valStr);
-                LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("Variable processed successfully (%s = %s)", var.c_str(), valStr.c_str()), ERT_FILE_LOCATION));
-            } catch (const std::invalid_argument& e) {
-                LOGWARNING(ert::tracing::Logger::warning(ert::tracing::Logger::asString("Variable value is not a number (%s = %s)", var.c_str(), valStr.c_str()), ERT_FILE_LOCATION));
-                return std::chrono::milliseconds::zero();
-            } catch (const std::out_of_range& e) {
-                LOGWARNING(ert::tracing::Logger::warning(ert::tracing::Logger::asString("Variable value invalid range (%s = %s)", var.c_str(), valStr.c_str()), ERT_FILE_LOCATION));
-                return std::chrono::milliseconds::zero();
-            }
-        }
-        else {
-            LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("No additional dynamic response delay found (%s = <missing>)", var.c_str()), ERT_FILE_LOCATION));
-        }
-    }
-    else {
+    if (!vault_ptr_) {
         // This must not happen, that's hardcoded on main.cpp:
         ert::tracing::Logger::critical("You may need to set vault entry map to server instance: myTrafficHttp2Server->setVault(myVault);", ERT_FILE_LOCATION);
+        return std::chrono::milliseconds::zero();
     }
 
+    // Reserved '__core:response-delay-ms:<recvseq>' vault entries are kept in a per-reception table (already parsed):
+    std::int64_t ms_count = vault_ptr_->getResponseDelayMs(receptionId);
+    LOGDEBUG(
+    if (ms_count != 0) ert::tracing::Logger::debug(ert::tracing::Logger::asString("Dynamic response delay for reception %llu: %lld ms", receptionId, (long long)ms_count), ERT_FILE_LOCATION);
+    );
+
     return std::chrono::milliseconds(ms_count);
 }
 
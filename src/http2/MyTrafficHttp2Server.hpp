@@ -38,16 +38,18 @@ SOFTWARE.
 #include <vector>
 #include <string>
 #include <memory>
+#include <unordered_map>
 #include <cstdint>
 #include <atomic>
 #include <functional>
 #include <chrono>
-#include <unordered_map>
-#include <mutex>
 
 #include <boost/asio.hpp>
 
 #include <JsonSchema.hpp>
+#include <PendingTable.hpp>
+#include <AdminServerMatchingData.hpp>
+#include <common.hpp>
 
 #include <ert/metrics/Metrics.hpp>
 
@@ -65,6 +67,7 @@ class Vault;
 //class FileManager;
 //class SocketManager;
 class AdminData;
+class AdminServerProvision;
 }
 
 namespace http2
@@ -87,6 +90,9 @@ class MyTrafficHttp2Server: public ert::http2comm::Http2Server
     ert::metrics::counter_t *provisioned_requests_failed_counter_{};
     ert::metrics::counter_t *purged_contexts_successful_counter_{};
     ert::metrics::counter_t *purged_contexts_failed_counter_{};
+    ert::metrics::counter_t *dropped_sending_timestamps_counter_{};
+    ert::metrics::counter_t *regex_replace_cache_hits_counter_{};
+    ert::metrics::counter_t *regex_replace_cache_misses_counter_{};
 
     std::atomic<int> max_busy_threads_{0};
     std::atomic<bool> receive_request_body_{true};
@@ -96,9 +102,28 @@ class MyTrafficHttp2Server: public ert::http2comm::Http2Server
 
     std::function<void(const std::string& /*clientProvisionId*/, const std::string& /*inState*/)> client_provision_trigger_{};
 
-    // Map receptionId -> event for O(1) sendingTimestampUs capture in streamClose:
-    std::unordered_map<std::uint64_t, std::shared_ptr<model::MockServerEvent>> pending_events_{};
-    std::mutex pending_events_mutex_{};
+    // Ring receptionId -> event for sendingTimestampUs capture in streamClose (no global lock, no allocation).
+    // Capacity bounds the streams in flight: beyond it, oldest pending events miss their sending timestamp.
+    static constexpr std::size_t PendingEventsCapacity = 65536;
+    model::PendingTable<std::shared_ptr<model::MockServerEvent>, PendingEventsCapacity> pending_events_{};
+
+    void addPendingEvent(const std::uint64_t &receptionId, std::shared_ptr<model::MockServerEvent> event);
+
+    // Request body reception policy: method and complete URI -> body needed. Cached analysis
+    // is valid for a provisions generation and matching configuration snapshot (data/len may
+    // arrive in several chunks for the same stream, so the classification must be cheap).
+    static constexpr std::size_t RequestBodyPolicyCacheCapacity = 4096;
+    mutable model::mutex_t request_body_policy_mutex_{};
+    std::unordered_map<std::string, bool> request_body_policy_{};
+    std::uint64_t request_body_policy_generation_{};
+    std::shared_ptr<const model::AdminServerMatchingData::Config> request_body_policy_matching_config_{};
+
+    bool classifyRequestBody(const std::string &method, const std::string &uriPath, const std::string &uriQuery, const model::AdminServerMatchingData::Config &matchingConfig) const;
+
+    // Provision search for the configured matching algorithm (falls back to default provision, with empty URI).
+    // Classification URI is updated for 'FullMatchingRegexReplace' algorithm (cache lookups are observed
+    // only for the reception classification, so every request is counted once).
+    std::shared_ptr<model::AdminServerProvision> findProvision(const model::AdminServerMatchingData::Config &matchingConfig, const std::string &inState, const std::string &method, std::string &classificationUri, bool observeCache = true) const;
 
 public:
     MyTrafficHttp2Server(const std::string &name, size_t workerThreads, size_t maxWorkerThreads, boost::asio::io_context *timersIoContext, int maxQueueDispatcherSize);
@@ -140,6 +165,11 @@ public:
     void streamClose(const std::uint64_t &receptionId);
     std::chrono::milliseconds responseDelayMs(const std::uint64_t &receptionId);
 
+    // Events whose sending timestamp was not captured due to pending table overflow
+    std::uint64_t droppedSendingTimestamps() const {
+        return pending_events_.dropped();
+    }
+
     void setAdminData(model::AdminData *p) {
         admin_data_ = p;
     }
@@ -166,6 +196,7 @@ public:
 
     void discardData(bool discard = true) {
         server_data_ = !discard;
+        if (discard) pending_events_.clear(); // in-flight events just miss their sending timestamp (not dropped by overflow)
     }
 
     bool isDataStored() const {
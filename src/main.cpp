@@ -57,6 +57,7 @@ SOFTWARE.
 #include <MockClientData.hpp>
 #include <WaitManager.hpp>
 #include <SseManager.hpp>
+#include <Random.hpp>
 #include <nlohmann/json.hpp>
 
 #include <ert/tracing/Logger.hpp>
@@ -69,8 +70,8 @@ SOFTWARE.
 #define ADMIN_NGHTTP2_SERVER_THREADS 1
 
 // In order to use queue dispatcher, we must set over 1, but performance is usually better without it:
-// Admin worker threads: enough to saturate MAX_WAITERS and still serve normal admin requests
-// (see WaitManager.hpp:66 — static constexpr size_t MAX_WAITERS = 32):
+// Admin worker threads: enough for 32 concurrent blocking waits (vault/<key>/wait) and still serve
+// normal admin requests (asynchronous waits, vault/wait?key=<key>, don't hold worker threads):
 #define ADMIN_SERVER_WORKER_THREADS_DEFAULT 33
 
 
@@ -309,8 +310,9 @@ void usage(int rc, const std::string &errorMessage = "")
 
        << "[--admin-server-worker-threads <threads>]\n"
        << "  Number of admin server worker threads; defaults to "
-       << ADMIN_SERVER_WORKER_THREADS_DEFAULT << " (max waiters + 1).\n"
-       << "  Higher values allow more concurrent blocking wait requests.\n\n"
+       << ADMIN_SERVER_WORKER_THREADS_DEFAULT << " (32 blocking waiters + 1).\n"
+       << "  Higher values allow more concurrent blocking wait requests (asynchronous\n"
+       << "  waits on 'vault/wait?key=<key>' don't hold worker threads).\n\n"
 
        << "[--traffic-server-max-worker-threads <threads>]\n"
        << "  Maximum number of worker threads; defaults to '--traffic-server-worker-threads'.\n"
@@ -374,7 +376,9 @@ void usage(int rc, const std::string &errorMessage = "")
 
        << "[--traffic-server-ignore-request-body]\n"
        << "  Ignores traffic server request body reception processing as optimization in\n"
-       << "  case that its content is not required by planned provisions (enabled by default).\n\n"
+       << "  case that its content is not required by planned provisions (enabled by default).\n"
+       << "  Anyway, when server events storage is discarded, the request body is only received\n"
+       << "  for those provisions which need it (request schema or request body sources).\n\n"
 
        << "[--traffic-server-dynamic-request-body-allocation]\n"
        << "  When data chunks are received, the server appends them into the final request body.\n"
@@ -385,8 +389,8 @@ void usage(int rc, const std::string &errorMessage = "")
 
        << "[--discard-data]\n"
        << "  Disables data storage for events processed (enabled by default).\n"
-       << "  This invalidates some features like FSM related ones (in-state, out-state)\n"
-       << "  or event-source transformations.\n"
+       << "  This invalidates some features like event-source transformations\n"
+       << "  (FSM states, in-state/out-state, are kept apart from events storage).\n"
        << "  This affects to both mock server-data and client-data storages,\n"
        << "  but normally both containers will not be used together in the same process instance.\n\n"
 
@@ -406,6 +410,11 @@ void usage(int rc, const std::string &errorMessage = "")
        << "  This affects to both mock server-data and client-data purge procedures,\n"
        << "  but normally both flows will not be used together in the same process instance.\n\n"
 
+       << "[--random-seed <value>]\n"
+       << "  Base seed for the per-thread random generators used by 'random' and 'randomset' sources.\n"
+       << "  A non-zero value makes sequences reproducible between runs with the same threads layout;\n"
+       << "  defaults to 0 (time-based seed).\n\n"
+
        << "[--prometheus-port <port>]\n"
        << "  Prometheus local <port>; defaults to 8080.\n\n"
 
@@ -437,6 +446,18 @@ void usage(int rc, const std::string &errorMessage = "")
        << "  limit allowed. By default, it is configured to " << myConfiguration->getShortTermFilesCloseDelayUsecs() << " usecs.\n"
        << "  Zero value means that close operation is done just after writting the file.\n\n"
 
+       << "[--files-flush-interval-usecs <microseconds>]\n"
+       << "  Enables the background writer for target files, which groups the pending writes\n"
+       << "  of each file into a single write operation. This interval is the time the writer\n"
+       << "  waits, once woken, to collect more writes (higher values mean bigger groups but\n"
+       << "  later visibility). Zero value writes as soon as possible. By default, the writer\n"
+       << "  is disabled and target files are written by the traffic threads.\n\n"
+
+       << "[--files-fsync]\n"
+       << "  Enables the background writer (with zero flush interval when it is not provided)\n"
+       << "  and flushes written data to the storage device after each group write (fdatasync).\n"
+       << "  Disabled by default.\n\n"
+
        << "[--remote-servers-lazy-connection]\n"
        << "  By default connections are performed when adding client endpoints.\n"
        << "  This option configures remote addresses to be connected on demand.\n\n"
@@ -599,8 +620,6 @@ bool readCmdLine(char** begin, char** end, const std::string& option, std::strin
 
 int main(int argc, char* argv[])
 {
-    srand(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
-
     progname = basename(argv[0]);
 
     // Traces
@@ -638,6 +657,7 @@ int main(int argc, char* argv[])
     bool discard_data = false;
     bool discard_data_key_history = false;
     bool disable_purge = false;
+    std::uint64_t random_seed = 0;
     bool verbose = false;
     std::string schema_file = "";
     std::string traffic_server_matching_file = "";
@@ -649,6 +669,9 @@ int main(int argc, char* argv[])
     std::string prometheus_response_delay_seconds_histogram_boundaries = "";
     std::string prometheus_message_size_bytes_histogram_boundaries = "";
     bool disable_metrics = false;
+    bool files_background_writer = false;
+    unsigned int files_flush_interval_usecs = 0;
+    bool files_fsync = false;
     ert::metrics::bucket_boundaries_t responseDelaySecondsHistogramBucketBoundaries{};
     ert::metrics::bucket_boundaries_t messageSizeBytesHistogramBucketBoundaries{};
 
@@ -855,6 +878,14 @@ int main(int argc, char* argv[])
         disable_purge = true;
     }
 
+    if (readCmdLine(argv, argv + argc, "--random-seed", value))
+    {
+        bool negative = false;
+        if (!h2agent::model::string2uint64andSign(value, random_seed, negative) || negative) {
+            usage(EXIT_FAILURE, "Invalid '--random-seed' value. Must be a non-negative integer.");
+        }
+    }
+
     if (readCmdLine(argv, argv + argc, "--prometheus-port", value))
     {
         prometheus_port = value;
@@ -896,6 +927,23 @@ int main(int argc, char* argv[])
         myConfiguration->setShortTermFilesCloseDelayUsecs(iValue);
     }
 
+    if (readCmdLine(argv, argv + argc, "--files-flush-interval-usecs", value))
+    {
+        int iValue = toNumber(value);
+        if (iValue < 0)
+        {
+            usage(EXIT_FAILURE, "Invalid '--files-flush-interval-usecs' value. Must be greater or equal than 0.");
+        }
+        files_flush_interval_usecs = iValue;
+        files_background_writer = true;
+    }
+
+    if (readCmdLine(argv, argv + argc, "--files-fsync"))
+    {
+        files_fsync = true;
+        files_background_writer = true;
+    }
+
     if (readCmdLine(argv, argv + argc, "--remote-servers-lazy-connection"))
     {
         myConfiguration->setLazyClientConnection(true);
@@ -1041,6 +1089,9 @@ ChatGPT:        https://github.com/testillano/h2agent/blob/master/README.md#ques
     std::cout << "Data storage: " << (!discard_data ? "enabled":"disabled") << '\n';
     std::cout << "Data key history storage: " << (!discard_data_key_history ? "enabled":"disabled") << '\n';
     std::cout << "Purge execution: " << (disable_purge ? "disabled":"enabled") << '\n';
+    std::cout << "Random seed: " << (random_seed ? std::to_string(random_seed) : "<time-based>") << '\n';
+
+    h2agent::model::setRandomSeed(random_seed);
 
     if (traffic_server_enabled) {
         std::cout << "Traffic server matching configuration file: " << ((traffic_server_matching_file != "") ? traffic_server_matching_file : "<not provided>") << '\n';
@@ -1064,6 +1115,11 @@ ChatGPT:        https://github.com/testillano/h2agent/blob/master/README.md#ques
     }
     std::cout << "Long-term files close delay (usecs): " << myConfiguration->getLongTermFilesCloseDelayUsecs() << '\n';
     std::cout << "Short-term files close delay (usecs): " << myConfiguration->getShortTermFilesCloseDelayUsecs() << '\n';
+    std::cout << "Files background writer: " << (files_background_writer ? "true":"false") << '\n';
+    if (files_background_writer) {
+        std::cout << "Files flush interval (usecs): " << files_flush_interval_usecs << '\n';
+        std::cout << "Files fsync: " << (files_fsync ? "true":"false") << '\n';
+    }
     std::cout << "Remote servers lazy connection: " << (myConfiguration->getLazyClientConnection() ? "true":"false") << '\n';
     std::cout << "Traffic client connections: " << myConfiguration->getTrafficClientConnections() << '\n';
     std::cout << "Traffic client worker threads: " << traffic_client_worker_threads_pool << (traffic_client_worker_threads_pool == 0 ? " (disabled)" : "") << '\n';
@@ -1087,6 +1143,7 @@ ChatGPT:        https://github.com/testillano/h2agent/blob/master/README.md#ques
 
     // FileManager/SafeFile metrics
     myFileManager->enableMetrics(myMetrics, application_name/*source label*/);
+    if (files_background_writer) myFileManager->enableBackgroundWriter(files_flush_interval_usecs, files_fsync);
 
     // SocketManager/SafeSocket metrics
     mySocketManager->enableMetrics(myMetrics, application_name/*source label*/);
@@ -1132,6 +1189,8 @@ ChatGPT:        https://github.com/testillano/h2agent/blob/master/README.md#ques
     // Mock data (may be not used):
     myMockServerData = new h2agent::model::MockServerData();
     myMockClientData = new h2agent::model::MockClientData();
+    myMockServerData->enableMetrics(myMetrics, application_name/*source label*/);
+    myMockClientData->enableMetrics(myMetrics, application_name/*source label*/);
 
     // Blocking wait (long-poll) manager:
     myWaitManager = new h2agent::model::WaitManager();
@@ -1140,6 +1199,8 @@ ChatGPT:        https://github.com/testillano/h2agent/blob/master/README.md#ques
 
     // SSE (Server-Sent Events) manager for vault event streaming:
     mySseManager = new h2agent::model::SseManager();
+    mySseManager->enableMetrics(myMetrics, application_name/*source label*/);
+    mySseManager->start();
     myVault->setSseManager(mySseManager);
     myAdminHttp2Server->setSseManager(mySseManager);
 
@@ -44,7 +44,6 @@ SOFTWARE.
 //#include <fcntl.h> // non-blocking fgets call
 
 #include <nlohmann/json.hpp>
-#include <arashpartow/exprtk.hpp>
 
 #include <ert/tracing/Logger.hpp>
 #include <ert/http2comm/Http.hpp>
@@ -57,13 +56,11 @@ SOFTWARE.
 #include <FileManager.hpp>
 #include <SocketManager.hpp>
 #include <AdminData.hpp>
+#include <Random.hpp>
 
 #include <functions.hpp>
 
 
-typedef exprtk::expression<double>   expression_t;
-typedef exprtk::parser<double>       parser_t;
-
 namespace h2agent
 {
 namespace model
@@ -108,12 +105,18 @@ std::shared_ptr<h2agent::model::AdminSchema> AdminClientProvision::getResponseSc
 }
 
 void AdminClientProvision::saveDynamics() const {
+    static const char *arrivals[] = { "uniform", "poisson", "burst" };
+
     std::lock_guard<std::mutex> guard(json_mutex_);
     json_["dynamics"]["sequence"] = seq_.load();
     json_["dynamics"]["sequenceBegin"] = seq_begin_.load();
     json_["dynamics"]["sequenceEnd"] = seq_end_.load();
     json_["dynamics"]["cps"] = cps_.load();
     json_["dynamics"]["repeat"] = repeat_.load();
+    json_["dynamics"]["arrival"] = arrivals[static_cast<int>(arrival_.load())];
+    json_["dynamics"]["achievedCps"] = achieved_cps_.load();
+    json_["dynamics"]["schedulingLagUs"] = scheduling_lag_us_.load();
+    json_["dynamics"]["droppedSequences"] = dropped_sequences_.load();
 }
 
 void AdminClientProvision::executeOnFilterFail(
@@ -162,20 +165,8 @@ void AdminClientProvision::transform( std::string &requestMethod,
     requestDelayMs = getRequestDelayMilliseconds();
     requestTimeoutMs = getRequestTimeoutMilliseconds();
 
-    // Find out if request body will need to be cloned (this is true if any transformation uses it as target):
-    bool usesRequestBodyAsTransformationJsonTarget = false;
-    for (const auto &t : transformations_) {
-        if (t->getTargetType() == Transformation::TargetType::RequestBodyJson_String ||
-                t->getTargetType() == Transformation::TargetType::RequestBodyJson_Integer ||
-                t->getTargetType() == Transformation::TargetType::RequestBodyJson_Unsigned ||
-                t->getTargetType() == Transformation::TargetType::RequestBodyJson_Float ||
-                t->getTargetType() == Transformation::TargetType::RequestBodyJson_Boolean ||
-                t->getTargetType() == Transformation::TargetType::RequestBodyJson_Object ||
-                t->getTargetType() == Transformation::TargetType::RequestBodyJson_JsonString) {
-            usesRequestBodyAsTransformationJsonTarget = true;
-            break;
-        }
-    }
+    // Request body will need to be cloned if any transformation uses it as target:
+    bool usesRequestBodyAsTransformationJsonTarget = has_request_body_json_target_;
 
     nlohmann::json requestBodyJson;
     if (usesRequestBodyAsTransformationJsonTarget) {
@@ -367,10 +358,15 @@ bool AdminClientProvision::processSources(std::shared_ptr<Transformation> transf
     }
     case Transformation::SourceType::RequestBody:
     {
-        std::string path = transformation->getSource();
-        replaceVariables(path, transformation->getSourcePatterns(), variables, vault_);
         if (usesRequestBodyAsTransformationJsonTarget) {
-            if (!sourceVault.setObject(requestBodyJson, path)) return false;
+            if (const nlohmann::json::json_pointer *pointer = transformation->getSourcePointer()) {
+                if (!sourceVault.setObject(requestBodyJson, *pointer)) return false;
+            }
+            else {
+                std::string path;
+                transformation->getSourceTemplate().render(path, variables, vault_);
+                if (!sourceVault.setObject(requestBodyJson, path)) return false;
+            }
         }
         else {
             sourceVault.setString(getRequestBodyAsString());
@@ -380,14 +376,17 @@ bool AdminClientProvision::processSources(std::shared_ptr<Transformation> transf
     case Transformation::SourceType::ResponseBody:
     {
         if (!receivedResponse) return false;
-        std::string path = transformation->getSource();
-        replaceVariables(path, transformation->getSourcePatterns(), variables, vault_);
         nlohmann::json responseJson;
         if (!h2agent::model::parseJsonContent(receivedResponse->body, responseJson)) {
             sourceVault.setString(receivedResponse->body);
         }
-        else if (!sourceVault.setObject(responseJson, path)) {
-            return false;
+        else if (const nlohmann::json::json_pointer *pointer = transformation->getSourcePointer()) {
+            if (!sourceVault.setObject(responseJson, *pointer)) return false;
+        }
+        else {
+            std::string path;
+            transformation->getSourceTemplate().render(path, variables, vault_);
+            if (!sourceVault.setObject(responseJson, path)) return false;
         }
         break;
     }
@@ -435,33 +434,31 @@ bool AdminClientProvision::processSources(std::shared_ptr<Transformation> transf
     }
     case Transformation::SourceType::Math:
     {
-        std::string expressionString = transformation->getSource();
-        replaceVariables(expressionString, transformation->getSourcePatterns(), variables, vault_);
-        expression_t expression;
-        parser_t parser;
-        parser.compile(expressionString, expression);
-        double result = expression.value();
-        if (result == (int)result) sourceVault.setInteger(expression.value());
-        else sourceVault.setFloat(expression.value());
+        // Compiled once at transformation load (textual replacement and compilation only for non-numeric substitutions):
+        double result = transformation->getMathExpression()->evaluate(variables, vault_); // if the result has decimals, set as float. If not, set as integer:
+        if (result == (int)result) sourceVault.setInteger(result);
+        else sourceVault.setFloat(result);
         break;
     }
     case Transformation::SourceType::Random:
     {
-        int range = transformation->getSourceI2() - transformation->getSourceI1() + 1;
-        sourceVault.setInteger(transformation->getSourceI1() + (rand() % range));
+        sourceVault.setInteger(randomInRange(transformation->getSourceI1(), transformation->getSourceI2()));
         break;
     }
     case Transformation::SourceType::RandomSet:
     {
-        sourceVault.setStringReplacingVariables(transformation->getSourceTokenized()[rand () % transformation->getSourceTokenized().size()], transformation->getSourcePatterns(), variables, vault_);
+        sourceVault.setStringReplacingVariables(transformation->getSourceTokenized()[randomIndex(transformation->getSourceTokenized().size())], transformation->getSourcePatterns(), variables, vault_);
         break;
     }
     case Transformation::SourceType::Timestamp:
     {
-        if (transformation->getSource() == "s") sourceVault.setInteger(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
-        else if (transformation->getSource() == "ms") sourceVault.setInteger(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
-        else if (transformation->getSource() == "us") sourceVault.setInteger(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
-        else if (transformation->getSource() == "ns") sourceVault.setInteger(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+        auto now = std::chrono::system_clock::now().time_since_epoch();
+        switch (transformation->getSourceTimestampUnit()) { // resolved at load: 0: s, 1: ms, 2: us, 3: ns
+        case 0: sourceVault.setInteger(std::chrono::duration_cast<std::chrono::seconds>(now).count()); break;
+        case 1: sourceVault.setInteger(std::chrono::duration_cast<std::chrono::milliseconds>(now).count()); break;
+        case 2: sourceVault.setInteger(std::chrono::duration_cast<std::chrono::microseconds>(now).count()); break;
+        default: sourceVault.setInteger(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+        }
         break;
     }
     case Transformation::SourceType::Strftime:
@@ -480,8 +477,8 @@ bool AdminClientProvision::processSources(std::shared_ptr<Transformation> transf
     }
     case Transformation::SourceType::SVar:
     {
-        std::string varname = transformation->getSource();
-        replaceVariables(varname, transformation->getSourcePatterns(), variables, vault_);
+        std::string varname;
+        transformation->getSourceTemplate().render(varname, variables, vault_);
         auto iter = variables.find(varname);
         if (iter != variables.end()) sourceVault.setString(iter->second);
         else return false;
@@ -489,20 +486,20 @@ bool AdminClientProvision::processSources(std::shared_ptr<Transformation> transf
     }
     case Transformation::SourceType::SGVar:
     {
-        std::string varname = transformation->getSource();
-        replaceVariables(varname, transformation->getSourcePatterns(), variables, vault_);
-        nlohmann::json vaultValue{};
+        std::string varname;
+        transformation->getSourceTemplate().render(varname, variables, vault_);
+        std::shared_ptr<const nlohmann::json> vaultValue{}; // shared, not copied
         if (vault_->tryGet(varname, vaultValue)) {
             std::string path = transformation->getSource2();
             if (!path.empty()) replaceVariables(path, transformation->getSourcePatterns(), variables, vault_);
-            if (!sourceVault.setObject(vaultValue, path)) return false;
+            if (!sourceVault.setObject(std::move(vaultValue), path)) return false;
         }
         else return false;
         break;
     }
     case Transformation::SourceType::Value:
     {
-        sourceVault.setStringReplacingVariables(transformation->getSource(), transformation->getSourcePatterns(), variables, vault_);
+        sourceVault.setStringReplacingVariables(transformation->getSourceTemplate(), variables, vault_);
         break;
     }
     case Transformation::SourceType::ServerEvent:
@@ -578,8 +575,8 @@ bool AdminClientProvision::processSources(std::shared_ptr<Transformation> transf
     }
     case Transformation::SourceType::STxtFile:
     {
-        std::string path = transformation->getSource();
-        replaceVariables(path, transformation->getSourcePatterns(), variables, vault_);
+        std::string path;
+        transformation->getSourceTemplate().render(path, variables, vault_);
         std::string content;
         file_manager_->read(path, content, true);
         sourceVault.setString(std::move(content));
@@ -587,8 +584,8 @@ bool AdminClientProvision::processSources(std::shared_ptr<Transformation> transf
     }
     case Transformation::SourceType::SBinFile:
     {
-        std::string path = transformation->getSource();
-        replaceVariables(path, transformation->getSourcePatterns(), variables, vault_);
+        std::string path;
+        transformation->getSourceTemplate().render(path, variables, vault_);
         std::string content;
         file_manager_->read(path, content, false);
         sourceVault.setString(std::move(content));
@@ -596,8 +593,8 @@ bool AdminClientProvision::processSources(std::shared_ptr<Transformation> transf
     }
     case Transformation::SourceType::Command:
     {
-        std::string command = transformation->getSource();
-        replaceVariables(command, transformation->getSourcePatterns(), variables, vault_);
+        std::string command;
+        transformation->getSourceTemplate().render(command, variables, vault_);
         static char buffer[256];
         std::string output{};
         FILE *fp = popen(command.c_str(), "r");
@@ -654,16 +651,16 @@ bool AdminClientProvision::processFilters(std::shared_ptr<Transformation> transf
     }
     case Transformation::FilterType::Append:
     {
-        std::string filter = transformation->getFilter();
-        replaceVariables(filter, transformation->getFilterPatterns(), variables, vault_);
+        std::string filter;
+        transformation->getFilterTemplate().render(filter, variables, vault_);
         targetS = source + filter;
         sourceVault.setString(targetS);
         break;
     }
     case Transformation::FilterType::Prepend:
     {
-        std::string filter = transformation->getFilter();
-        replaceVariables(filter, transformation->getFilterPatterns(), variables, vault_);
+        std::string filter;
+        transformation->getFilterTemplate().render(filter, variables, vault_);
         targetS = filter + source;
         sourceVault.setString(targetS);
         break;
@@ -699,15 +696,15 @@ bool AdminClientProvision::processFilters(std::shared_ptr<Transformation> transf
     }
     case Transformation::FilterType::EqualTo:
     {
-        std::string filter = transformation->getFilter();
-        replaceVariables(filter, transformation->getFilterPatterns(), variables, vault_);
+        std::string filter;
+        transformation->getFilterTemplate().render(filter, variables, vault_);
         if (source != filter) return false;
         break;
     }
     case Transformation::FilterType::DifferentFrom:
     {
-        std::string filter = transformation->getFilter();
-        replaceVariables(filter, transformation->getFilterPatterns(), variables, vault_);
+        std::string filter;
+        transformation->getFilterTemplate().render(filter, variables, vault_);
         if (source == filter) return false;
         break;
     }
@@ -904,9 +901,10 @@ bool AdminClientProvision::processTargets(std::shared_ptr<Transformation> transf
     double targetF = 0;
     bool boolean = false;
     nlohmann::json obj;
+    nlohmann::json::json_pointer builtPointer; // only used for target paths with variables
 
-    std::string target = transformation->getTarget();
-    replaceVariables(target, transformation->getTargetPatterns(), variables, vault_);
+    std::string target;
+    transformation->getTargetTemplate().render(target, variables, vault_);
 
     try {
         switch (transformation->getTargetType()) {
@@ -928,7 +926,7 @@ bool AdminClientProvision::processTargets(std::shared_ptr<Transformation> transf
         {
             targetS = sourceVault.getString(success);
             if (!success) return false;
-            nlohmann::json::json_pointer j_ptr(target);
+            const nlohmann::json::json_pointer &j_ptr = transformation->getTargetPointer(target, builtPointer);
             requestBodyJson[j_ptr] = targetS;
             break;
         }
@@ -936,7 +934,7 @@ bool AdminClientProvision::processTargets(std::shared_ptr<Transformation> transf
         {
             targetI = sourceVault.getInteger(success);
             if (!success) return false;
-            nlohmann::json::json_pointer j_ptr(target);
+            const nlohmann::json::json_pointer &j_ptr = transformation->getTargetPointer(target, builtPointer);
             requestBodyJson[j_ptr] = targetI;
             break;
         }
@@ -944,7 +942,7 @@ bool AdminClientProvision::processTargets(std::shared_ptr<Transformation> transf
         {
             targetU = sourceVault.getUnsigned(success);
             if (!success) return false;
-            nlohmann::json::json_pointer j_ptr(target);
+            const nlohmann::json::json_pointer &j_ptr = transformation->getTargetPointer(target, builtPointer);
             requestBodyJson[j_ptr] = targetU;
             break;
         }
@@ -952,7 +950,7 @@ bool AdminClientProvision::processTargets(std::shared_ptr<Transformation> transf
         {
             targetF = sourceVault.getFloat(success);
             if (!success) return false;
-            nlohmann::json::json_pointer j_ptr(target);
+            const nlohmann::json::json_pointer &j_ptr = transformation->getTargetPointer(target, builtPointer);
             requestBodyJson[j_ptr] = targetF;
             break;
         }
@@ -960,7 +958,7 @@ bool AdminClientProvision::processTargets(std::shared_ptr<Transformation> transf
         {
             boolean = sourceVault.getBoolean(success);
             if (!success) return false;
-            nlohmann::json::json_pointer j_ptr(target);
+            const nlohmann::json::json_pointer &j_ptr = transformation->getTargetPointer(target, builtPointer);
             requestBodyJson[j_ptr] = boolean;
             break;
         }
@@ -975,7 +973,7 @@ bool AdminClientProvision::processTargets(std::shared_ptr<Transformation> transf
                 requestBodyJson[j_ptr].erase(childKey);
                 return false;
             }
-            nlohmann::json::json_pointer j_ptr(target);
+            const nlohmann::json::json_pointer &j_ptr = transformation->getTargetPointer(target, builtPointer);
             switch (sourceVault.getNativeType()) {
             case TypeConverter::NativeType::Object: obj = sourceVault.getObject(success); if (success) { if (target.empty()) requestBodyJson.merge_patch(obj); else requestBodyJson[j_ptr] = obj; } break;
             case TypeConverter::NativeType::String: targetS = sourceVault.getString(success); if (success) requestBodyJson[j_ptr] = targetS; break;
@@ -988,7 +986,7 @@ bool AdminClientProvision::processTargets(std::shared_ptr<Transformation> transf
         }
         case Transformation::TargetType::RequestBodyJson_JsonString:
         {
-            nlohmann::json::json_pointer j_ptr(target);
+            const nlohmann::json::json_pointer &j_ptr = transformation->getTargetPointer(target, builtPointer);
             targetS = sourceVault.getString(success);
             if (!success) return false;
             if (!h2agent::model::parseJsonContent(targetS, obj)) return false;
@@ -1066,8 +1064,8 @@ bool AdminClientProvision::processTargets(std::shared_ptr<Transformation> transf
         }
         case Transformation::TargetType::TGVar:
         {
-            std::string gvarPath = transformation->getTarget2();
-            if (!gvarPath.empty()) replaceVariables(gvarPath, transformation->getTarget2Patterns(), variables, vault_);
+            std::string gvarPath;
+            transformation->getTarget2Template().render(gvarPath, variables, vault_);
 
             if (eraser) {
                 bool exists;
@@ -1136,8 +1134,8 @@ bool AdminClientProvision::processTargets(std::shared_ptr<Transformation> transf
         }
         case Transformation::TargetType::TGVarJson_Object:
         {
-            std::string gvarPath = transformation->getTarget2();
-            if (!gvarPath.empty()) replaceVariables(gvarPath, transformation->getTarget2Patterns(), variables, vault_);
+            std::string gvarPath;
+            transformation->getTarget2Template().render(gvarPath, variables, vault_);
 
             bool objSuccess = false;
             const nlohmann::json &obj = sourceVault.getObject(objSuccess);
@@ -1152,8 +1150,8 @@ bool AdminClientProvision::processTargets(std::shared_ptr<Transformation> transf
         }
         case Transformation::TargetType::TGVarJson_JsonString:
         {
-            std::string gvarPath = transformation->getTarget2();
-            if (!gvarPath.empty()) replaceVariables(gvarPath, transformation->getTarget2Patterns(), variables, vault_);
+            std::string gvarPath;
+            transformation->getTarget2Template().render(gvarPath, variables, vault_);
 
             targetS = sourceVault.getString(success);
             if (!success) return false;
@@ -1276,7 +1274,7 @@ bool AdminClientProvision::processTargets(std::shared_ptr<Transformation> transf
     return true;
 }
 
-bool AdminClientProvision::updateTriggering(const std::string &sequenceBegin, const std::string &sequenceEnd, const std::string &cps, const std::string &repeat) {
+bool AdminClientProvision::updateTriggering(const std::string &sequenceBegin, const std::string &sequenceEnd, const std::string &cps, const std::string &repeat, const std::string &arrival) {
 
     // Range reads:
     std::int64_t i_sequenceBegin = seq_begin_;
@@ -1337,6 +1335,17 @@ bool AdminClientProvision::updateTriggering(const std::string &sequenceBegin, co
         repeat_ = (repeat == "true");
     }
 
+    // Arrival:
+    if (!arrival.empty()) {
+        if (arrival == "uniform") arrival_ = Arrival::Uniform;
+        else if (arrival == "poisson") arrival_ = Arrival::Poisson;
+        else if (arrival == "burst") arrival_ = Arrival::Burst;
+        else {
+            LOGWARNING(ert::tracing::Logger::warning(ert::tracing::Logger::asString("Invalid 'arrival' value: %s (allowed: uniform|poisson|burst)", arrival.c_str()), ERT_FILE_LOCATION));
+            return false;
+        }
+    }
+
     // Save dynamics into provision json:
     saveDynamics();
 
@@ -1352,6 +1361,11 @@ void AdminClientProvision::startTicking(boost::asio::io_context *ioContext, std:
     }
     saveDynamics();
     last_dynamics_save_ = std::chrono::steady_clock::now();
+    last_tick_ = last_dynamics_save_;
+    next_arrival_ = last_dynamics_save_;
+    scheduled_arrival_ = arrival_.load();
+    credit_ = 0;
+    window_dispatched_ = 0;
     timer_ = new boost::asio::steady_timer(*io_context_);
     scheduleTick();
 }
@@ -1374,6 +1388,50 @@ void AdminClientProvision::stopTicking() {
     }
 }
 
+std::uint64_t AdminClientProvision::dueSequences(unsigned int cps, const std::chrono::steady_clock::time_point &now) {
+
+    std::uint64_t result{};
+    auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(now - last_tick_).count();
+    last_tick_ = now;
+
+    // Arrival profile updated while ticking: former profile state is meaningless
+    Arrival arrival = arrival_.load();
+    if (arrival != scheduled_arrival_) {
+        scheduled_arrival_ = arrival;
+        credit_ = 0;
+        next_arrival_ = now;
+    }
+
+    switch (arrival) {
+    case Arrival::Uniform:
+        credit_ += cps * (std::uint64_t)elapsedUs;
+        result = credit_ / 1000000;
+        credit_ %= 1000000;
+        break;
+    case Arrival::Poisson: {
+        // Exponential inter-arrival times:
+        std::exponential_distribution<double> interArrivalNs(cps / 1000000000.0);
+        while (next_arrival_ <= now && result <= cps) {
+            result++;
+            next_arrival_ += std::chrono::nanoseconds((std::int64_t)interArrivalNs(rng_));
+        }
+        break;
+    }
+    case Arrival::Burst:
+        result = cps; // one tick per second
+        break;
+    }
+
+    // Catch-up after a stall is limited to one second of traffic:
+    if (result > cps) {
+        result = cps;
+        credit_ = 0;
+        next_arrival_ = now;
+    }
+
+    return result;
+}
+
 void AdminClientProvision::scheduleTick(bool first) {
     auto currentCps = cps_.load();
     if (!timer_ || currentCps == 0) {
@@ -1381,36 +1439,63 @@ void AdminClientProvision::scheduleTick(bool first) {
         return;
     }
 
-    auto period = std::chrono::microseconds(1000000 / currentCps);
+    // Burst profile sends the whole rate every second; otherwise the coarse cadence is used
+    // unless one request period is longer:
+    std::int64_t periodUs = 1000000;
+    if (arrival_.load() == Arrival::Uniform) periodUs = std::max(TickPeriodUs, (std::int64_t)(1000000 / currentCps));
+    else if (arrival_.load() == Arrival::Poisson) periodUs = TickPeriodUs;
+
+    auto period = std::chrono::microseconds(periodUs);
     if (first)
         timer_->expires_after(period);               // first tick: relative to now
     else
         timer_->expires_at(timer_->expiry() + period); // subsequent: anchored, no drift
 
     timer_->async_wait([this](const boost::system::error_code &ec) {
-        if (ec) return; // cancelled
+        if (ec || !timer_) return; // cancelled
 
-        // Try to dispatch. If congested, don't advance seq (retry next tick).
-        scheduleTick(false); // schedule next BEFORE callback to avoid drift
-        if (tick_callback_ && !tick_callback_()) {
-            return; // congested: seq not advanced, will retry
-        }
+        auto now = std::chrono::steady_clock::now();
+        auto lag = now - timer_->expiry();
+        auto currentCps = cps_.load();
 
-        seq_++;
+        scheduleTick(false); // schedule next BEFORE dispatching to avoid drift
 
-        if (seq_.load() > seq_end_.load()) {
-            if (repeat_) {
-                seq_ = seq_begin_.load();
+        scheduling_lag_us_ = std::chrono::duration_cast<std::chrono::microseconds>(lag).count();
+        std::uint64_t due = dueSequences(currentCps, now);
+
+        for (std::uint64_t k = 0; k < due; k++) {
+            // Try to dispatch. If congested, don't advance seq (rest of the batch is lost).
+            if (!tick_callback_ || !tick_callback_()) {
+                dropped_sequences_ += (due - k);
+                if (dropped_sequences_counter_) dropped_sequences_counter_->Increment(due - k);
+                LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("Congestion: %" PRIu64 " sequences dropped for client provision '%s'", due - k, client_provision_id_.c_str()), ERT_FILE_LOCATION));
+                break;
             }
-            else {
-                saveDynamics(); // final update before stopping
-                stopTicking();
-                return;
+
+            seq_++;
+            window_dispatched_++;
+
+            if (seq_.load() > seq_end_.load()) {
+                if (repeat_) {
+                    seq_ = seq_begin_.load();
+                }
+                else {
+                    achieved_cps_ = 0;
+                    if (achieved_cps_gauge_) achieved_cps_gauge_->Set(0);
+                    saveDynamics(); // final update before stopping
+                    stopTicking();
+                    return;
+                }
             }
         }
 
-        auto now = std::chrono::steady_clock::now();
-        if (now - last_dynamics_save_ >= std::chrono::milliseconds(500)) {
+        auto windowUs = std::chrono::duration_cast<std::chrono::microseconds>(now - last_dynamics_save_).count();
+        if (windowUs >= 500000) {
+            achieved_cps_ = window_dispatched_ * 1000000.0 / windowUs;
+            window_dispatched_ = 0;
+            if (target_cps_gauge_) target_cps_gauge_->Set(currentCps);
+            if (achieved_cps_gauge_) achieved_cps_gauge_->Set(achieved_cps_.load());
+            if (scheduling_lag_gauge_) scheduling_lag_gauge_->Set(scheduling_lag_us_.load() / 1000000.0);
             saveDynamics();
             last_dynamics_save_ = now;
         }
@@ -1540,6 +1625,11 @@ bool AdminClientProvision::load(const nlohmann::json &j) {
         }
     }
 
+    // Precompute transformation dispatch decision:
+    for (const auto &t : transformations_) {
+        if (t->getTargetType() >= Transformation::TargetType::RequestBodyJson_String && t->getTargetType() <= Transformation::TargetType::RequestBodyJson_JsonString) has_request_body_json_target_ = true;
+    }
+
     transform_it = j.find("onResponseTransform");
     if (transform_it != j.end()) {
         LOGDEBUG(ert::tracing::Logger::debug("Load transformations ('onResponseTransform' node)", ERT_FILE_LOCATION));
@@ -41,6 +41,7 @@ SOFTWARE.
 #include <chrono>
 #include <atomic>
 #include <mutex>
+#include <random>
 
 #include <nlohmann/json.hpp>
 
@@ -48,6 +49,7 @@ SOFTWARE.
 #include <boost/asio/io_context.hpp>
 
 #include <ert/http2comm/Http2Client.hpp>
+#include <ert/metrics/Metrics.hpp>
 
 #include <AdminSchema.hpp>
 #include <Transformation.hpp>
@@ -116,6 +118,9 @@ class AdminClientProvision
     std::vector<std::shared_ptr<Transformation>> transformations_{};
     std::vector<std::shared_ptr<Transformation>> on_response_transformations_{};
 
+    // Transformation dispatch decision, resolved once at load():
+    bool has_request_body_json_target_{}; // provisioned request body must be cloned to be modified
+
     // Dynamic load parameters (accessed from timer thread + admin API thread):
     std::atomic<std::int64_t> seq_{};
     std::atomic<std::int64_t> seq_begin_{};
@@ -123,12 +128,41 @@ class AdminClientProvision
     std::atomic<unsigned int> cps_{};
     std::atomic<bool> repeat_{};
 
+public:
+    // Arrival profile for timer-based triggering:
+    enum class Arrival { Uniform, Poisson, Burst };
+
+private:
+    std::atomic<Arrival> arrival_{Arrival::Uniform};
+
     // Timer-based triggering:
+    // The timer fires at a coarse cadence (TickPeriodUs, or the request period when longer) and
+    // every tick dispatches the sequences due since the previous one, so high rates don't need
+    // a timer expiration per request.
+    static constexpr std::int64_t TickPeriodUs = 1000;
     boost::asio::steady_timer *timer_{};
     boost::asio::io_context *io_context_{};
     std::function<bool()> tick_callback_{}; // returns false if congested (seq not advanced)
     std::chrono::steady_clock::time_point last_dynamics_save_{};
     void scheduleTick(bool first = true);
+    std::uint64_t dueSequences(unsigned int cps, const std::chrono::steady_clock::time_point &now);
+
+    // Scheduler state (timer thread):
+    std::chrono::steady_clock::time_point last_tick_{};
+    std::uint64_t credit_{}; // uniform arrival: accumulated cps * elapsed microseconds
+    std::chrono::steady_clock::time_point next_arrival_{}; // poisson arrival
+    Arrival scheduled_arrival_{Arrival::Uniform}; // profile of the scheduler state (reset when changed)
+    std::mt19937_64 rng_{std::random_device{}()};
+    std::uint64_t window_dispatched_{};
+
+    // Scheduler statistics (timer thread writes, admin API thread reads):
+    std::atomic<double> achieved_cps_{};
+    std::atomic<std::int64_t> scheduling_lag_us_{};
+    std::atomic<std::uint64_t> dropped_sequences_{}; // due but not triggered (congestion)
+    ert::metrics::gauge_t *target_cps_gauge_{};
+    ert::metrics::gauge_t *achieved_cps_gauge_{};
+    ert::metrics::gauge_t *scheduling_lag_gauge_{};
+    ert::metrics::counter_t *dropped_sequences_counter_{};
 
     void saveDynamics() const;
 
@@ -248,10 +282,33 @@ public:
      * @param sequenceEnd Range final sequence
      * @param cps Rate for sequences triggering (in calls/provisions per second)
      * @param repeat Repeat range processing when exhausted
+     * @param arrival Arrival profile: 'uniform' (default), 'poisson' or 'burst' (whole second rate at once)
      *
      * @return Operation success
      */
-    bool updateTriggering(const std::string &sequenceBegin, const std::string &sequenceEnd, const std::string &cps, const std::string &repeat);
+    bool updateTriggering(const std::string &sequenceBegin, const std::string &sequenceEnd, const std::string &cps, const std::string &repeat, const std::string &arrival = "");
+
+    /**
+     * Sets gauges to export scheduler statistics (optional)
+     *
+     * @param targetCps Configured rate gauge
+     * @param achievedCps Measured rate gauge
+     * @param schedulingLag Timer expiration lag gauge (seconds)
+     */
+    void setSchedulerGauges(ert::metrics::gauge_t *targetCps, ert::metrics::gauge_t *achievedCps, ert::metrics::gauge_t *schedulingLag) {
+        target_cps_gauge_ = targetCps;
+        achieved_cps_gauge_ = achievedCps;
+        scheduling_lag_gauge_ = schedulingLag;
+    }
+
+    /**
+     * Sets counters to export scheduler statistics (optional)
+     *
+     * @param droppedSequences Sequences due but not triggered due to congestion
+     */
+    void setSchedulerCounters(ert::metrics::counter_t *droppedSequences) {
+        dropped_sequences_counter_ = droppedSequences;
+    }
 
     /**
      * Starts timer-based triggering at configured cps rate
@@ -496,6 +553,22 @@ public:
         return cps_;
     }
 
+    /** Configured arrival profile
+     *
+     * @return arrival profile
+     */
+    Arrival getArrival() const {
+        return arrival_;
+    }
+
+    /** Measured requests per second (last dynamics refresh period)
+     *
+     * @return achieved cps value
+     */
+    double getAchievedCps() const {
+        return achieved_cps_;
+    }
+
     /** Configured expected response status code
      *
      * @return expected status code (0 = not configured)
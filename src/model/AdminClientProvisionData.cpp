@@ -120,13 +120,10 @@ AdminClientProvisionData::LoadResult AdminClientProvisionData::load(const nlohma
 
 std::shared_ptr<AdminClientProvision> AdminClientProvisionData::find(const std::string &inState, const std::string &clientProvisionId) const {
 
-    admin_client_provision_key_t key{};
-    h2agent::model::calculateStringKey(key, inState, clientProvisionId);
+    std::shared_ptr<AdminClientProvision> result(nullptr);
+    tryGet(CompositeKeyView(inState, clientProvisionId), result);
 
-    bool exists{};
-    auto result = get(key, exists);
-
-    return (exists ? result:nullptr);
+    return result;
 }
 
 }
@@ -47,6 +47,20 @@ namespace h2agent
 namespace model
 {
 
+bool AdminServerMatchingData::Config::regexReplace(std::string &uri) const {
+
+    std::string replaced;
+    if (regex_replace_cache.get(uri, replaced)) {
+        uri = std::move(replaced);
+        return true;
+    }
+
+    replaced = std::regex_replace(uri, rgx, fmt);
+    regex_replace_cache.put(uri, replaced);
+    uri = std::move(replaced);
+    return false;
+}
+
 AdminServerMatchingData::AdminServerMatchingData() {
     auto cfg = std::make_shared<Config>();
     cfg->json["algorithm"] = "FullMatching";
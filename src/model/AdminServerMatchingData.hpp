@@ -38,11 +38,13 @@ SOFTWARE.
 #include <atomic>
 #include <memory>
 #include <regex>
+#include <string>
 
 #include <nlohmann/json.hpp>
 
 #include <JsonSchema.hpp>
 #include <AdminSchemas.hpp>
+#include <LruCache.hpp>
 
 
 namespace h2agent
@@ -66,6 +68,9 @@ public:
     // Load result
     enum LoadResult { Success = 0, BadSchema, BadContent };
 
+    // Distinct classification URIs memoized for 'FullMatchingRegexReplace' algorithm:
+    static constexpr std::size_t RegexReplaceCacheCapacity = 8192;
+
     // Immutable configuration snapshot (thread-safe by design)
     struct Config {
         AlgorithmType algorithm{FullMatching};
@@ -74,6 +79,18 @@ public:
         UriPathQueryParametersFilterType uri_path_query_parameters_filter{Sort};
         UriPathQueryParametersSeparatorType uri_path_query_parameters_separator{Ampersand};
         nlohmann::json json{};
+
+        // Classification URI -> replaced URI (owned by the snapshot, so it is dropped on reconfiguration):
+        mutable LruCache<std::string, std::string> regex_replace_cache{RegexReplaceCacheCapacity};
+
+        /**
+         * Applies 'rgx'/'fmt' replacement over the classification URI, memoizing the result
+         *
+         * @param uri Classification URI, replaced by reference
+         *
+         * @return True if the replacement was already cached (hit)
+         */
+        bool regexReplace(std::string &uri) const;
     };
 
     /**
@@ -40,10 +40,10 @@ SOFTWARE.
 #include <time.h>       /* time_t, struct tm, time, localtime, strftime */
 #include <string>
 #include <algorithm>
+#include <functional>
 //#include <fcntl.h> // non-blocking fgets call
 
 #include <nlohmann/json.hpp>
-#include <arashpartow/exprtk.hpp>
 
 #include <ert/tracing/Logger.hpp>
 #include <ert/http2comm/Http.hpp>
@@ -56,13 +56,11 @@ SOFTWARE.
 #include <FileManager.hpp>
 #include <SocketManager.hpp>
 #include <AdminData.hpp>
+#include <Random.hpp>
 
 #include <functions.hpp>
 
 
-typedef exprtk::expression<double>   expression_t;
-typedef exprtk::parser<double>       parser_t;
-
 namespace h2agent
 {
 namespace model
@@ -144,9 +142,16 @@ bool AdminServerProvision::processSources(std::shared_ptr<Transformation> transf
     case Transformation::SourceType::RequestBody:
     {
         if (requestBodyDataPart.isJson()) {
-            std::string path = transformation->getSource(); // document path (empty or not to be whole or node)
-            replaceVariables(path, transformation->getSourcePatterns(), variables, vault_);
-            if (!sourceVault.setObject(requestBodyDataPart.getJson(), path)) {
+            bool extracted = false;
+            if (const nlohmann::json::json_pointer *pointer = transformation->getSourcePointer()) {
+                extracted = sourceVault.setObject(requestBodyDataPart.getJson(), *pointer);
+            }
+            else {
+                std::string path; // document path (empty or not to be whole or node)
+                transformation->getSourceTemplate().render(path, variables, vault_);
+                extracted = sourceVault.setObject(requestBodyDataPart.getJson(), path);
+            }
+            if (!extracted) {
                 LOGDEBUG(
                     std::string msg = ert::tracing::Logger::asString("Unable to extract path '%s' from request body (it is null) in transformation item", transformation->getSource().c_str());
                     ert::tracing::Logger::debug(msg, ERT_FILE_LOCATION);
@@ -161,9 +166,17 @@ bool AdminServerProvision::processSources(std::shared_ptr<Transformation> transf
     }
     case Transformation::SourceType::ResponseBody:
     {
-        std::string path = transformation->getSource(); // document path (empty or not to be whole or node)
-        replaceVariables(path, transformation->getSourcePatterns(), variables, vault_);
-        if (!sourceVault.setObject(usesResponseBodyAsTransformationJsonTarget ? responseBodyJson:getResponseBody(), path)) {
+        const nlohmann::json &responseBody = usesResponseBodyAsTransformationJsonTarget ? responseBodyJson:getResponseBody();
+        bool extracted = false;
+        if (const nlohmann::json::json_pointer *pointer = transformation->getSourcePointer()) {
+            extracted = sourceVault.setObject(responseBody, *pointer);
+        }
+        else {
+            std::string path; // document path (empty or not to be whole or node)
+            transformation->getSourceTemplate().render(path, variables, vault_);
+            extracted = sourceVault.setObject(responseBody, path);
+        }
+        if (!extracted) {
             LOGDEBUG(
                 std::string msg = ert::tracing::Logger::asString("Unable to extract path '%s' from response body (it is null) in transformation item", transformation->getSource().c_str());
                 ert::tracing::Logger::debug(msg, ERT_FILE_LOCATION);
@@ -204,54 +217,37 @@ bool AdminServerProvision::processSources(std::shared_ptr<Transformation> transf
     }
     case Transformation::SourceType::Math:
     {
-        std::string expressionString = transformation->getSource();
-        replaceVariables(expressionString, transformation->getSourcePatterns(), variables, vault_);
-
-        /*
-           We don't use builtin variables as we can parse h2agent ones which is easier to implement:
-
-           typedef exprtk::symbol_table<double> symbol_table_t;
-           symbol_table_t symbol_table;
-           double x = 2.0;
-           symbol_table.add_variable("x",x);
-           expression.register_symbol_table(symbol_table);
-           parser.compile("3*x",expression);
-           std::cout << expression.value() << std::endl; // 3*2
-        */
-
-        expression_t   expression;
-        parser_t       parser;
-        parser.compile(expressionString, expression);
-
-        double result = expression.value(); // if the result has decimals, set as float. If not, set as integer:
-        if (result == (int)result) sourceVault.setInteger(expression.value());
-        else sourceVault.setFloat(expression.value());
+        // Compiled once at transformation load (textual replacement and compilation only for non-numeric substitutions):
+        double result = transformation->getMathExpression()->evaluate(variables, vault_); // if the result has decimals, set as float. If not, set as integer:
+        if (result == (int)result) sourceVault.setInteger(result);
+        else sourceVault.setFloat(result);
         break;
     }
     case Transformation::SourceType::Random:
     {
-        int range = transformation->getSourceI2() - transformation->getSourceI1() + 1;
-        sourceVault.setInteger(transformation->getSourceI1() + (rand() % range));
+        sourceVault.setInteger(randomInRange(transformation->getSourceI1(), transformation->getSourceI2()));
         break;
     }
     case Transformation::SourceType::RandomSet:
     {
-        sourceVault.setStringReplacingVariables(transformation->getSourceTokenized()[rand () % transformation->getSourceTokenized().size()], transformation->getSourcePatterns(), variables, vault_); // replace variables if they exist
+        sourceVault.setStringReplacingVariables(transformation->getSourceTokenized()[randomIndex(transformation->getSourceTokenized().size())], transformation->getSourcePatterns(), variables, vault_); // replace variables if they exist
         break;
     }
     case Transformation::SourceType::Timestamp:
     {
-        if (transformation->getSource() == "s") {
-            sourceVault.setInteger(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
-        }
-        else if (transformation->getSource() == "ms") {
-            sourceVault.setInteger(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
-        }
-        else if (transformation->getSource() == "us") {
-            sourceVault.setInteger(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
-        }
-        else if (transformation->getSource() == "ns") {
-            sourceVault.setInteger(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+        auto now = std::chrono::system_clock::now().time_since_epoch();
+        switch (transformation->getSourceTimestampUnit()) { // resolved at load: 0: s, 1: ms, 2: us, 3: ns
+        case 0:
+            sourceVault.setInteger(std::chrono::duration_cast<std::chrono::seconds>(now).count());
+            break;
+        case 1:
+            sourceVault.setInteger(std::chrono::duration_cast<std::chrono::milliseconds>(now).count());
+            break;
+        case 2:
+            sourceVault.setInteger(std::chrono::duration_cast<std::chrono::microseconds>(now).count());
+            break;
+        default:
+            sourceVault.setInteger(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
         }
         break;
     }
@@ -276,8 +272,8 @@ bool AdminServerProvision::processSources(std::shared_ptr<Transformation> transf
     }
     case Transformation::SourceType::SVar:
     {
-        std::string varname = transformation->getSource();
-        replaceVariables(varname, transformation->getSourcePatterns(), variables, vault_);
+        std::string varname;
+        transformation->getSourceTemplate().render(varname, variables, vault_);
         auto iter = variables.find(varname);
         if (iter != variables.end()) sourceVault.setString(iter->second);
         else {
@@ -291,14 +287,14 @@ bool AdminServerProvision::processSources(std::shared_ptr<Transformation> transf
     }
     case Transformation::SourceType::SGVar:
     {
-        std::string varname = transformation->getSource();
-        replaceVariables(varname, transformation->getSourcePatterns(), variables, vault_);
-        nlohmann::json vaultValue{};
+        std::string varname;
+        transformation->getSourceTemplate().render(varname, variables, vault_);
+        std::shared_ptr<const nlohmann::json> vaultValue{}; // shared, not copied
         bool exists = vault_->tryGet(varname, vaultValue);
         if (exists) {
             std::string path = transformation->getSource2();
             if (!path.empty()) replaceVariables(path, transformation->getSourcePatterns(), variables, vault_);
-            if (!sourceVault.setObject(vaultValue, path)) {
+            if (!sourceVault.setObject(std::move(vaultValue), path)) {
                 LOGDEBUG(
                     std::string msg = ert::tracing::Logger::asString("Unable to extract path '%s' from vault entry '%s' in transformation item", path.c_str(), varname.c_str());
                     ert::tracing::Logger::debug(msg, ERT_FILE_LOCATION);
@@ -317,7 +313,7 @@ bool AdminServerProvision::processSources(std::shared_ptr<Transformation> transf
     }
     case Transformation::SourceType::Value:
     {
-        sourceVault.setStringReplacingVariables(transformation->getSource(), transformation->getSourcePatterns(), variables, vault_); // replace variables if they exist
+        sourceVault.setStringReplacingVariables(transformation->getSourceTemplate(), variables, vault_); // replace variables if they exist
         break;
     }
     case Transformation::SourceType::ServerEvent:
@@ -382,8 +378,8 @@ bool AdminServerProvision::processSources(std::shared_ptr<Transformation> transf
     }
     case Transformation::SourceType::STxtFile:
     {
-        std::string path = transformation->getSource();
-        replaceVariables(path, transformation->getSourcePatterns(), variables, vault_);
+        std::string path;
+        transformation->getSourceTemplate().render(path, variables, vault_);
 
         std::string content;
         file_manager_->read(path, content, true/*text*/);
@@ -392,8 +388,8 @@ bool AdminServerProvision::processSources(std::shared_ptr<Transformation> transf
     }
     case Transformation::SourceType::SBinFile:
     {
-        std::string path = transformation->getSource();
-        replaceVariables(path, transformation->getSourcePatterns(), variables, vault_);
+        std::string path;
+        transformation->getSourceTemplate().render(path, variables, vault_);
 
         std::string content;
         file_manager_->read(path, content, false/*binary*/);
@@ -402,8 +398,8 @@ bool AdminServerProvision::processSources(std::shared_ptr<Transformation> transf
     }
     case Transformation::SourceType::Command:
     {
-        std::string command = transformation->getSource();
-        replaceVariables(command, transformation->getSourcePatterns(), variables, vault_);
+        std::string command;
+        transformation->getSourceTemplate().render(command, variables, vault_);
 
         static char buffer[256];
         std::string output{};
@@ -548,8 +544,8 @@ bool AdminServerProvision::processFilters(std::shared_ptr<Transformation> transf
     }
     case Transformation::FilterType::Append:
     {
-        std::string filter = transformation->getFilter();
-        replaceVariables(filter, transformation->getFilterPatterns(), variables, vault_);
+        std::string filter;
+        transformation->getFilterTemplate().render(filter, variables, vault_);
 
         targetS = source + filter;
         sourceVault.setString(targetS);
@@ -557,8 +553,8 @@ bool AdminServerProvision::processFilters(std::shared_ptr<Transformation> transf
     }
     case Transformation::FilterType::Prepend:
     {
-        std::string filter = transformation->getFilter();
-        replaceVariables(filter, transformation->getFilterPatterns(), variables, vault_);
+        std::string filter;
+        transformation->getFilterTemplate().render(filter, variables, vault_);
 
         targetS = filter + source;
         sourceVault.setString(targetS);
@@ -640,9 +636,9 @@ bool AdminServerProvision::processFilters(std::shared_ptr<Transformation> transf
             LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("Variable '%s' found (local)", varname.c_str()), ERT_FILE_LOCATION));
         }
         else {
-            nlohmann::json gvarvalue{};
+            std::shared_ptr<const nlohmann::json> gvarvalue{};
             varFound = vault_->tryGet(varname, gvarvalue);
-            if (varFound) varvalue = jsonToString(gvarvalue);
+            if (varFound) varvalue = jsonToString(*gvarvalue);
             LOGDEBUG(if (varFound) ert::tracing::Logger::debug(ert::tracing::Logger::asString("Variable '%s' found (vault)", varname.c_str()), ERT_FILE_LOCATION));
         }
 
@@ -661,8 +657,8 @@ bool AdminServerProvision::processFilters(std::shared_ptr<Transformation> transf
     }
     case Transformation::FilterType::EqualTo:
     {
-        std::string filter = transformation->getFilter();
-        replaceVariables(filter, transformation->getFilterPatterns(), variables, vault_);
+        std::string filter;
+        transformation->getFilterTemplate().render(filter, variables, vault_);
 
         // Get value for the comparison 'transformation->getFilter()':
         if (source == filter) {
@@ -677,8 +673,8 @@ bool AdminServerProvision::processFilters(std::shared_ptr<Transformation> transf
     }
     case Transformation::FilterType::DifferentFrom:
     {
-        std::string filter = transformation->getFilter();
-        replaceVariables(filter, transformation->getFilterPatterns(), variables, vault_);
+        std::string filter;
+        transformation->getFilterTemplate().render(filter, variables, vault_);
 
         // Get value for the comparison 'transformation->getFilter()':
         if (source != filter) {
@@ -925,17 +921,14 @@ bool AdminServerProvision::processTargets(std::shared_ptr<Transformation> transf
     double targetF = 0;
     bool boolean = false;
     nlohmann::json obj;
+    nlohmann::json::json_pointer builtPointer; // only used for target paths with variables
 
 
     try { // nlohmann::json exceptions
 
-        std::string target = transformation->getTarget();
-        std::string target2 = transformation->getTarget2(); // foreign outState URI
-
-        replaceVariables(target, transformation->getTargetPatterns(), variables, vault_);
-        if (!target2.empty()) {
-            replaceVariables(target2, transformation->getTarget2Patterns(), variables, vault_);
-        }
+        std::string target, target2; // target2: foreign outState URI
+        transformation->getTargetTemplate().render(target, variables, vault_);
+        transformation->getTarget2Template().render(target2, variables, vault_);
 
         switch (transformation->getTargetType()) {
         case Transformation::TargetType::ResponseBodyString:
@@ -962,7 +955,7 @@ bool AdminServerProvision::processTargets(std::shared_ptr<Transformation> transf
             targetS = sourceVault.getString(success);
             if (!success) return false;
             // assignment
-            nlohmann::json::json_pointer j_ptr(target);
+            const nlohmann::json::json_pointer &j_ptr = transformation->getTargetPointer(target, builtPointer);
             responseBodyJson[j_ptr] = targetS;
             break;
         }
@@ -972,7 +965,7 @@ bool AdminServerProvision::processTargets(std::shared_ptr<Transformation> transf
             targetI = sourceVault.getInteger(success);
             if (!success) return false;
             // assignment
-            nlohmann::json::json_pointer j_ptr(target);
+            const nlohmann::json::json_pointer &j_ptr = transformation->getTargetPointer(target, builtPointer);
             responseBodyJson[j_ptr] = targetI;
             break;
         }
@@ -982,7 +975,7 @@ bool AdminServerProvision::processTargets(std::shared_ptr<Transformation> transf
             targetU = sourceVault.getUnsigned(success);
             if (!success) return false;
             // assignment
-            nlohmann::json::json_pointer j_ptr(target);
+            const nlohmann::json::json_pointer &j_ptr = transformation->getTargetPointer(target, builtPointer);
             responseBodyJson[j_ptr] = targetU;
             break;
         }
@@ -992,7 +985,7 @@ bool AdminServerProvision::processTargets(std::shared_ptr<Transformation> transf
             targetF = sourceVault.getFloat(success);
             if (!success) return false;
             // assignment
-            nlohmann::json::json_pointer j_ptr(target);
+            const nlohmann::json::json_pointer &j_ptr = transformation->getTargetPointer(target, builtPointer);
             responseBodyJson[j_ptr] = targetF;
             break;
         }
@@ -1002,7 +995,7 @@ bool AdminServerProvision::processTargets(std::shared_ptr<Transformation> transf
             boolean = sourceVault.getBoolean(success);
             if (!success) return false;
             // assignment
-            nlohmann::json::json_pointer j_ptr(target);
+            const nlohmann::json::json_pointer &j_ptr = transformation->getTargetPointer(target, builtPointer);
             responseBodyJson[j_ptr] = boolean;
             break;
         }
@@ -1033,7 +1026,7 @@ bool AdminServerProvision::processTargets(std::shared_ptr<Transformation> transf
 
             // extraction will be object if possible, falling back to the rest of formats with this priority: string, integer, unsigned, float, boolean
             // assignment for valid extraction
-            nlohmann::json::json_pointer j_ptr(target);
+            const nlohmann::json::json_pointer &j_ptr = transformation->getTargetPointer(target, builtPointer);
 
             // Native types for SOURCES:
             //
@@ -1091,7 +1084,7 @@ bool AdminServerProvision::processTargets(std::shared_ptr<Transformation> transf
         {
 
             // assignment for valid extraction
-            nlohmann::json::json_pointer j_ptr(target);
+            const nlohmann::json::json_pointer &j_ptr = transformation->getTargetPointer(target, builtPointer);
 
             // extraction
             targetS = sourceVault.getString(success);
@@ -1197,8 +1190,8 @@ bool AdminServerProvision::processTargets(std::shared_ptr<Transformation> transf
         }
         case Transformation::TargetType::TGVar:
         {
-            std::string gvarPath = transformation->getTarget2();
-            if (!gvarPath.empty()) replaceVariables(gvarPath, transformation->getTarget2Patterns(), variables, vault_);
+            std::string gvarPath;
+            transformation->getTarget2Template().render(gvarPath, variables, vault_);
 
             if (eraser) {
                 bool exists;
@@ -1276,8 +1269,8 @@ bool AdminServerProvision::processTargets(std::shared_ptr<Transformation> transf
         }
         case Transformation::TargetType::TGVarJson_Object:
         {
-            std::string gvarPath = transformation->getTarget2();
-            if (!gvarPath.empty()) replaceVariables(gvarPath, transformation->getTarget2Patterns(), variables, vault_);
+            std::string gvarPath;
+            transformation->getTarget2Template().render(gvarPath, variables, vault_);
 
             bool objSuccess = false;
             const nlohmann::json &obj = sourceVault.getObject(objSuccess);
@@ -1292,8 +1285,8 @@ bool AdminServerProvision::processTargets(std::shared_ptr<Transformation> transf
         }
         case Transformation::TargetType::TGVarJson_JsonString:
         {
-            std::string gvarPath = transformation->getTarget2();
-            if (!gvarPath.empty()) replaceVariables(gvarPath, transformation->getTarget2Patterns(), variables, vault_);
+            std::string gvarPath;
+            transformation->getTarget2Template().render(gvarPath, variables, vault_);
 
             targetS = sourceVault.getString(success);
             if (!success) return false;
@@ -1427,8 +1420,8 @@ bool AdminServerProvision::processTargets(std::shared_ptr<Transformation> transf
         }
         case Transformation::TargetType::ClientProvision_t:
         {
-            std::string clientProvisionId = transformation->getTarget();
-            replaceVariables(clientProvisionId, transformation->getTargetPatterns(), variables, vault_);
+            std::string clientProvisionId;
+            transformation->getTargetTemplate().render(clientProvisionId, variables, vault_);
 
             // Source acts as conditional gate: non-empty = trigger, empty/eraser = skip
             targetS = eraser ? "" : sourceVault.getString(success);
@@ -1438,8 +1431,8 @@ bool AdminServerProvision::processTargets(std::shared_ptr<Transformation> transf
                 break;
             }
 
-            std::string inState = transformation->getTarget2();
-            replaceVariables(inState, transformation->getTarget2Patterns(), variables, vault_);
+            std::string inState;
+            transformation->getTarget2Template().render(inState, variables, vault_);
             clientProvisionTriggers.emplace_back(clientProvisionId, inState);
             LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString(
                 "Scheduled client provision trigger: id='%s', inState='%s'", clientProvisionId.c_str(), inState.c_str()), ERT_FILE_LOCATION));
@@ -1542,51 +1535,42 @@ void AdminServerProvision::transform( const std::string &requestUri,
     outStateMethod = "";
     outStateUri = "";
 
+    // Static response: provisioned data (serialized at load) is served as is:
+    if (static_response_) {
+        responseBody = getResponseBodyAsString();
+        return;
+    }
+
     // Check if the request body must be decoded:
+    std::shared_ptr<h2agent::model::AdminSchema> requestSchema = getRequestSchema();
     bool mustDecodeRequestBody = false;
-    if (getRequestSchema()) {
+    if (requestSchema) {
         mustDecodeRequestBody = true;
     }
-    else {
-        for (const auto &t : transformations_) {
-            if (t->getSourceType() == Transformation::SourceType::RequestBody) {
-                if (!requestBodyDataPart.str().empty()) {
-                    mustDecodeRequestBody = true;
-                }
-                else {
-                    LOGINFORMATIONAL(ert::tracing::Logger::informational("Empty request body received: some transformations will be ignored", ERT_FILE_LOCATION));
-                }
-                break;
-            }
+    else if (has_request_body_source_) {
+        if (!requestBodyDataPart.str().empty()) {
+            mustDecodeRequestBody = true;
+        }
+        else {
+            LOGINFORMATIONAL(ert::tracing::Logger::informational("Empty request body received: some transformations will be ignored", ERT_FILE_LOCATION));
         }
     }
     if (mustDecodeRequestBody) {
-        requestBodyDataPart.decode(requestHeaders);
+        if (request_body_selective_decode_) requestBodyDataPart.decodeSelection(requestHeaders, request_body_selection_);
+        else requestBodyDataPart.decode(requestHeaders);
     }
 
     // Request schema validation (normally used to validate native json received, but can also be used to validate the agent json representation (multipart, text, etc.)):
-    if (getRequestSchema()) {
+    if (requestSchema) {
         std::string error{};
-        if (!getRequestSchema()->validate(requestBodyDataPart.getJson(), error)) {
+        if (!requestSchema->validate(requestBodyDataPart.getJson(), error)) {
             responseStatusCode = ert::http2comm::ResponseCode::BAD_REQUEST; // 400
             return; // INTERRUPT TRANSFORMATIONS
         }
     }
 
-    // Find out if response body will need to be cloned (this is true if any transformation uses it as target):
-    bool usesResponseBodyAsTransformationJsonTarget = false;
-    for (const auto &t : transformations_) {
-        if (t->getTargetType() == Transformation::TargetType::ResponseBodyJson_String ||
-                t->getTargetType() == Transformation::TargetType::ResponseBodyJson_Integer ||
-                t->getTargetType() == Transformation::TargetType::ResponseBodyJson_Unsigned ||
-                t->getTargetType() == Transformation::TargetType::ResponseBodyJson_Float ||
-                t->getTargetType() == Transformation::TargetType::ResponseBodyJson_Boolean ||
-                t->getTargetType() == Transformation::TargetType::ResponseBodyJson_Object ||
-                t->getTargetType() == Transformation::TargetType::ResponseBodyJson_JsonString) {
-            usesResponseBodyAsTransformationJsonTarget = true;
-            break;
-        }
-    }
+    // Response body will need to be cloned if any transformation uses it as target:
+    bool usesResponseBodyAsTransformationJsonTarget = has_response_body_json_target_;
 
     nlohmann::json responseBodyJson;
     if (usesResponseBodyAsTransformationJsonTarget) {
@@ -1658,9 +1642,10 @@ void AdminServerProvision::transform( const std::string &requestUri,
     }
 
     // Response schema validation (not supported for response body created by non-json targets, to simplify the fact to parse need on ResponseBodyString/ResponseBodyHexString):
-    if (getResponseSchema()) {
+    std::shared_ptr<h2agent::model::AdminSchema> responseSchema = getResponseSchema();
+    if (responseSchema) {
         std::string error{};
-        if (!getResponseSchema()->validate(usesResponseBodyAsTransformationJsonTarget ? responseBodyJson:getResponseBody(), error)) {
+        if (!responseSchema->validate(usesResponseBodyAsTransformationJsonTarget ? responseBodyJson:getResponseBody(), error)) {
             responseStatusCode = ert::http2comm::ResponseCode::INTERNAL_SERVER_ERROR; // 500: built response will be anyway sent although status code is overwritten with internal server error.
         }
     }
@@ -1763,6 +1748,32 @@ bool AdminServerProvision::load(const nlohmann::json &j, bool regexMatchingConfi
         }
     }
 
+    // Precompute transformation dispatch decisions:
+    for (const auto &t : transformations_) {
+        if (t->getSourceType() == Transformation::SourceType::RequestBody) has_request_body_source_ = true;
+        if (t->getTargetType() >= Transformation::TargetType::ResponseBodyJson_String && t->getTargetType() <= Transformation::TargetType::ResponseBodyJson_JsonString) has_response_body_json_target_ = true;
+    }
+    static_response_ = transformations_.empty() && request_schema_id_.empty() && response_schema_id_.empty();
+
+    // Request needs (onFilterFail fallbacks included), and request body selective decode (only json nodes referenced through precompiled paths):
+    bool selectable = request_schema_id_.empty();
+    std::function<void(const std::vector<std::shared_ptr<Transformation>>&)> scanRequestSources = [&](const std::vector<std::shared_ptr<Transformation>> &items) {
+        for (const auto &t : items) {
+            if (t->getSourceType() == Transformation::SourceType::RequestUriParam) {
+                has_request_uri_param_source_ = true;
+            }
+            else if (t->getSourceType() == Transformation::SourceType::RequestBody) {
+                needs_request_body_ = true;
+                const nlohmann::json::json_pointer *pointer = t->getSourcePointer();
+                if (!pointer || !request_body_selection_.add(pointer->to_string())) selectable = false;
+            }
+            scanRequestSources(t->getOnFilterFail());
+        }
+    };
+    scanRequestSources(transformations_);
+    if (!request_schema_id_.empty()) needs_request_body_ = true;
+    request_body_selective_decode_ = selectable && !request_body_selection_.empty();
+
     // Store key:
     h2agent::model::calculateStringKey(key_, in_state_, request_method_, request_uri_);
 
@@ -115,6 +115,15 @@ class AdminServerProvision
 
     std::vector<std::shared_ptr<Transformation>> transformations_{};
 
+    // Transformation dispatch decisions, resolved once at load():
+    bool has_request_body_source_{}; // request body must be decoded (if received)
+    bool has_response_body_json_target_{}; // provisioned response body must be cloned to be modified
+    bool static_response_{}; // no transformations nor schemas: provisioned response is served as is
+    bool needs_request_body_{}; // request schema or request body source (onFilterFail fallbacks included)
+    JsonPointerSelection request_body_selection_{}; // request body nodes referenced by sources
+    bool request_body_selective_decode_{}; // no schema nor whole/variable path sources: decode just the selection
+    bool has_request_uri_param_source_{}; // query parameters map must be provided (onFilterFail fallbacks included)
+
     // Three processing stages: get sources, apply filters and store targets:
     bool processSources(std::shared_ptr<Transformation> transformation,
                         TypeConverter& sourceVault,
@@ -283,7 +292,7 @@ public:
      * Provision is being employed
      */
     void employ() {
-        employed_ = true;
+        if (!employed_) employed_ = true; // avoid writing the shared flag on every request
     }
 
     // getters:
@@ -333,6 +342,14 @@ public:
         return out_state_;
     }
 
+    /** Provision response is static (no transformations nor schemas)
+     *
+     * @return Static response indicator
+     */
+    bool isStaticResponse() const {
+        return static_response_;
+    }
+
     /** Provisioned in state
      *
      * @return In state
@@ -423,6 +440,27 @@ public:
         }
         return false;
     }
+
+    /**
+     * Checks if the request body is used by this provision (request schema validation or
+     * request body source, also within onFilterFail fallbacks). Event storage, which also
+     * keeps the request body, is not considered here.
+     *
+     * @return True if request body must be received
+     */
+    bool needsRequestBody() const {
+        return needs_request_body_;
+    }
+
+    /**
+     * Checks if query parameters map is used by this provision (request uri parameter
+     * sources, also within onFilterFail fallbacks)
+     *
+     * @return True if query parameters map must be provided to transform()
+     */
+    bool needsQueryParametersMap() const {
+        return has_request_uri_param_source_;
+    }
 };
 
 }
@@ -34,7 +34,10 @@ SOFTWARE.
 */
 
 #include <string>
+#include <string_view>
 #include <regex>
+#include <algorithm>
+#include <functional>
 
 #include <nlohmann/json.hpp>
 
@@ -50,6 +53,7 @@ namespace model
 {
 
 AdminServerProvisionData::AdminServerProvisionData() {
+    std::atomic_store(&regex_matching_index_, std::make_shared<const RegexMatchingIndex>());
     server_provision_schema_.setJson(h2agent::adminSchemas::server_provision); // won't fail
 }
 
@@ -122,47 +126,106 @@ AdminServerProvisionData::LoadResult AdminServerProvisionData::loadSingle(const
 
 AdminServerProvisionData::LoadResult AdminServerProvisionData::load(const nlohmann::json &j, bool regexMatchingConfigured, const common_resources_t &cr) {
 
+    LoadResult result = Success;
+
     if (j.is_array()) {
         for (auto it : j) // "it" is of type json::reference and has no key() member
         {
-            LoadResult result = loadSingle(it, regexMatchingConfigured, cr);
+            result = loadSingle(it, regexMatchingConfigured, cr);
             if (result != Success)
-                return result;
+                break;
         }
+    }
+    else {
+        result = loadSingle(j, regexMatchingConfigured, cr);
+    }
 
-        return Success;
+    // Index is rebuilt once per operation (items loaded before a failure are kept, as always):
+    write_guard_t guard(rw_mutex_);
+    rebuildRegexMatchingIndex();
+
+    return result;
+}
+
+void AdminServerProvisionData::rebuildRegexMatchingIndex() {
+
+    auto index = std::make_shared<RegexMatchingIndex>();
+
+    // Provisions grouped by literal prefix (in insertion order):
+    std::map<std::string, std::vector<std::pair<std::size_t, std::shared_ptr<AdminServerProvision>>>> groups;
+    bool aux{};
+    for (std::size_t order = 0; order < ordered_keys_.size(); order++) {
+        auto provision = get(ordered_keys_[order], aux);
+        if (!provision) continue;
+        std::string prefix = h2agent::model::regexLiteralPrefix(provision->getKey());
+        index->prefix_lengths.push_back(prefix.size());
+        groups[prefix].emplace_back(order, provision);
     }
 
-    return loadSingle(j, regexMatchingConfigured, cr);
+    std::sort(index->prefix_lengths.begin(), index->prefix_lengths.end(), std::greater<std::size_t>());
+    index->prefix_lengths.erase(std::unique(index->prefix_lengths.begin(), index->prefix_lengths.end()), index->prefix_lengths.end());
+
+    // Candidates for each prefix: groups of every prefix starting it (itself included), merged by insertion order:
+    std::vector<std::pair<std::size_t, std::shared_ptr<AdminServerProvision>>> merged;
+    for (const auto &group : groups) {
+        const std::string &prefix = group.first;
+        merged.clear();
+        for (std::size_t length : index->prefix_lengths) {
+            if (length > prefix.size()) continue;
+            auto it = groups.find(prefix.substr(0, length));
+            if (it != groups.end()) merged.insert(merged.end(), it->second.begin(), it->second.end());
+        }
+        std::sort(merged.begin(), merged.end(), [](const auto &a, const auto &b) {
+            return a.first < b.first;
+        });
+
+        auto &candidates = index->candidates[prefix];
+        candidates.reserve(merged.size());
+        for (const auto &entry : merged) candidates.push_back(entry.second);
+    }
+
+    LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("RegexMatching index rebuilt: %zu provisions grouped in %zu literal prefixes", ordered_keys_.size(), groups.size()), ERT_FILE_LOCATION));
+
+    // Atomic swap — traffic threads holding the old shared_ptr are safe
+    std::atomic_store(&regex_matching_index_, std::shared_ptr<const RegexMatchingIndex>(std::move(index)));
+    generation_.fetch_add(1, std::memory_order_release);
 }
 
 bool AdminServerProvisionData::clear()
 {
     write_guard_t guard(rw_mutex_);
     ordered_keys_.clear();
-    return Map::clear();
+    bool result = Map::clear();
+    rebuildRegexMatchingIndex();
+    return result;
 }
 
 std::shared_ptr<AdminServerProvision> AdminServerProvisionData::find(const std::string &inState, const std::string &method, const std::string &uri) const {
-    admin_server_provision_key_t key{};
-    h2agent::model::calculateStringKey(key, inState, method, uri);
-
-    bool exists{};
-    auto result = get(key, exists);
-    return (exists ? result:nullptr);
+    std::shared_ptr<AdminServerProvision> result(nullptr);
+    tryGet(CompositeKeyView(inState, method, uri), result);
+    return result;
 }
 
 std::shared_ptr<AdminServerProvision> AdminServerProvisionData::findRegexMatching(const std::string &inState, const std::string &method, const std::string &uri) const {
-    admin_server_provision_key_t key{};
-    h2agent::model::calculateStringKey(key, inState, method, uri);
-
-    read_guard_t guard(rw_mutex_);
-    bool aux{};
-    for (auto it = ordered_keys_.begin(); it != ordered_keys_.end(); it++) {
-        auto provision = get(*it, aux);
-        if (std::regex_match(key, provision->getRegex()))
-            return provision;
-    };
+    thread_local admin_server_provision_key_t key{}; // capacity reused
+    CompositeKeyView(inState, method, uri).compose(key);
+
+    // Index snapshot (held for the duration of this search):
+    auto index = std::atomic_load(&regex_matching_index_);
+
+    // Candidates of the longest literal prefix starting the key (already merged and ordered at load):
+    std::string_view keyView(key);
+    for (std::size_t length : index->prefix_lengths) {
+        if (length > keyView.size()) continue;
+        auto it = index->candidates.find(keyView.substr(0, length));
+        if (it == index->candidates.end()) continue;
+
+        for (const auto &provision : it->second) {
+            if (std::regex_match(key, provision->getRegex()))
+                return provision;
+        }
+        break;
+    }
 
     return nullptr;
 }
@@ -37,6 +37,11 @@ SOFTWARE.
 
 #include <vector>
 #include <string>
+#include <string_view>
+#include <map>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
 
@@ -110,7 +115,10 @@ public:
     /**
     * Finds provision item for traffic reception. Previously, mock dynamic data should be checked to
     * know if current state exists for the reception.
-    * The algorithm is RegexMatching, so ordered search is applied.
+    * The algorithm is RegexMatching, so ordered search is applied (first match wins), although only
+    * those provisions whose key literal prefix is compatible with the reception key are evaluated.
+    * Composing the key and selecting those candidates don't allocate, but each std::regex_match
+    * evaluation may do it for its internal matching state.
     *
     * @param inState Request input state if proceeed
     * @param method Request method received
@@ -127,6 +135,16 @@ public:
         return server_provision_schema_;
     }
 
+    /**
+    * Provisions generation, increased on every load or clear operation. This can be used
+    * to invalidate information cached from the provisions set.
+    *
+    * @return Current generation
+    */
+    std::uint64_t getGeneration() const {
+        return generation_.load(std::memory_order_acquire);
+    }
+
     /**
     * Checks if any loaded provision references event-dependent transformation types
     *
@@ -142,11 +160,27 @@ public:
 
 private:
 
+    // Immutable RegexMatching index snapshot (thread-safe by design): provisions are
+    // grouped by the literal prefix of their key regular expression, so a reception
+    // only evaluates the regex of those provisions whose prefix starts its own key.
+    // Those prefixes are nested, so candidates are merged at load for each prefix (its
+    // own provisions and those of shorter prefixes starting it, by insertion order):
+    // a reception just takes the candidates of the longest prefix starting its key.
+    struct RegexMatchingIndex {
+        std::map<std::string, std::vector<std::shared_ptr<AdminServerProvision>>, std::less<>> candidates{}; // transparent comparator to find by std::string_view
+        std::vector<std::size_t> prefix_lengths{}; // distinct prefix lengths in descending order
+    };
+
     std::vector<admin_server_provision_key_t> ordered_keys_{}; // this is used to keep the insertion order which shall be used in RegexMatching algorithm
+    std::shared_ptr<const RegexMatchingIndex> regex_matching_index_{};
+    std::atomic<std::uint64_t> generation_{};
     h2agent::jsonschema::JsonSchema server_provision_schema_{};
 
     LoadResult loadSingle(const nlohmann::json &j, bool regexMatchingConfigured, const common_resources_t &cr);
 
+    // Rebuilds and swaps the RegexMatching index, increasing the generation (rw_mutex_ must be held)
+    void rebuildRegexMatchingIndex();
+
     mutable mutex_t rw_mutex_{}; // specific mutex (apart from Map's one) to protect own ordered_keys_ version of keys.
 };
 
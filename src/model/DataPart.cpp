@@ -33,6 +33,9 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+#include <algorithm>
+#include <cctype>
+
 #include <ert/tracing/Logger.hpp>
 #include <ert/http2comm/Http2Headers.hpp>
 
@@ -80,6 +83,235 @@ void MyMultipartConsumer::receiveData(const std::string &data) {
     data_count_++;
 }
 
+// JsonPointerSelection
+
+bool JsonPointerSelection::add(const std::string &pointer) {
+
+    if (pointer.empty() || pointer[0] != '/') return false;
+    if (std::find(pointers_.begin(), pointers_.end(), pointer) != pointers_.end()) return true;
+    if (paths_.size() == MaxPointers) return false;
+
+    std::vector<Token> tokens;
+    std::size_t start = 1;
+    while (true) {
+        std::size_t end = pointer.find('/', start);
+        std::string key = pointer.substr(start, (end == std::string::npos) ? std::string::npos : end - start);
+
+        // Unescape as RFC 6901 ('~1' before '~0'):
+        for (std::size_t pos = key.find('~'); pos != std::string::npos; pos = key.find('~', pos + 1)) {
+            if (pos + 1 == key.size() || (key[pos + 1] != '0' && key[pos + 1] != '1')) return false;
+            key.replace(pos, 2, (key[pos + 1] == '1') ? "/" : "~");
+        }
+
+        Token token{std::move(key), 0, false};
+        const std::string &k = token.key;
+        if (!k.empty() && k.size() < 20 && (k == "0" || (k[0] != '0' && std::all_of(k.begin(), k.end(), [](unsigned char c) {
+        return std::isdigit(c);
+        })))) {
+            token.index = std::stoull(k);
+            token.numeric = true;
+        }
+        tokens.push_back(std::move(token));
+
+        if (end == std::string::npos) break;
+        start = end + 1;
+    }
+
+    pointers_.push_back(pointer);
+    paths_.push_back(std::move(tokens));
+    return true;
+}
+
+namespace
+{
+
+// Sax handler which builds a skeleton document with the selected nodes. Containers
+// not leading to a selected node are parsed but skipped, with no DOM allocations.
+class SelectionSaxHandler : public nlohmann::json_sax<nlohmann::json> {
+
+    using json = nlohmann::json;
+
+    // Container in the path towards selected nodes:
+    struct Level {
+        bool array;
+        std::uint64_t mask; // pointers still matching at this level
+        std::uint64_t key_mask; // pointers matching current object key
+        std::string key; // current object key (only kept when matching)
+        std::size_t next_index; // next array element index
+    };
+
+    const std::vector<std::vector<JsonPointerSelection::Token>> &paths_;
+    json &result_;
+
+    std::vector<Level> levels_{};
+    std::size_t skip_depth_{}; // nesting inside a non-selected container
+    std::vector<json*> capture_stack_{}; // building a selected container
+    json *capture_element_{}; // object member being captured
+
+    // Mask for a new value in current position, and if it is a selected node:
+    std::uint64_t valueMask(bool &selected) {
+        selected = false;
+        if (levels_.empty()) return (paths_.size() == 64) ? ~std::uint64_t(0) : ((std::uint64_t(1) << paths_.size()) - 1);
+
+        Level &level = levels_.back();
+        std::size_t depth = levels_.size() - 1; // token index for the value
+        std::uint64_t result = 0;
+        if (level.array) {
+            std::size_t index = level.next_index++;
+            if (level.mask == 0) return 0;
+            for (std::size_t k = 0; k < paths_.size(); k++) {
+                if (!(level.mask & (std::uint64_t(1) << k))) continue;
+                const auto &token = paths_[k][depth];
+                if (token.numeric && token.index == index) result |= (std::uint64_t(1) << k);
+            }
+        }
+        else {
+            result = level.key_mask;
+        }
+
+        for (std::size_t k = 0; result && k < paths_.size(); k++) {
+            if ((result & (std::uint64_t(1) << k)) && paths_[k].size() == depth + 1) {
+                selected = true;
+                break;
+            }
+        }
+        return result;
+    }
+
+    // Node at current position in the skeleton document (created on demand, mirroring the source):
+    json *target() {
+        json *node = &result_;
+        for (const auto &level : levels_) {
+            if (level.array) {
+                if (!node->is_array()) *node = json::array();
+                std::size_t index = level.next_index - 1;
+                while (node->size() <= index) node->push_back(nullptr);
+                node = &(*node)[index];
+            }
+            else {
+                if (!node->is_object()) *node = json::object();
+                node = &(*node)[level.key];
+            }
+        }
+        return node;
+    }
+
+    // Captured value within a selected container:
+    json *captureValue(json &&value) {
+        json &parent = *capture_stack_.back();
+        if (parent.is_array()) {
+            parent.push_back(std::move(value));
+            return &parent.back();
+        }
+        *capture_element_ = std::move(value);
+        return capture_element_;
+    }
+
+    bool scalar(json &&value) {
+        if (!capture_stack_.empty()) {
+            captureValue(std::move(value));
+            return true;
+        }
+        if (skip_depth_ != 0) return true;
+
+        bool selected;
+        valueMask(selected);
+        if (selected) *target() = std::move(value);
+        return true;
+    }
+
+    bool startContainer(bool array) {
+        if (!capture_stack_.empty()) {
+            capture_stack_.push_back(captureValue(array ? json::array() : json::object()));
+            return true;
+        }
+        if (skip_depth_ != 0) {
+            skip_depth_++;
+            return true;
+        }
+
+        bool selected;
+        std::uint64_t mask = valueMask(selected);
+        if (selected) {
+            json *node = target();
+            *node = array ? json::array() : json::object();
+            capture_stack_.push_back(node);
+        }
+        else if (mask == 0) {
+            skip_depth_++;
+        }
+        else {
+            levels_.push_back(Level{array, mask, 0, std::string{}, 0});
+        }
+        return true;
+    }
+
+    bool endContainer() {
+        if (!capture_stack_.empty()) capture_stack_.pop_back();
+        else if (skip_depth_ != 0) skip_depth_--;
+        else levels_.pop_back();
+        return true;
+    }
+
+public:
+    SelectionSaxHandler(const JsonPointerSelection &selection, json &result) : paths_(selection.paths()), result_(result) {;}
+
+    bool null() override {
+        return scalar(nullptr);
+    }
+    bool boolean(bool val) override {
+        return scalar(val);
+    }
+    bool number_integer(number_integer_t val) override {
+        return scalar(val);
+    }
+    bool number_unsigned(number_unsigned_t val) override {
+        return scalar(val);
+    }
+    bool number_float(number_float_t val, const string_t &) override {
+        return scalar(val);
+    }
+    bool string(string_t &val) override {
+        return scalar(std::move(val));
+    }
+    bool binary(binary_t &val) override {
+        return scalar(json::binary(std::move(val)));
+    }
+    bool start_object(std::size_t) override {
+        return startContainer(false);
+    }
+    bool key(string_t &val) override {
+        if (!capture_stack_.empty()) {
+            capture_element_ = &(*capture_stack_.back())[val];
+            return true;
+        }
+        if (skip_depth_ != 0) return true;
+
+        Level &level = levels_.back();
+        std::size_t depth = levels_.size() - 1;
+        level.key_mask = 0;
+        for (std::size_t k = 0; k < paths_.size(); k++) {
+            if ((level.mask & (std::uint64_t(1) << k)) && paths_[k][depth].key == val) level.key_mask |= (std::uint64_t(1) << k);
+        }
+        if (level.key_mask != 0) level.key = val;
+        return true;
+    }
+    bool end_object() override {
+        return endContainer();
+    }
+    bool start_array(std::size_t) override {
+        return startContainer(true);
+    }
+    bool end_array() override {
+        return endContainer();
+    }
+    bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &) override {
+        return false;
+    }
+};
+
+}
+
 // DataPart
 
 std::string DataPart::asAsciiString() const {
@@ -146,6 +378,12 @@ void DataPart::decode(const nghttp2::asio_http2::header_map &headers) {
         return;
     }
 
+    if (partial_) { // selection decoded before: start again
+        json_ = nlohmann::json{};
+        is_json_ = false;
+        partial_ = false;
+    }
+
     if (str_.empty()) {
         decoded_ = true;
         is_json_ = false;
@@ -175,7 +413,29 @@ void DataPart::decode(const nghttp2::asio_http2::header_map &headers) {
     ert::tracing::Logger::debug(ert::tracing::Logger::asString("DataPart json representation: %s", msg.c_str()), ERT_FILE_LOCATION);
     );
 }
+void DataPart::decodeSelection(const nghttp2::asio_http2::header_map &headers, const JsonPointerSelection &selection) {
 
-}
+    if (decoded_ || partial_) return;
+
+    auto ct_it = headers.find("content-type");
+    if (str_.empty() || selection.empty() || ct_it == headers.end() || ct_it->second.value != "application/json") {
+        decode(headers);
+        return;
+    }
+
+    SelectionSaxHandler handler(selection, json_);
+    if (!nlohmann::json::sax_parse(str_, &handler)) {
+        LOGDEBUG(ert::tracing::Logger::debug("Selective json decode failed: full decode will be done", ERT_FILE_LOCATION));
+        json_ = nlohmann::json{};
+        decode(headers);
+        return;
+    }
+
+    is_json_ = true;
+    partial_ = true;
+
+    LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("DataPart json representation (selection): %s", json_.dump().c_str()), ERT_FILE_LOCATION));
 }
 
+}
+}
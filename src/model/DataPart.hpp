@@ -38,6 +38,8 @@ SOFTWARE.
 #include <nghttp2/asio_http2_server.h>
 
 #include <string>
+#include <vector>
+#include <cstdint>
 
 #include <nlohmann/json.hpp>
 
@@ -66,6 +68,46 @@ public:
     void receiveData(const std::string &data);
 };
 
+/**
+ * Set of json pointers (precompiled paths without variables) to be extracted from
+ * a json document without building the whole DOM (see DataPart::decodeSelection()).
+ */
+class JsonPointerSelection {
+public:
+    // Reference token: numeric tokens also select array elements
+    struct Token {
+        std::string key;
+        std::size_t index;
+        bool numeric;
+    };
+
+    // Mask based matching limits the number of selected pointers:
+    static constexpr std::size_t MaxPointers = 64;
+
+    /**
+     * Adds a json pointer to the selection (duplicates are ignored)
+     *
+     * @param pointer json pointer path (whole document, empty path, is not selectable)
+     *
+     * @return False if pointer is not valid or selectable, or selection is full
+     */
+    bool add(const std::string &pointer);
+
+    /** Selection is empty */
+    bool empty() const {
+        return paths_.empty();
+    }
+
+    /** Reference tokens for every selected pointer */
+    const std::vector<std::vector<Token>> &paths() const {
+        return paths_;
+    }
+
+private:
+    std::vector<std::string> pointers_{};
+    std::vector<std::vector<Token>> paths_{};
+};
+
 /**
  * DataPart to store request/response body data
  * Also provides a way to represent data in json format, even for basic string values.
@@ -119,6 +161,7 @@ class DataPart {
     std::string str_; // raw data content: always filled with the original data received
     bool decoded_; // lazy decode indicator to skip multiple decode operations
     bool is_json_; // if not, we will use str_ as native source instead of json representation
+    bool partial_{}; // json representation only holds a selection of nodes (full decode still pending)
 
     nlohmann::json json_; // data json representation valid for:
     // 1) parse json strings received (application/json)
@@ -161,6 +204,7 @@ public:
             str_ = other.str_;
             decoded_ = other.decoded_;
             is_json_ = other.is_json_;
+            partial_ = other.partial_;
             json_ = other.json_;
         }
         return *this;
@@ -173,6 +217,7 @@ public:
             json_ = std::move(other.json_);
             decoded_ = other.decoded_; // it has no sense to move
             is_json_ = other.is_json_; // it has no sense to move
+            partial_ = other.partial_; // it has no sense to move
         }
         return *this;
     }
@@ -205,11 +250,13 @@ public:
         str_ = std::move(str);
         decoded_ = false;
         is_json_ = false;
+        partial_ = false;
     }
     void assign(const std::string &str) {
         str_ = str;
         decoded_ = false;
         is_json_ = false;
+        partial_ = false;
     }
     bool assignFromHex(const std::string &strAsHex);
 
@@ -219,6 +266,18 @@ public:
     /** decode string data depending on content type */
     void decode(const nghttp2::asio_http2::header_map &headers /* to get the content-type */);
 
+    /**
+     * Decodes only the selected json nodes, when content type is 'application/json'.
+     * The json representation is then a skeleton document holding those nodes at the
+     * same paths (so they are accessed as usual), and decode() will later build the
+     * whole representation if needed. Full decode is done for any other content type
+     * or invalid json content.
+     *
+     * @param headers Headers to get the content-type
+     * @param selection Json pointers to extract
+     */
+    void decodeSelection(const nghttp2::asio_http2::header_map &headers, const JsonPointerSelection &selection);
+
     friend class MyMultipartConsumer;
 };
 
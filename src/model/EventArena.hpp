@@ -0,0 +1,508 @@
+/*
+ ___________________________________________
+|    _     ___                        _     |
+|   | |   |__ \                      | |    |
+|   | |__    ) |__ _  __ _  ___ _ __ | |_   |
+|   | '_ \  / // _` |/ _` |/ _ \ '_ \| __|  |  HTTP/2 AGENT FOR MOCK TESTING
+|   | | | |/ /| (_| | (_| |  __/ | | | |_   |  Version 0.0.z
+|   |_| |_|____\__,_|\__, |\___|_| |_|\__|  |  https://github.com/testillano/h2agent
+|                     __/ |                 |
+|                    |___/                  |
+|___________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <nghttp2/asio_http2_server.h>
+
+#include <common.hpp>
+
+
+namespace h2agent
+{
+namespace model
+{
+
+// Minimum number of blocks carved from each slab of the events pools (slabs are sized to a power of two):
+static constexpr std::size_t EventSlabBlocks = 256;
+// Independent stripes of the events pools (threads are spread among them):
+static constexpr std::size_t EventPoolStripes = 16;
+// Maximum number of distinct strings per interner (further values are owned by the event):
+static constexpr std::size_t InternedStringsCapacity = 4096;
+
+/**
+ * Thread-safe pool of fixed-size blocks, carved from slabs allocated on demand.
+ *
+ * Released blocks go back to the free list of their slab to be recycled by the next allocation,
+ * so a long-lived store with continuous insertions and removals does not fragment the heap.
+ *
+ * Slabs belong to stripes, each one with its own lock, and every thread allocates from its own
+ * stripe, so threads don't contend unless they release blocks allocated by others. Slabs are
+ * aligned to their size: the slab of a block (and then its stripe) is found by masking its
+ * address. Each slab is returned to the system as soon as it becomes empty, except one per stripe
+ * which is kept to avoid allocating a new slab on the next request.
+ */
+class SlabPool {
+
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    struct Stripe;
+
+    // Header at the beginning of each slab:
+    struct Slab {
+        Stripe *stripe;
+        Slab *prev;
+        Slab *next;
+        FreeBlock *free;
+        std::size_t used;
+    };
+
+    struct alignas(64) Stripe {
+        std::mutex mutex_{};
+        Slab *available_{}; // slabs with free blocks
+        Slab *full_{};
+        std::size_t empty_{}; // empty slabs kept
+    };
+
+    const std::size_t block_size_;
+    const std::size_t header_size_;
+    const std::size_t slab_size_;
+    const std::size_t blocks_per_slab_;
+
+    std::array<Stripe, EventPoolStripes> stripes_{};
+    std::atomic<std::size_t> slabs_{};
+    std::atomic<std::size_t> used_{};
+
+    static std::size_t roundUp(std::size_t size, std::size_t alignment) {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    static std::size_t powerOfTwo(std::size_t size) {
+        std::size_t result = alignof(std::max_align_t);
+        while (result < size) result <<= 1;
+        return result;
+    }
+
+    // Stripe for the calling thread (assigned round robin on its first allocation):
+    static std::size_t threadStripe() {
+        static std::atomic<std::size_t> next{};
+        thread_local std::size_t result = next.fetch_add(1, std::memory_order_relaxed) % EventPoolStripes;
+        return result;
+    }
+
+    static void link(Slab *&list, Slab *slab) {
+        slab->prev = nullptr;
+        slab->next = list;
+        if (list) list->prev = slab;
+        list = slab;
+    }
+
+    static void unlink(Slab *&list, Slab *slab) {
+        if (slab->prev) slab->prev->next = slab->next;
+        else list = slab->next;
+        if (slab->next) slab->next->prev = slab->prev;
+    }
+
+    Slab *create(Stripe &stripe) {
+        unsigned char *memory = static_cast<unsigned char*>(::operator new(slab_size_, std::align_val_t(slab_size_)));
+        Slab *slab = new (memory) Slab{&stripe, nullptr, nullptr, nullptr, 0};
+        for (std::size_t k = blocks_per_slab_; k-- > 0;) {
+            FreeBlock *block = reinterpret_cast<FreeBlock*>(memory + header_size_ + k * block_size_);
+            block->next = slab->free;
+            slab->free = block;
+        }
+        slabs_.fetch_add(1, std::memory_order_relaxed);
+        return slab;
+    }
+
+    void destroy(Slab *slab) {
+        slab->~Slab();
+        ::operator delete(static_cast<void*>(slab), std::align_val_t(slab_size_));
+        slabs_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+public:
+    /**
+     * Constructor
+     *
+     * @param blockSize Minimum size of each block (rounded up to the maximum fundamental alignment)
+     * @param blocksPerSlab Minimum number of blocks per slab (the slab size is rounded up to a power of two)
+     */
+    SlabPool(std::size_t blockSize, std::size_t blocksPerSlab) :
+        block_size_(roundUp(std::max(blockSize, sizeof(FreeBlock)), alignof(std::max_align_t))),
+        header_size_(roundUp(sizeof(Slab), alignof(std::max_align_t))),
+        slab_size_(powerOfTwo(header_size_ + block_size_ * std::max(blocksPerSlab, std::size_t(1)))),
+        blocks_per_slab_((slab_size_ - header_size_) / block_size_) {}
+
+    ~SlabPool() {
+        for (auto &stripe : stripes_) {
+            for (Slab *list : {
+                        stripe.available_, stripe.full_
+                    }) {
+                while (list) {
+                    Slab *next = list->next;
+                    destroy(list);
+                    list = next;
+                }
+            }
+        }
+    }
+
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    /** Takes a block from the pool, allocating a new slab when the thread stripe has no free blocks */
+    void *allocate() {
+        Stripe &stripe = stripes_[threadStripe()];
+        std::lock_guard<std::mutex> guard(stripe.mutex_);
+
+        Slab *slab = stripe.available_;
+        if (!slab) {
+            slab = create(stripe);
+            link(stripe.available_, slab);
+        }
+        else if (slab->used == 0) {
+            stripe.empty_--;
+        }
+
+        FreeBlock *block = slab->free;
+        slab->free = block->next;
+        slab->used++;
+        if (!slab->free) {
+            unlink(stripe.available_, slab);
+            link(stripe.full_, slab);
+        }
+
+        used_.fetch_add(1, std::memory_order_relaxed);
+        return block;
+    }
+
+    /** Gives back a block to its slab, which is released when it becomes empty (but the stripe last one) */
+    void deallocate(void *p) {
+        Slab *slab = reinterpret_cast<Slab*>(reinterpret_cast<std::uintptr_t>(p) & ~(std::uintptr_t)(slab_size_ - 1));
+        Stripe &stripe = *slab->stripe;
+        Slab *released{};
+        {
+            std::lock_guard<std::mutex> guard(stripe.mutex_);
+
+            if (!slab->free) {
+                unlink(stripe.full_, slab);
+                link(stripe.available_, slab);
+            }
+            FreeBlock *block = static_cast<FreeBlock*>(p);
+            block->next = slab->free;
+            slab->free = block;
+
+            if (--slab->used == 0) {
+                if (stripe.empty_ != 0) {
+                    unlink(stripe.available_, slab);
+                    released = slab;
+                }
+                else {
+                    stripe.empty_++;
+                }
+            }
+        }
+
+        used_.fetch_sub(1, std::memory_order_relaxed);
+        if (released) destroy(released); // out of the stripe lock
+    }
+
+    /** Block size in bytes */
+    std::size_t blockSize() const {
+        return block_size_;
+    }
+
+    /** Number of blocks per slab */
+    std::size_t blocksPerSlab() const {
+        return blocks_per_slab_;
+    }
+
+    /** Number of slabs currently allocated */
+    std::size_t slabs() const {
+        return slabs_.load(std::memory_order_relaxed);
+    }
+
+    /** Number of blocks in use */
+    std::size_t used() const {
+        return used_.load(std::memory_order_relaxed);
+    }
+};
+
+/**
+ * Standard allocator over a slab pool dedicated to its value type.
+ *
+ * Intended for 'std::allocate_shared', so the shared object and its control block
+ * are placed together in a single pool block.
+ */
+template<typename T>
+class SlabAllocator {
+public:
+    using value_type = T;
+
+    SlabAllocator() noexcept {}
+    template<typename U> SlabAllocator(const SlabAllocator<U>&) noexcept {}
+
+    /** Pool for this value type (never destroyed, as events may outlive static objects at exit) */
+    static SlabPool &pool() {
+        static SlabPool *result = new SlabPool(sizeof(T), EventSlabBlocks);
+        return *result;
+    }
+
+    T *allocate(std::size_t n) {
+        if (n != 1) return static_cast<T*>(::operator new(n * sizeof(T)));
+        return static_cast<T*>(pool().allocate());
+    }
+
+    void deallocate(T *p, std::size_t n) noexcept {
+        if (n != 1) {
+            ::operator delete(p);
+            return;
+        }
+        pool().deallocate(p);
+    }
+};
+
+template<typename T, typename U>
+bool operator==(const SlabAllocator<T>&, const SlabAllocator<U>&) {
+    return true;
+}
+template<typename T, typename U>
+bool operator!=(const SlabAllocator<T>&, const SlabAllocator<U>&) {
+    return false;
+}
+
+/**
+ * Thread-safe pool of unique strings, shared by the events which use them.
+ *
+ * The interner does not own the strings: they are released with the last event referring to
+ * them, and their entries are reclaimed when the interner is full. It is also bounded to avoid
+ * unlimited growth when values are not repeated: once full of live strings, nothing else is interned.
+ */
+class StringInterner {
+
+    mutable mutex_t mutex_{};
+    std::unordered_map<std::string, std::weak_ptr<const std::string>> strings_{};
+    const std::size_t capacity_;
+    std::size_t misses_{}; // values not interned since the latest reclaim
+    std::size_t reclaim_after_{}; // misses needed to reclaim again (amortizes the scan when most strings are alive)
+
+    // Drops the entries whose string was released (write lock must be held):
+    std::size_t reclaim() {
+        std::size_t result = 0;
+        for (auto it = strings_.begin(); it != strings_.end();) {
+            if (it->second.expired()) {
+                it = strings_.erase(it);
+                result++;
+            }
+            else it++;
+        }
+        return result;
+    }
+
+public:
+    StringInterner(std::size_t capacity = InternedStringsCapacity) : capacity_(capacity) {}
+
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    /**
+     * Interns a string
+     *
+     * @param str String to intern
+     *
+     * @return Shared unique copy (or an unshared one if the interner is full)
+     */
+    std::shared_ptr<const std::string> intern(const std::string &str) {
+        {
+            read_guard_t guard(mutex_);
+            auto it = strings_.find(str);
+            if (it != strings_.end()) {
+                if (auto result = it->second.lock()) return result;
+            }
+        }
+
+        write_guard_t guard(mutex_);
+        auto it = strings_.find(str);
+        if (it != strings_.end()) {
+            auto result = it->second.lock();
+            if (!result) {
+                result = std::make_shared<const std::string>(str);
+                it->second = result;
+            }
+            return result;
+        }
+
+        auto result = std::make_shared<const std::string>(str);
+        if (strings_.size() >= capacity_ && misses_++ >= reclaim_after_) {
+            misses_ = 0;
+            reclaim_after_ = (reclaim() < capacity_ / 4) ? capacity_ / 4 : 0;
+        }
+        if (strings_.size() < capacity_) strings_.emplace(str, result);
+        return result;
+    }
+
+    /** Number of interned strings (some of them may be already released) */
+    std::size_t size() const {
+        read_guard_t guard(mutex_);
+        return strings_.size();
+    }
+};
+
+/**
+ * Interners for the events of a store (released with the store and its events).
+ */
+struct EventInterners {
+    StringInterner tokens{}; // states, methods and provision identifiers
+    StringInterner uris{};
+
+    /** Interners for events loaded out of a store */
+    static EventInterners &shared() {
+        static EventInterners *result = new EventInterners();
+        return *result;
+    }
+};
+
+/**
+ * String shared through an interner.
+ */
+class InternedString {
+
+    std::shared_ptr<const std::string> str_{};
+
+public:
+    InternedString() {}
+
+    /**
+     * Assigns the value
+     *
+     * @param str Value to assign
+     * @param interner Interner where the value is shared
+     */
+    void assign(const std::string &str, StringInterner &interner) {
+        if (str.empty()) str_.reset();
+        else str_ = interner.intern(str);
+    }
+
+    /** Value */
+    const std::string &str() const {
+        static const std::string empty{};
+        return str_ ? *str_ : empty;
+    }
+
+    /** Empty value */
+    bool empty() const {
+        return !str_;
+    }
+};
+
+/**
+ * Header map flattened in a single buffer ('<name>\0<sensitive><value>\0' per header).
+ *
+ * The 'header_map' representation is only built if it is requested.
+ */
+class CompactHeaders {
+
+    std::string block_{};
+    mutable std::unique_ptr<nghttp2::asio_http2::header_map> map_{};
+    mutable std::once_flag map_once_{};
+
+public:
+    CompactHeaders() {}
+
+    /** Stores the headers (to be called once, before any read access) */
+    void assign(const nghttp2::asio_http2::header_map &headers) {
+        std::size_t size = 0;
+        for (const auto &it : headers) size += it.first.size() + it.second.value.size() + 3;
+        block_.reserve(size);
+        for (const auto &it : headers) {
+            block_.append(it.first);
+            block_.push_back('\0');
+            block_.push_back(it.second.sensitive ? '1' : '0');
+            block_.append(it.second.value);
+            block_.push_back('\0');
+        }
+    }
+
+    /** There are no headers */
+    bool empty() const {
+        return block_.empty();
+    }
+
+    /** Buffer size in bytes */
+    std::size_t bytes() const {
+        return block_.capacity();
+    }
+
+    /**
+     * Iterates the headers in map order
+     *
+     * @param func Callable invoked with name, value and sensitive indicator
+     */
+    template<typename Func>
+    void forEach(Func func) const {
+        const char *p = block_.data();
+        const char *end = p + block_.size();
+        while (p < end) {
+            std::size_t nameSize = std::strlen(p);
+            const char *name = p;
+            p += nameSize + 1;
+            bool sensitive = (*p++ == '1');
+            std::size_t valueSize = std::strlen(p);
+            func(std::string(name, nameSize), std::string(p, valueSize), sensitive);
+            p += valueSize + 1;
+        }
+    }
+
+    /** Header map representation (built on first access) */
+    const nghttp2::asio_http2::header_map &map() const {
+        std::call_once(map_once_, [this]() {
+            map_ = std::make_unique<nghttp2::asio_http2::header_map>();
+            forEach([this](std::string &&name, std::string &&value, bool sensitive) {
+                map_->emplace(std::move(name), nghttp2::asio_http2::header_value{std::move(value), sensitive});
+            });
+        });
+        return *map_;
+    }
+};
+
+}
+}
+
@@ -60,6 +60,12 @@ void FileManager::enableMetrics(ert::metrics::Metrics *metrics, const std::strin
         observed_delayed_close_operation_counter_ = &(cf.Add({{"operation", "delayedClose"}}));
         observed_instant_close_operation_counter_ = &(cf.Add({{"operation", "instantClose"}}));
         observed_error_open_operation_counter_ = &(cf.Add({{"result", "failed"}, {"operation", "open"}}));
+
+        ert::metrics::gauge_family_t& gf = metrics->addGaugeFamily("h2agent_file_manager_writer_gauge", "Background writer status in h2agent_file_manager", familyLabels);
+        observed_writer_queue_depth_gauge_ = &(gf.Add({{"measure", "queueDepth"}}));
+        observed_writer_latency_gauge_ = &(gf.Add({{"measure", "writeLatencySeconds"}}));
+
+        observed_writer_file_queue_depth_family_ = &(metrics->addGaugeFamily("h2agent_file_manager_writer_file_queue_depth_gauge", "Background writer queue depth per file in h2agent_file_manager", familyLabels));
     }
 }
 
@@ -71,8 +77,8 @@ void FileManager::incrementObservedCloseOperationCounter() {
     if (metrics_) observed_close_operation_counter_->Increment();
 }
 
-void FileManager::incrementObservedWriteOperationCounter() {
-    if (metrics_) observed_write_operation_counter_->Increment();
+void FileManager::incrementObservedWriteOperationCounter(std::size_t amount) {
+    if (metrics_) observed_write_operation_counter_->Increment(amount);
 }
 
 void FileManager::incrementObservedEmptyOperationCounter() {
@@ -91,6 +97,29 @@ void FileManager::incrementObservedErrorOpenOperationCounter() {
     if (metrics_) observed_error_open_operation_counter_->Increment();
 }
 
+void FileManager::setObservedWriterQueueDepth(std::size_t depth) {
+    if (metrics_) observed_writer_queue_depth_gauge_->Set(depth);
+}
+
+void FileManager::setObservedWriterFileQueueDepth(const std::string &path, std::size_t depth) {
+    if (!metrics_) return;
+
+    auto it = observed_writer_file_queue_depth_gauges_.find(path);
+    if (it == observed_writer_file_queue_depth_gauges_.end()) {
+        it = observed_writer_file_queue_depth_gauges_.emplace(path, &(observed_writer_file_queue_depth_family_->Add({{"path", path}}))).first;
+    }
+    it->second->Set(depth);
+}
+
+void FileManager::setObservedWriterLatency(std::uint64_t latencyUs) {
+    if (metrics_) observed_writer_latency_gauge_->Set(latencyUs / 1000000.0);
+}
+
+void FileManager::enableBackgroundWriter(unsigned int flushIntervalUs, bool sync) {
+    writer_.reset(); // pending writes of a former writer are flushed
+    writer_ = std::make_unique<FileWriter>(this, flushIntervalUs, sync);
+}
+
 void FileManager::write(const std::string &path, const std::string &data, bool textOrBinary, unsigned int closeDelayUs) {
 
     std::shared_ptr<SafeFile> safeFile;
@@ -108,6 +137,11 @@ void FileManager::write(const std::string &path, const std::string &data, bool t
         add(path, safeFile);
     }
 
+    if (writer_) {
+        writer_->append(safeFile, data, closeDelayUs);
+        return;
+    }
+
     safeFile->write(data, closeDelayUs);
 }
 
@@ -117,6 +151,7 @@ bool FileManager::read(const std::string &path, std::string &data, bool textOrBi
 
     std::shared_ptr<SafeFile> safeFile;
     std::ios_base::openmode mode = std::ifstream::in; // for text files
+    if (!textOrBinary) mode |= std::ios::binary;
 
     bool exists{};
     auto value = get(path, exists);
@@ -124,12 +159,11 @@ bool FileManager::read(const std::string &path, std::string &data, bool textOrBi
         safeFile = value;
     }
     else {
-        if (!textOrBinary) mode |= std::ios::binary;
-
         safeFile = std::make_shared<SafeFile>(this, path, io_context_, mode);
         add(path, safeFile);
     }
 
+    if (writer_ && safeFile->queuedWrites() != 0) writer_->sync();
     data = safeFile->read(result, mode, read_cache_);
 
     return result;
@@ -149,6 +183,7 @@ void FileManager::empty(const std::string &path) {
         add(path, safeFile);
     }
 
+    if (writer_ && safeFile->queuedWrites() != 0) writer_->sync();
     safeFile->empty();
 }
 
@@ -156,6 +191,10 @@ nlohmann::json FileManager::getConfigurationJson() const {
 
     nlohmann::json result;
     result["readCache"] = read_cache_ ? "enabled":"disabled";
+    if (writer_) {
+        result["backgroundWriter"]["flushIntervalUsecs"] = writer_->getFlushIntervalUs();
+        result["backgroundWriter"]["fsync"] = writer_->getSync() ? "enabled":"disabled";
+    }
 
     return result;
 } // LCOV_EXCL_LINE
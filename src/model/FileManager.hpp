@@ -39,8 +39,13 @@ SOFTWARE.
 
 #include <ert/metrics/Metrics.hpp>
 
+#include <memory>
+#include <string>
+#include <unordered_map>
+
 #include <Map.hpp>
 #include <SafeFile.hpp>
+#include <FileWriter.hpp>
 
 
 namespace ert
@@ -59,7 +64,7 @@ namespace model
 /**
  * This class stores a list of safe files.
  */
-class FileManager : public Map<std::string, std::shared_ptr<SafeFile>>
+class FileManager : public Map<std::string, std::shared_ptr<SafeFile>, TrafficMapStripes>
 {
     boost::asio::io_context *io_context_{};
 
@@ -73,9 +78,15 @@ class FileManager : public Map<std::string, std::shared_ptr<SafeFile>>
     ert::metrics::counter_t *observed_delayed_close_operation_counter_{};
     ert::metrics::counter_t *observed_instant_close_operation_counter_{};
     ert::metrics::counter_t *observed_error_open_operation_counter_{};
+    ert::metrics::gauge_t *observed_writer_queue_depth_gauge_{};
+    ert::metrics::gauge_t *observed_writer_latency_gauge_{};
+    ert::metrics::gauge_family_t *observed_writer_file_queue_depth_family_{};
+    std::unordered_map<std::string, ert::metrics::gauge_t*> observed_writer_file_queue_depth_gauges_{}; // writer thread only
 
     bool read_cache_;
 
+    std::unique_ptr<FileWriter> writer_{}; // last member: destroyed (pending writes flushed) before the rest
+
 public:
     using KeyType = std::string;
     using ValueType = std::shared_ptr<SafeFile>;
@@ -111,7 +122,7 @@ public:
     void incrementObservedEmptyOperationCounter();
 
     /** incrementObservedWriteOperationCounter */
-    void incrementObservedWriteOperationCounter();
+    void incrementObservedWriteOperationCounter(std::size_t amount = 1);
 
     /** incrementObservedDelayedCloseOperationCounter */
     void incrementObservedDelayedCloseOperationCounter();
@@ -122,6 +133,31 @@ public:
     /** incrementObservedErrorOpenOperationCounter */
     void incrementObservedErrorOpenOperationCounter();
 
+    /** setObservedWriterQueueDepth */
+    void setObservedWriterQueueDepth(std::size_t depth);
+
+    /**
+    * Sets the queue depth gauge for a file (called from the writer thread)
+    *
+    * @param path file path
+    * @param depth appends collected for the file
+    */
+    void setObservedWriterFileQueueDepth(const std::string &path, std::size_t depth);
+
+    /** setObservedWriterLatency */
+    void setObservedWriterLatency(std::uint64_t latencyUs);
+
+    /**
+    * Enables the background writer: writes are queued and appended by a dedicated
+    * thread, grouped per file (@see FileWriter). Reads and empty operations wait
+    * for the pending writes of the file: the group commit window is cut short, but
+    * the calling thread still waits for those writes (and the storage flush, if enabled).
+    *
+    * @param flushIntervalUs group commit window in microseconds (zero: write as soon as possible).
+    * @param sync flush written data to the storage device after each group write (fdatasync).
+    */
+    void enableBackgroundWriter(unsigned int flushIntervalUs, bool sync);
+
     /**
      * Write file
      *
@@ -136,7 +172,8 @@ public:
 
     /**
     * Read the file content.
-    * There is no close delay. Read transaction is atomic (open, read, close).
+    * There is no close delay. Read transaction is atomic (open, read, close), unless
+    * the read cache is enabled (text content has line feeds removed).
     *
     * @param path path file to read. Can be relative (to execution directory) or absolute.
     * @param data data read by reference.
@@ -147,7 +184,9 @@ public:
     bool read(const std::string &path, std::string &data, bool textOrBinary);
 
     /**
-    * Enables read cache to speed up content load
+    * Enables read cache to speed up content load.
+    * Content of regular files is kept and served while the files are not modified
+    * (checked by file status on every read), so there is no open/read per request.
     *
     * @param enable Boolean to enable or disable cache. File manager disables cache by default.
     */
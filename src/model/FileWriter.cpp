@@ -0,0 +1,228 @@
+/*
+ ___________________________________________
+|    _     ___                        _     |
+|   | |   |__ \                      | |    |
+|   | |__    ) |__ _  __ _  ___ _ __ | |_   |
+|   | '_ \  / // _` |/ _` |/ _ \ '_ \| __|  |  HTTP/2 AGENT FOR MOCK TESTING
+|   | | | |/ /| (_| | (_| |  __/ | | | |_   |  Version 0.0.z
+|   |_| |_|____\__,_|\__, |\___|_| |_|\__|  |  https://github.com/testillano/h2agent
+|                     __/ |                 |
+|                    |___/                  |
+|___________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <vector>
+
+#include <unistd.h> // sysconf
+
+#include <ert/tracing/Logger.hpp>
+
+#include <FileWriter.hpp>
+#include <FileManager.hpp>
+#include <SafeFile.hpp>
+
+
+namespace h2agent
+{
+namespace model
+{
+
+FileWriter::FileWriter(FileManager *fileManager, unsigned int flushIntervalUs, bool sync):
+    file_manager_(fileManager),
+    flush_interval_(flushIntervalUs),
+    sync_(sync)
+{
+    long openMax = sysconf(_SC_OPEN_MAX);
+    // Half of the process descriptors at most, leaving the rest for sockets and other files:
+    max_opened_files_ = std::min(MaxOpenedFiles, (openMax > 2) ? static_cast<std::size_t>(openMax / 2) : std::size_t(1));
+
+    thread_ = std::thread([this] { run(); });
+}
+
+FileWriter::~FileWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    wake_cv_.notify_one();
+    thread_.join();
+}
+
+void FileWriter::append(const std::shared_ptr<SafeFile> &file, std::string data, unsigned int closeDelayUs) {
+
+    file->queuedWrite();
+    enqueued_++;
+    queue_.push(Append{file, std::move(data), closeDelayUs, std::chrono::steady_clock::now()});
+
+    // The writer raises its idle flag before checking the queue (see MpscQueue::empty()):
+    if (idle_) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wake_cv_.notify_one();
+    }
+}
+
+void FileWriter::sync() {
+    std::uint64_t target = enqueued_;
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (written_ >= target) return;
+
+    // Group commit window is cut short, so the caller only waits for the write itself:
+    flush_requested_ = true;
+    wake_cv_.notify_one();
+    written_cv_.wait(lock, [&] { return written_ >= target || !running_; });
+}
+
+void FileWriter::run() {
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        idle_ = true;
+        auto ready = [this] { return !running_ || !queue_.empty(); };
+        if (opened_.empty()) {
+            wake_cv_.wait(lock, ready);
+        }
+        else {
+            auto nextDeadline = std::min_element(opened_.begin(), opened_.end(), [](const OpenedFile &a, const OpenedFile &b) {
+                return a.closeDeadline < b.closeDeadline;
+            })->closeDeadline;
+            wake_cv_.wait_until(lock, nextDeadline, ready);
+        }
+        idle_ = false;
+        bool stopping = !running_;
+
+        // Group commit window (skipped on stop, and cut short by sync()):
+        if (!stopping && flush_interval_.count() != 0 && !queue_.empty()) {
+            wake_cv_.wait_for(lock, flush_interval_, [this] { return flush_requested_ || !running_; });
+        }
+        flush_requested_ = false;
+        lock.unlock();
+
+        std::size_t written = writeQueued();
+        closeExpired(std::chrono::steady_clock::now());
+
+        lock.lock();
+        written_ += written;
+        written_cv_.notify_all();
+        if (stopping && queue_.empty()) break;
+    }
+    lock.unlock();
+
+    // Close remaining files:
+    while (!opened_.empty()) close(opened_.back().file.get());
+}
+
+std::size_t FileWriter::writeQueued() {
+
+    struct Group {
+        std::shared_ptr<SafeFile> file;
+        std::vector<std::string> chunks;
+        unsigned int closeDelayUs{};
+        std::chrono::steady_clock::time_point enqueued{}; // oldest append
+    };
+
+    // Group appends per file, keeping the order of files and appends:
+    std::vector<Group> groups;
+    std::unordered_map<SafeFile*, std::size_t> groupIndex;
+    std::size_t count = 0;
+    Append append;
+    while (queue_.pop(append)) {
+        count++;
+        auto it = groupIndex.find(append.file.get());
+        if (it == groupIndex.end()) {
+            it = groupIndex.emplace(append.file.get(), groups.size()).first;
+            groups.push_back(Group{append.file, {}, 0, append.enqueued});
+        }
+        Group &group = groups[it->second];
+        group.chunks.push_back(std::move(append.data));
+        group.closeDelayUs = append.closeDelayUs; // last write decides
+        append.file.reset();
+    }
+    if (count == 0) return 0;
+
+    // Depth is sampled when collected (every queued append is drained just below):
+    file_manager_->setObservedWriterQueueDepth(count);
+
+    for (auto &group: groups) {
+        SafeFile *file = group.file.get();
+        file_manager_->setObservedWriterFileQueueDepth(file->getPath(), group.chunks.size());
+
+        // Make room for a new descriptor (least recently written are closed):
+        if (opened_index_.find(file) == opened_index_.end()) {
+            while (opened_.size() >= max_opened_files_) close(opened_.back().file.get());
+        }
+
+        file->appendGroup(group.chunks, sync_, group.enqueued);
+
+        if (group.closeDelayUs != 0) {
+            keepOpened(group.file, std::chrono::steady_clock::now() + std::chrono::microseconds(group.closeDelayUs));
+        }
+        else {
+            close(file);
+            // metrics
+            file_manager_->incrementObservedInstantCloseOperationCounter();
+        }
+
+        // Readers waiting for pending writes (@see FileManager::read) see them written and closed:
+        file->writtenQueued(group.chunks.size());
+    }
+
+    return count;
+}
+
+void FileWriter::keepOpened(const std::shared_ptr<SafeFile> &file, std::chrono::steady_clock::time_point closeDeadline) {
+    auto it = opened_index_.find(file.get());
+    if (it != opened_index_.end()) {
+        it->second->closeDeadline = closeDeadline;
+        opened_.splice(opened_.begin(), opened_, it->second);
+        return;
+    }
+
+    // metrics
+    file_manager_->incrementObservedDelayedCloseOperationCounter();
+
+    opened_.push_front(OpenedFile{file, closeDeadline});
+    opened_index_.emplace(file.get(), opened_.begin());
+}
+
+void FileWriter::close(SafeFile *file) {
+    file->closeDescriptor();
+
+    auto it = opened_index_.find(file);
+    if (it == opened_index_.end()) return;
+    opened_.erase(it->second);
+    opened_index_.erase(it);
+}
+
+void FileWriter::closeExpired(std::chrono::steady_clock::time_point now) {
+    std::vector<SafeFile*> expired;
+    for (const auto &entry: opened_) {
+        if (entry.closeDeadline <= now) expired.push_back(entry.file.get());
+    }
+    for (auto file: expired) close(file);
+}
+
+}
+}
@@ -0,0 +1,168 @@
+/*
+ ___________________________________________
+|    _     ___                        _     |
+|   | |   |__ \                      | |    |
+|   | |__    ) |__ _  __ _  ___ _ __ | |_   |
+|   | '_ \  / // _` |/ _` |/ _ \ '_ \| __|  |  HTTP/2 AGENT FOR MOCK TESTING
+|   | | | |/ /| (_| | (_| |  __/ | | | |_   |  Version 0.0.z
+|   |_| |_|____\__,_|\__, |\___|_| |_|\__|  |  https://github.com/testillano/h2agent
+|                     __/ |                 |
+|                    |___/                  |
+|___________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include <MpscQueue.hpp>
+
+
+namespace h2agent
+{
+namespace model
+{
+class FileManager;
+class SafeFile;
+
+/**
+ * Background writer for file targets (group commit).
+ *
+ * Traffic threads only queue their appends (lock-free). The writer thread collects
+ * every queued append, groups them per file and writes each group with a single
+ * gathering write on a descriptor opened for append. Written files are kept open
+ * in a least recently used list until their close delay expires, or until room is
+ * needed for other files, so the traffic path never waits for the opened files limit.
+ *
+ * Queue depth is metered when the writer collects the queue, globally and per file
+ * (appends gathered by each group write).
+ */
+class FileWriter {
+
+    struct Append {
+        std::shared_ptr<SafeFile> file;
+        std::string data;
+        unsigned int closeDelayUs{};
+        std::chrono::steady_clock::time_point enqueued{};
+    };
+
+    struct OpenedFile {
+        std::shared_ptr<SafeFile> file;
+        std::chrono::steady_clock::time_point closeDeadline{};
+    };
+
+    FileManager *file_manager_{};
+    std::chrono::microseconds flush_interval_{};
+    bool sync_{};
+    std::size_t max_opened_files_{};
+
+    MpscQueue<Append> queue_;
+    std::atomic<std::uint64_t> enqueued_{0};
+    std::uint64_t written_{0}; // guarded by mutex_
+
+    std::mutex mutex_;
+    std::condition_variable wake_cv_; // writer thread
+    std::condition_variable written_cv_; // sync() callers
+    std::atomic<bool> idle_{false};
+    bool running_{true}; // guarded by mutex_
+    bool flush_requested_{false}; // guarded by mutex_
+    std::thread thread_;
+
+    // Writer thread only:
+    std::list<OpenedFile> opened_; // most recently written first
+    std::unordered_map<SafeFile*, std::list<OpenedFile>::iterator> opened_index_;
+
+    void run();
+    std::size_t writeQueued();
+    void keepOpened(const std::shared_ptr<SafeFile> &file, std::chrono::steady_clock::time_point closeDeadline);
+    void close(SafeFile *file);
+    void closeExpired(std::chrono::steady_clock::time_point now);
+
+public:
+    // Upper bound for descriptors kept open by the writer:
+    static constexpr std::size_t MaxOpenedFiles = 512;
+
+    /**
+    * Constructor (starts the writer thread)
+    *
+    * @param fileManager parent reference to file manager (metrics).
+    * @param flushIntervalUs group commit window: once woken, the writer waits this time to
+    * collect more appends before writing. Zero writes as soon as the writer is woken.
+    * @param sync flush written data to the storage device after each group write (fdatasync).
+    */
+    FileWriter(FileManager *fileManager, unsigned int flushIntervalUs, bool sync);
+
+    /**
+    * Destructor: writes pending appends, closes files and stops the writer thread
+    */
+    ~FileWriter();
+
+    FileWriter(const FileWriter&) = delete;
+    FileWriter& operator=(const FileWriter&) = delete;
+
+    /**
+    * Queues data to be appended to the file
+    *
+    * @param file safe file to write.
+    * @param data data to append.
+    * @param closeDelayUs delay after last write, to close the file. Zero closes the file
+    * just after the group write including this data.
+    */
+    void append(const std::shared_ptr<SafeFile> &file, std::string data, unsigned int closeDelayUs);
+
+    /**
+    * Waits until every append queued before this call is written.
+    * The group commit window in progress is cut short, so the wait is limited to the
+    * pending write operations (plus the storage flush, when enabled).
+    */
+    void sync();
+
+    /** Appends queued and not yet written (approximate) */
+    std::size_t queueDepth() const {
+        return queue_.size();
+    }
+
+    /** Group commit window in microseconds */
+    unsigned int getFlushIntervalUs() const {
+        return static_cast<unsigned int>(flush_interval_.count());
+    }
+
+    /** Flush to storage device after each group write */
+    bool getSync() const {
+        return sync_;
+    }
+};
+
+}
+}
+
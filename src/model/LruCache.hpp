@@ -0,0 +1,174 @@
+/*
+ ___________________________________________
+|    _     ___                        _     |
+|   | |   |__ \                      | |    |
+|   | |__    ) |__ _  __ _  ___ _ __ | |_   |
+|   | '_ \  / // _` |/ _` |/ _ \ '_ \| __|  |  HTTP/2 AGENT FOR MOCK TESTING
+|   | | | |/ /| (_| | (_| |  __/ | | | |_   |  Version 0.0.z
+|   |_| |_|____\__,_|\__, |\___|_| |_|\__|  |  https://github.com/testillano/h2agent
+|                     __/ |                 |
+|                    |___/                  |
+|___________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+
+namespace h2agent
+{
+namespace model
+{
+
+/**
+ * Bounded thread-safe cache with least recently used eviction.
+ *
+ * Keys are distributed by hash among independent stripes, each one with its own lock
+ * (placed on its own cache line), recency list and index, so concurrent accesses to
+ * different keys don't contend. Eviction is done per stripe, which approximates a global
+ * LRU policy for well distributed keys. Hits and misses are accounted for monitoring.
+ *
+ * @tparam Key The type of the cache key (hashable).
+ * @tparam Value The type of the cached value (copyable).
+ * @tparam Stripes Number of lock stripes.
+ */
+template<typename Key, typename Value, std::size_t Stripes = 16>
+class LruCache {
+
+    static_assert(Stripes > 0, "LruCache needs at least one stripe");
+
+    using list_t = std::list<std::pair<Key, Value>>; // most recently used first
+
+    struct alignas(64) Stripe {
+        std::mutex mutex_{};
+        list_t items_{};
+        std::unordered_map<Key, typename list_t::iterator> index_{};
+    };
+
+    std::array<Stripe, Stripes> stripes_{};
+    std::size_t stripe_capacity_;
+    std::atomic<std::uint64_t> hits_{};
+    std::atomic<std::uint64_t> misses_{};
+
+    Stripe &stripe(const Key& key) {
+        if constexpr (Stripes == 1) return stripes_[0];
+        else return stripes_[std::hash<Key>{}(key) % Stripes];
+    }
+
+public:
+    /**
+     * Constructor
+     *
+     * @param capacity Maximum number of entries (rounded up to a multiple of the stripes)
+     */
+    explicit LruCache(std::size_t capacity) : stripe_capacity_((capacity + Stripes - 1) / Stripes) {
+        if (stripe_capacity_ == 0) stripe_capacity_ = 1;
+    }
+
+    LruCache(const LruCache&) = delete;
+    LruCache& operator=(const LruCache&) = delete;
+
+    /**
+     * Gets a cached value, which becomes the most recently used
+     *
+     * @param key key to find
+     * @param value written by reference when found
+     *
+     * @return Boolean about key existence (hit)
+     */
+    bool get(const Key& key, Value &value) {
+        Stripe &s = stripe(key);
+        std::lock_guard<std::mutex> guard(s.mutex_);
+        auto it = s.index_.find(key);
+        if (it == s.index_.end()) {
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        s.items_.splice(s.items_.begin(), s.items_, it->second);
+        value = it->second->second;
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * Adds or updates a value as the most recently used, evicting the least recently
+     * used entry of its stripe when full
+     *
+     * @param key key to add
+     * @param value value stored
+     */
+    void put(const Key& key, Value value) {
+        Stripe &s = stripe(key);
+        std::lock_guard<std::mutex> guard(s.mutex_);
+        auto it = s.index_.find(key);
+        if (it != s.index_.end()) {
+            it->second->second = std::move(value);
+            s.items_.splice(s.items_.begin(), s.items_, it->second);
+            return;
+        }
+        if (s.items_.size() >= stripe_capacity_) {
+            s.index_.erase(s.items_.back().first);
+            s.items_.pop_back();
+        }
+        s.items_.emplace_front(key, std::move(value));
+        s.index_.emplace(key, s.items_.begin());
+    }
+
+    /** Maximum number of entries */
+    std::size_t capacity() const {
+        return stripe_capacity_ * Stripes;
+    }
+
+    /** Current number of entries (locks every stripe) */
+    std::size_t size() {
+        std::size_t result = 0;
+        for (auto &s : stripes_) {
+            std::lock_guard<std::mutex> guard(s.mutex_);
+            result += s.items_.size();
+        }
+        return result;
+    }
+
+    /** Number of successful lookups */
+    std::uint64_t hits() const {
+        return hits_.load(std::memory_order_relaxed);
+    }
+
+    /** Number of failed lookups */
+    std::uint64_t misses() const {
+        return misses_.load(std::memory_order_relaxed);
+    }
+};
+
+}
+}
@@ -43,8 +43,14 @@ SOFTWARE.
 //  (O(log2(n)) for map as binary tree, O(1) constant as average (O(n) in worst case)
 //  for unordered map as hash table), so for our case, unordered_map seems to be the best choice.
 #include <unordered_map>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <type_traits>
 
 #include <common.hpp>
+#include <keys.hpp>
 
 #include <nlohmann/json.hpp>
 
@@ -54,19 +60,73 @@ namespace h2agent
 namespace model
 {
 
-template<typename Key, typename Value>
+// Stripes used by registries which are accessed from every traffic thread (vault, events data):
+static constexpr std::size_t TrafficMapStripes = 16;
+
+/**
+ * Thread-safe map.
+ *
+ * By default (one stripe) there is a single read/write lock over the whole container.
+ * With several stripes, keys are distributed by hash among independent maps, each one with
+ * its own lock (placed on its own cache line), so concurrent accesses to different keys
+ * don't contend. Whole-container operations (forEach, getJson, size, clear, bulk add) lock
+ * every stripe, always in the same order, so they observe/modify a consistent state.
+ *
+ * @tparam Key The type of the map's key.
+ * @tparam Value The type of the map's value.
+ * @tparam Stripes Number of lock stripes (1 for the classic single-lock map).
+ */
+template<typename Key, typename Value, std::size_t Stripes = 1>
 class Map {
 
+    static_assert(Stripes > 0, "Map needs at least one stripe");
+
     typedef typename std::unordered_map<Key, Value> map_t;
     using IterationCallback = std::function<void(const Key&, const Value&)>;
 
-    mutable mutex_t mutex_{};
-    map_t map_{};
+    struct alignas(64) Stripe {
+        mutable mutex_t mutex_{};
+        map_t map_{};
+    };
+
+    std::array<Stripe, Stripes> stripes_{};
+    std::atomic<size_t> size_{}; // updated under stripe write lock (cheap size()/empty() without locking every stripe)
+
+    Stripe &stripe(const Key& key) {
+        if constexpr (Stripes == 1) return stripes_[0];
+        else return stripes_[std::hash<Key>{}(key) % Stripes];
+    }
+
+    const Stripe &stripe(const Key& key) const {
+        if constexpr (Stripes == 1) return stripes_[0];
+        else return stripes_[std::hash<Key>{}(key) % Stripes];
+    }
+
+    // Whole-container locks (stripes index order, to avoid deadlocks):
+    template<typename Guard>
+    std::array<Guard, Stripes> lockAll() const {
+        std::array<Guard, Stripes> result{};
+        for (std::size_t k = 0; k < Stripes; k++) result[k] = Guard(stripes_[k].mutex_);
+        return result;
+    }
+
+    // Aggregated key built over a thread buffer (capacity reused: no allocations in steady state):
+    static const Key &composed(const CompositeKeyView &key) {
+        static_assert(std::is_same<Key, std::string>::value, "Composite keys need aggregated string keys");
+        thread_local std::string buffer{};
+        key.compose(buffer);
+        return buffer;
+    }
 
 protected:
+    // whole container must be write-locked by caller
     bool clear_unsafe() noexcept {
-        bool result = (map_.size() != 0); // same !
-        map_.clear();
+        bool result = false;
+        for (auto &s : stripes_) {
+            result |= (s.map_.size() != 0); // same !
+            s.map_.clear();
+        }
+        size_ = 0;
         return result;
     }
 
@@ -75,10 +135,11 @@ public:
     Map() {};
 
     /** copy constructor */
-    Map(const Map& other) : map_{}
+    Map(const Map& other) : stripes_{}
     {
-        read_guard_t guard(other.mutex_);
-        this->map_ = other.map_;
+        auto guards = other.template lockAll<read_guard_t>();
+        for (std::size_t k = 0; k < Stripes; k++) this->stripes_[k].map_ = other.stripes_[k].map_;
+        this->size_ = other.size_.load();
     }
 
     ~Map() = default;
@@ -87,8 +148,9 @@ public:
 
     bool exists(const Key& key) const
     {
-        read_guard_t guard(mutex_);
-        return (map_.find(key) != map_.end());
+        const Stripe &s = stripe(key);
+        read_guard_t guard(s.mutex_);
+        return (s.map_.find(key) != s.map_.end());
     }
 
     /**
@@ -100,9 +162,10 @@ public:
      */
     Value get(const Key& key, bool &exists) const
     {
-        read_guard_t guard(mutex_);
-        auto it = map_.find(key);
-        exists = (it != map_.end());
+        const Stripe &s = stripe(key);
+        read_guard_t guard(s.mutex_);
+        auto it = s.map_.find(key);
+        exists = (it != s.map_.end());
         return (exists ? it->second : Value{}); // return copy
     }
 
@@ -110,15 +173,51 @@ public:
      * Getter which avoid copy of empty value and is more readable than get()
      */
     bool tryGet(const Key& key, Value& out_value) const {
-        read_guard_t guard(mutex_);
-        auto it = map_.find(key);
-        if (it != map_.end()) {
+        const Stripe &s = stripe(key);
+        read_guard_t guard(s.mutex_);
+        auto it = s.map_.find(key);
+        if (it != s.map_.end()) {
             out_value = it->second;
             return true;
         }
         return false;
     }
 
+    /**
+     * Reads a value in place (under read lock), avoiding the copy done by tryGet()
+     *
+     * @param key key to find
+     * @param reader function receiving a const reference to the value; keep it short
+     *
+     * @return Boolean about key existence (reader is only called when found)
+     */
+    template<typename Reader>
+    bool tryRead(const Key& key, Reader&& reader) const {
+        const Stripe &s = stripe(key);
+        read_guard_t guard(s.mutex_);
+        auto it = s.map_.find(key);
+        if (it == s.map_.end()) return false;
+        reader(it->second);
+        return true;
+    }
+
+    /**
+     * Composite key variants (only for maps indexed by aggregated string keys): searches
+     * don't build a new aggregated key, and updates only copy it when the key is inserted.
+     */
+    bool exists(const CompositeKeyView& key) const {
+        return exists(composed(key));
+    }
+
+    bool tryGet(const CompositeKeyView& key, Value& out_value) const {
+        return tryGet(composed(key), out_value);
+    }
+
+    template<typename Reader>
+    bool tryRead(const CompositeKeyView& key, Reader&& reader) const {
+        return tryRead(composed(key), std::forward<Reader>(reader));
+    }
+
     //// Lvalue
     //bool insert_if_not_exists(const Key& key, const Value& value) {
     //    write_guard_t guard(mutex_);
@@ -141,21 +240,19 @@ public:
     /** map size */
     size_t size() const
     {
-        read_guard_t guard(mutex_);
-        return map_.size();
+        return size_.load(std::memory_order_relaxed);
     }
 
     bool empty() const
     {
-        read_guard_t guard(mutex_);
-        return (map_.size() == 0);
+        return (size() == 0);
     }
 
     /**
      * @brief Iterates safely over all elements in the map.
      * * This method provides **read access** to the map's elements in a **thread-safe** manner
      * by applying a user-defined callback function to each key-value pair. The entire
-     * iteration is performed atomically and under a read lock.
+     * iteration is performed atomically and under a read lock (all the stripes are locked).
      *
      * @attention This method acquires a \c std::shared_lock (read lock) for its full duration.
      * To ensure high concurrency, avoid placing long-running operations (such as file I/O or
@@ -174,9 +271,11 @@ public:
      * (\c dangling iterators) to external threads.
      */
     void forEach(const IterationCallback& callback) const {
-        read_guard_t guard(mutex_);
-        for (const auto& pair : map_) {
-            callback(pair.first, pair.second);
+        auto guards = lockAll<read_guard_t>();
+        for (const auto &s : stripes_) {
+            for (const auto& pair : s.map_) {
+                callback(pair.first, pair.second);
+            }
         }
     }
 
@@ -184,8 +283,8 @@ public:
      * @brief Safely converts the internal map content into a JSON object.
      * * This method provides a thread-safe way to serialize the data stored in the
      * map by acquiring a read lock for the entire duration of the conversion.
-     * * @details The method acquires a \c std::shared_lock on the map's mutex. While
-     * the lock is held, the internal \c std::unordered_map is copied and cast
+     * * @details The method acquires a \c std::shared_lock on every stripe mutex. While
+     * the locks are held, the internal \c std::unordered_map's are copied and cast
      * into a \c nlohmann::json object. This ensures that the map cannot be
      * modified (added to or removed from) by writer threads during serialization.
      * * @tparam Key The type of the map's key.
@@ -199,9 +298,17 @@ public:
      * as a JSON object.
      */
     nlohmann::json getJson() const {
-        read_guard_t guard(mutex_);
-        nlohmann::json j(map_);
-        return j;  // return copy
+        auto guards = lockAll<read_guard_t>();
+        if constexpr (Stripes == 1) {
+            nlohmann::json j(stripes_[0].map_);
+            return j;  // return copy
+        }
+        else {
+            map_t all{};
+            for (const auto &s : stripes_) all.insert(s.map_.begin(), s.map_.end());
+            nlohmann::json j(all);
+            return j;  // return copy
+        }
     }
 
     // setters
@@ -214,14 +321,21 @@ public:
      * @param value stored
      */
     void add(const Key& key, const Value &value) {
-        write_guard_t guard(mutex_);
-        map_.insert_or_assign(key, value);
+        Stripe &s = stripe(key);
+        write_guard_t guard(s.mutex_);
+        if (s.map_.insert_or_assign(key, value).second) size_++;
     }
 
     // Rvalue variant (std::move)
     void add(const Key& key, Value&& value) {
-        write_guard_t guard(mutex_);
-        map_.insert_or_assign(key, std::move(value));
+        Stripe &s = stripe(key);
+        write_guard_t guard(s.mutex_);
+        if (s.map_.insert_or_assign(key, std::move(value)).second) size_++;
+    }
+
+    // Composite key variant
+    void add(const CompositeKeyView& key, Value&& value) {
+        add(composed(key), std::move(value));
     }
 
     /**
@@ -233,8 +347,39 @@ public:
      */
     template<typename Modifier>
     void modifyOrInsert(const Key& key, Modifier&& modifier) {
-        write_guard_t guard(mutex_);
-        modifier(map_[key]); // operator[] inserts default if missing
+        Stripe &s = stripe(key);
+        write_guard_t guard(s.mutex_);
+        auto result = s.map_.try_emplace(key); // inserts default if missing
+        if (result.second) size_++;
+        modifier(result.first->second);
+    }
+
+    /**
+     * Atomically reads, modifies and writes back a value under a single write lock, erasing
+     * the entry when the modifier returns false (missing keys are not left behind either).
+     * If the key doesn't exist, a default-constructed Value is passed to the modifier.
+     *
+     * @param key key to modify
+     * @param modifier function that receives a reference to the value and returns if it is kept
+     */
+    template<typename Modifier>
+    void modifyOrErase(const Key& key, Modifier&& modifier) {
+        Stripe &s = stripe(key);
+        write_guard_t guard(s.mutex_);
+        auto result = s.map_.try_emplace(key); // inserts default if missing
+        if (modifier(result.first->second)) {
+            if (result.second) size_++;
+        }
+        else {
+            if (!result.second) size_--;
+            s.map_.erase(result.first);
+        }
+    }
+
+    // Composite key variant
+    template<typename Modifier>
+    void modifyOrErase(const CompositeKeyView& key, Modifier&& modifier) {
+        modifyOrErase(composed(key), std::forward<Modifier>(modifier));
     }
 
     /**
@@ -244,9 +389,9 @@ public:
      */
     void add(const map_t& m)
     {
-        write_guard_t guard(mutex_);
+        auto guards = lockAll<write_guard_t>();
         for (const auto& kv : m)
-            map_.insert_or_assign(kv.first, kv.second);
+            if (stripe(kv.first).map_.insert_or_assign(kv.first, kv.second).second) size_++;
     }
 
     /**
@@ -256,16 +401,24 @@ public:
      */
     void remove(const Key& key, bool &exists)
     {
-        write_guard_t guard(mutex_);
-        exists = (map_.erase(key) > 0);
+        Stripe &s = stripe(key);
+        write_guard_t guard(s.mutex_);
+        exists = (s.map_.erase(key) > 0);
+        if (exists) size_--;
+    }
+
+    // Composite key variant
+    void remove(const CompositeKeyView& key, bool &exists)
+    {
+        remove(composed(key), exists);
     }
 
     /** Clear map */
     // return if something was deleted
     bool clear()
     {
-        write_guard_t guard(mutex_);
-        return clear_unsafe(); // don't call Map::size() to avoid mutex deadlocks (this one uses map_.size())
+        auto guards = lockAll<write_guard_t>();
+        return clear_unsafe(); // don't call Map::size() to avoid mutex deadlocks (this one uses stripes map_.size())
     }
 };
 
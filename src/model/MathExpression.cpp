@@ -0,0 +1,237 @@
+/*
+ ___________________________________________
+|    _     ___                        _     |
+|   | |   |__ \                      | |    |
+|   | |__    ) |__ _  __ _  ___ _ __ | |_   |
+|   | '_ \  / // _` |/ _` |/ _ \ '_ \| __|  |  HTTP/2 AGENT FOR MOCK TESTING
+|   | | | |/ /| (_| | (_| |  __/ | | | |_   |  Version 0.0.z
+|   |_| |_|____\__,_|\__, |\___|_| |_|\__|  |  https://github.com/testillano/h2agent
+|                     __/ |                 |
+|                    |___/                  |
+|___________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <cstdlib>
+#include <cmath>
+#include <cstring>
+#include <cctype>
+
+#include <nlohmann/json.hpp>
+#include <arashpartow/exprtk.hpp>
+
+#include <ert/tracing/Logger.hpp>
+
+#include <MathExpression.hpp>
+#include <TypeConverter.hpp>
+#include <Vault.hpp>
+
+
+typedef exprtk::symbol_table<double> symbol_table_t;
+typedef exprtk::expression<double>   expression_t;
+typedef exprtk::parser<double>       parser_t;
+
+namespace h2agent
+{
+namespace model
+{
+
+namespace
+{
+
+std::string symbolName(std::size_t index) {
+    return std::string("h2agent_var_") + std::to_string(index);
+}
+
+// Characters which may surround a variable pattern without changing the expression
+// meaning when the pattern becomes a symbol (i.e. "2@{x}" is "23" textually but 2*x for exprtk):
+bool isSafeBefore(char c) {
+    return (std::isspace(static_cast<unsigned char>(c)) || std::strchr("+-*/%^(,<>=!&|[{?:;", c));
+}
+
+bool isSafeAfter(char c) {
+    return (std::isspace(static_cast<unsigned char>(c)) || std::strchr("+-*/%^),<>=!&|]}?:;", c));
+}
+
+// Plain non-negative decimal number (textual substitution of negatives could change
+// precedence, i.e. "@{x}^2" with x=-3 is "-3^2"):
+bool parseNumber(const std::string &str, double &number) {
+    if (str.empty()) return false;
+    if (!std::isdigit(static_cast<unsigned char>(str[0])) && str[0] != '.') return false;
+    if (str.find_first_not_of("0123456789.eE+-") != std::string::npos) return false;
+
+    char *end = nullptr;
+    number = std::strtod(str.c_str(), &end);
+    return (end == str.c_str() + str.size());
+}
+
+}
+
+struct MathExpression::Instance
+{
+    std::vector<double> values{}; // symbol table references: never resized after creation
+    symbol_table_t symbol_table{};
+    expression_t expression{};
+};
+
+MathExpression::MathExpression() = default;
+MathExpression::~MathExpression() = default;
+
+std::unique_ptr<MathExpression::Instance> MathExpression::createInstance() const {
+
+    auto result = std::make_unique<Instance>();
+    result->values.assign(symbol_varnames_.size(), 0.0);
+    for (std::size_t k = 0; k < symbol_varnames_.size(); k++) {
+        result->symbol_table.add_variable(symbolName(k), result->values[k]);
+    }
+    result->expression.register_symbol_table(result->symbol_table);
+
+    parser_t parser;
+    if (!parser.compile(compiled_source_, result->expression)) return nullptr;
+
+    return result;
+}
+
+void MathExpression::load(const std::string &source, const std::map<std::string, std::string> &patterns) {
+
+    source_ = source;
+    patterns_ = patterns;
+    compiled_source_.clear();
+    symbol_varnames_.clear();
+    compiled_ = false;
+    pool_.clear();
+
+    // String literals could enclose patterns: keep textual replacement
+    bool safe = (source_.find('\'') == std::string::npos);
+
+    std::map<std::string, std::size_t> symbolIndexes; // varname -> symbol index
+    std::size_t pos = 0;
+    while (safe && pos < source_.size()) {
+        auto it = patterns_.end();
+        if (source_[pos] == '@') {
+            for (it = patterns_.begin(); it != patterns_.end(); it++) {
+                if (source_.compare(pos, it->first.size(), it->first) == 0) break;
+            }
+        }
+
+        if (it == patterns_.end()) {
+            compiled_source_ += source_[pos++];
+            continue;
+        }
+
+        std::size_t next = pos + it->first.size();
+        if ((pos > 0 && !isSafeBefore(source_[pos - 1])) || (next < source_.size() && !isSafeAfter(source_[next]))) {
+            safe = false;
+            break;
+        }
+
+        auto sit = symbolIndexes.find(it->second);
+        if (sit == symbolIndexes.end()) {
+            sit = symbolIndexes.emplace(it->second, symbol_varnames_.size()).first;
+            symbol_varnames_.push_back(it->second);
+        }
+        compiled_source_ += symbolName(sit->second);
+        pos = next;
+    }
+
+    if (safe) {
+        auto instance = createInstance();
+        if (instance) {
+            pool_.push_back(std::move(instance));
+            compiled_ = true;
+        }
+    }
+
+    LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("Math expression '%s' %s", source_.c_str(), compiled_ ? ("precompiled as '" + compiled_source_ + "'").c_str():"will be compiled on demand"), ERT_FILE_LOCATION));
+}
+
+bool MathExpression::resolveValues(const std::map<std::string, std::string> &variables, Vault *vault, std::vector<double> &values) const {
+
+    std::shared_ptr<const nlohmann::json> aux{};
+
+    for (std::size_t k = 0; k < symbol_varnames_.size(); k++) {
+        const std::string &varname = symbol_varnames_[k];
+
+        // local var has priority over a vault with the same name
+        auto it = variables.find(varname);
+        if (it != variables.end()) {
+            if (!parseNumber(it->second, values[k])) return false;
+            continue;
+        }
+
+        if (!vault->tryGet(varname, aux)) return false;
+        if (aux->is_number()) {
+            values[k] = aux->get<double>();
+            if (std::signbit(values[k])) return false;
+        }
+        else if (!aux->is_string() || !parseNumber(aux->get_ref<const std::string&>(), values[k])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+double MathExpression::evaluate(const std::map<std::string, std::string> &variables, Vault *vault) const {
+
+    if (compiled_) {
+        std::unique_ptr<Instance> instance;
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex_);
+            if (!pool_.empty()) {
+                instance = std::move(pool_.back());
+                pool_.pop_back();
+            }
+        }
+        if (!instance) instance = createInstance();
+
+        if (instance) {
+            bool resolved = resolveValues(variables, vault, instance->values);
+            double result = resolved ? instance->expression.value():0.0;
+
+            std::lock_guard<std::mutex> lock(pool_mutex_);
+            pool_.push_back(std::move(instance));
+            if (resolved) return result;
+        }
+
+        LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("Non-numeric substitution for math expression '%s': compiling on demand", source_.c_str()), ERT_FILE_LOCATION));
+    }
+
+    std::string expression = source_;
+    replaceVariables(expression, patterns_, variables, vault);
+    return compileAndEvaluate(expression);
+}
+
+double MathExpression::compileAndEvaluate(const std::string &expression) {
+
+    expression_t compiled;
+    parser_t parser;
+    parser.compile(expression, compiled);
+
+    return compiled.value();
+}
+
+}
+}
+
@@ -0,0 +1,121 @@
+/*
+ ___________________________________________
+|    _     ___                        _     |
+|   | |   |__ \                      | |    |
+|   | |__    ) |__ _  __ _  ___ _ __ | |_   |
+|   | '_ \  / // _` |/ _` |/ _ \ '_ \| __|  |  HTTP/2 AGENT FOR MOCK TESTING
+|   | | | |/ /| (_| | (_| |  __/ | | | |_   |  Version 0.0.z
+|   |_| |_|____\__,_|\__, |\___|_| |_|\__|  |  https://github.com/testillano/h2agent
+|                     __/ |                 |
+|                    |___/                  |
+|___________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+
+
+namespace h2agent
+{
+namespace model
+{
+
+class Vault;
+
+/**
+ * Math transformation source expression, compiled once.
+ *
+ * The '@{varname}' patterns are bound as exprtk symbol table variables which are
+ * updated on every evaluation, so the expensive exprtk compilation is done at
+ * load time instead of per request. When the expression cannot be safely compiled
+ * that way, or any substituted value is not a plain non-negative number, the
+ * evaluation falls back to textual variables replacement and on-demand compilation.
+ */
+class MathExpression
+{
+    struct Instance; // exprtk symbol table + compiled expression (kept out of this header)
+
+    std::string source_{};
+    std::map<std::string, std::string> patterns_{}; // pattern -> varname
+    std::string compiled_source_{}; // source with patterns replaced by exprtk symbols
+    std::vector<std::string> symbol_varnames_{}; // symbol index -> varname
+    bool compiled_{};
+
+    // Compiled instances are not thread-safe, so a pool is kept (grows up to concurrency level):
+    mutable std::mutex pool_mutex_{};
+    mutable std::vector<std::unique_ptr<Instance>> pool_{};
+
+    std::unique_ptr<Instance> createInstance() const;
+    bool resolveValues(const std::map<std::string, std::string> &variables, Vault *vault, std::vector<double> &values) const;
+
+public:
+    MathExpression();
+    ~MathExpression();
+
+    MathExpression(const MathExpression&) = delete;
+    MathExpression& operator=(const MathExpression&) = delete;
+
+    /**
+     * Loads math expression
+     *
+     * @param source Math expression, possibly including variable patterns
+     * @param patterns Map of patterns (pattern, varname) collected from source
+     */
+    void load(const std::string &source, const std::map<std::string, std::string> &patterns);
+
+    /**
+     * Evaluates math expression
+     *
+     * @param variables Transformation local variables, which have priority over vault entries
+     * @param vault Vault reference
+     *
+     * @return Expression result (NaN when expression is invalid)
+     */
+    double evaluate(const std::map<std::string, std::string> &variables, Vault *vault) const;
+
+    /**
+     * Evaluates math expression by mean textual compilation (no precompiled symbols)
+     *
+     * @param expression Math expression already resolved
+     *
+     * @return Expression result (NaN when expression is invalid)
+     */
+    static double compileAndEvaluate(const std::string &expression);
+
+    /** Gets precompilation indicator (false means that textual fallback is always used) */
+    bool isCompiled() const {
+        return compiled_;
+    }
+};
+
+}
+}
+
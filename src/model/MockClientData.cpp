@@ -49,10 +49,31 @@ namespace model
 
 void MockClientData::loadEvent(const DataKey &dataKey, const std::string &clientProvisionId, const std::string &previousState, const std::string &state, const std::chrono::microseconds &sendingTimestampUs, const std::chrono::microseconds &receptionTimestampUs, int responseStatusCode, const nghttp2::asio_http2::header_map &requestHeaders, const nghttp2::asio_http2::header_map &responseHeaders, const std::string &requestBody, DataPart &responseBodyDataPart, std::uint64_t sendSeq, std::int64_t sequence, unsigned int requestDelayMs, unsigned int timeoutMs, bool historyEnabled) {
 
+    // Event is built out of the stripe lock, which just links it into the key history:
+    auto event = std::allocate_shared<MockClientEvent>(SlabAllocator<MockClientEvent>()); // pooled: no heap fragmentation on long runs
+    event->load(clientProvisionId, previousState, state, sendingTimestampUs, receptionTimestampUs, responseStatusCode, requestHeaders, responseHeaders, requestBody, responseBodyDataPart, sendSeq, sequence, requestDelayMs, timeoutMs, &interners_);
+
+    std::size_t dropped{};
+    std::shared_ptr<MockEventsHistory> events;
+
     modifyOrInsert(dataKey.getKey(), [&](std::shared_ptr<MockEventsHistory> &entry) {
-        if (!entry) entry = std::make_shared<MockClientEventsHistory>(dataKey);
-        std::static_pointer_cast<MockClientEventsHistory>(entry)->loadEvent(clientProvisionId, previousState, state, sendingTimestampUs, receptionTimestampUs, responseStatusCode, requestHeaders, responseHeaders, requestBody, responseBodyDataPart, sendSeq, sequence, requestDelayMs, timeoutMs, historyEnabled);
+        if (!entry) entry = std::make_shared<MockClientEventsHistory>(dataKey, storage_bytes_);
+        events = entry;
+        dropped = entry->loadEvent(std::move(event), sendSeq, historyEnabled, getMaxEventsPerKey());
     });
+
+    retain(events, dropped);
+}
+
+void MockClientData::enableMetrics(ert::metrics::Metrics *metrics, const std::string &source) {
+
+    if (metrics) {
+        ert::metrics::labels_t familyLabels = {{"source", source}};
+
+        ert::metrics::counter_family_t& cf = metrics->addCounterFamily("h2agent_traffic_client_data_evictions_counter", "Client data retention evictions counter in h2agent_traffic_client", familyLabels);
+        evicted_events_counter_ = &(cf.Add({{"type", "event"}}));
+        evicted_keys_counter_ = &(cf.Add({{"type", "key"}}));
+    }
 }
 
 bool MockClientData::removeEventBySendSeq(const DataKey &dataKey, std::uint64_t sendSeq) {
@@ -100,13 +121,11 @@ std::string MockClientData::getSequence(std::uint64_t fromTimestampUs, std::uint
         if (!requestMethod.empty() && method != requestMethod) return;
         if (uriRegex && !std::regex_search(uri, *uriRegex)) return;
 
-        read_guard_t guard(history->getMutex());
-        for (const auto &ev : history->getEvents()) {
+        history->forEachEvent([&](const std::shared_ptr<MockEvent> &ev) {
             auto clientEv = std::static_pointer_cast<MockClientEvent>(ev);
-            const auto &json = clientEv->getJson();
-            std::uint64_t sendTs = json["sendingTimestampUs"].get<std::uint64_t>();
-            std::uint64_t recvTs = json.contains("receptionTimestampUs") ? json["receptionTimestampUs"].get<std::uint64_t>() : 0;
-            std::string provId = json.contains("clientProvisionId") ? json["clientProvisionId"].get<std::string>() : "";
+            std::uint64_t sendTs = clientEv->getSendingTimestampUs();
+            std::uint64_t recvTs = clientEv->getReceptionTimestampUs();
+            const std::string &provId = clientEv->getClientProvisionId();
 
             // Send entry:
             if ((!fromTimestampUs || sendTs >= fromTimestampUs) && (!toTimestampUs || sendTs <= toTimestampUs)) {
@@ -116,7 +135,7 @@ std::string MockClientData::getSequence(std::uint64_t fromTimestampUs, std::uint
             if (recvTs && (!fromTimestampUs || recvTs >= fromTimestampUs) && (!toTimestampUs || recvTs <= toTimestampUs)) {
                 entries.push_back({recvTs, "recv", method, uri, provId});
             }
-        }
+        });
     });
 
     std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
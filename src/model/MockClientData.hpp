@@ -66,6 +66,14 @@ public:
     MockClientData() {};
     ~MockClientData() = default;
 
+    /**
+     * Enables metrics for data retention
+     *
+     * @param metrics Optional metrics object to compute counters
+     * @param source Source label for prometheus metrics
+     */
+    void enableMetrics(ert::metrics::Metrics *metrics, const std::string &source);
+
     /**
      * Loads event data
      *
@@ -43,30 +43,37 @@ namespace h2agent
 namespace model
 {
 
-void MockClientEvent::load(const std::string &clientProvisionId, const std::string &previousState, const std::string &state, const std::chrono::microseconds &sendingTimestampUs, const std::chrono::microseconds &receptionTimestampUs, int responseStatusCode, const nghttp2::asio_http2::header_map &requestHeaders, const nghttp2::asio_http2::header_map &responseHeaders, const std::string &requestBody, DataPart &responseBodyDataPart, std::uint64_t sendSeq, std::int64_t sequence, unsigned int requestDelayMs, unsigned int timeoutMs) {
+void MockClientEvent::load(const std::string &clientProvisionId, const std::string &previousState, const std::string &state, const std::chrono::microseconds &sendingTimestampUs, const std::chrono::microseconds &receptionTimestampUs, int responseStatusCode, const nghttp2::asio_http2::header_map &requestHeaders, const nghttp2::asio_http2::header_map &responseHeaders, const std::string &requestBody, DataPart &responseBodyDataPart, std::uint64_t sendSeq, std::int64_t sequence, unsigned int requestDelayMs, unsigned int timeoutMs, EventInterners *interners) {
+
+    if (!interners) interners = &EventInterners::shared();
 
     // Base class:
-    MockEvent::load(previousState, state, receptionTimestampUs, responseStatusCode, requestHeaders, responseHeaders);
+    MockEvent::load(previousState, state, receptionTimestampUs, responseStatusCode, requestHeaders, responseHeaders, interners);
 
-    client_provision_id_ = clientProvisionId;
+    client_provision_id_.assign(clientProvisionId, interners->tokens);
     sending_timestamp_us_ = sendingTimestampUs.count();
-    request_body_data_part_.assign(std::move(requestBody));
-    request_body_data_part_.decode(requestHeaders);
-    responseBodyDataPart.decode(responseHeaders);
-    response_body_ = responseBodyDataPart.getJson();
+    request_body_data_part_.assign(requestBody);
+    response_body_data_part_.assign(responseBodyDataPart.str()); // raw copy: caller keeps its data part
     send_seq_ = sendSeq;
     sequence_ = sequence;
     request_delay_ms_ = requestDelayMs;
     timeout_ms_ = timeoutMs;
+}
+
+void MockClientEvent::buildJson() const {
+
+    // Base class:
+    MockEvent::buildJson();
 
-    // Update json_:
-    json_["clientProvisionId"] = client_provision_id_;
+    json_["clientProvisionId"] = client_provision_id_.str();
     json_["sendingTimestampUs"] = (std::uint64_t)sending_timestamp_us_;
     if (!request_body_data_part_.str().empty()) {
+        request_body_data_part_.decode(getRequestHeaders());
         json_["requestBody"] = request_body_data_part_.getJson();
     }
-    if (!response_body_.empty()) {
-        json_["responseBody"] = response_body_;
+    response_body_data_part_.decode(getResponseHeaders());
+    if (!response_body_data_part_.getJson().empty()) {
+        json_["responseBody"] = response_body_data_part_.getJson();
     }
     json_["sendseq"] = (std::uint64_t)send_seq_;
     json_["sequence"] = (std::int64_t)sequence_;
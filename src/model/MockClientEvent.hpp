@@ -47,15 +47,20 @@ namespace model
 
 class MockClientEvent : public MockEvent
 {
-    std::string client_provision_id_{};
+    InternedString client_provision_id_{};
     std::uint64_t sending_timestamp_us_{};
-    DataPart request_body_data_part_{};
-    nlohmann::json response_body_{};
+    // Bodies are stored raw, and decoded lazily (json mutex) when json view is required:
+    mutable DataPart request_body_data_part_{};
+    mutable DataPart response_body_data_part_{};
     std::uint64_t send_seq_{};
     std::int64_t sequence_{};
     unsigned int request_delay_ms_{};
     unsigned int timeout_ms_{};
 
+protected:
+
+    void buildJson() const override;
+
 public:
 
     MockClientEvent() {;}
@@ -80,8 +85,9 @@ public:
      * @param sequence test sequence (1..N)
      * @param requestDelayMs Request delay in milliseconds
      * @param timeoutMs Timeout in milliseconds
+     * @param interners Interners for repeated strings (store ones). Shared ones by default.
      */
-    void load(const std::string &clientProvisionId, const std::string &previousState, const std::string &state, const std::chrono::microseconds &sendingTimestampUs, const std::chrono::microseconds &receptionTimestampUs, int responseStatusCode, const nghttp2::asio_http2::header_map &requestHeaders, const nghttp2::asio_http2::header_map &responseHeaders, const std::string &requestBody, DataPart &responseBodyDataPart, std::uint64_t sendSeq, std::int64_t sequence, unsigned int requestDelayMs, unsigned int timeoutMs);
+    void load(const std::string &clientProvisionId, const std::string &previousState, const std::string &state, const std::chrono::microseconds &sendingTimestampUs, const std::chrono::microseconds &receptionTimestampUs, int responseStatusCode, const nghttp2::asio_http2::header_map &requestHeaders, const nghttp2::asio_http2::header_map &responseHeaders, const std::string &requestBody, DataPart &responseBodyDataPart, std::uint64_t sendSeq, std::int64_t sequence, unsigned int requestDelayMs, unsigned int timeoutMs, EventInterners *interners = nullptr);
 
     // getters:
 
@@ -93,12 +99,34 @@ public:
         return send_seq_;
     }
 
+    std::size_t storageBytes() const override {
+        return sizeof(MockClientEvent) + MockEvent::storageBytes() + request_body_data_part_.str().capacity() + response_body_data_part_.str().capacity();
+    }
+
     /** Response body
      *
      * @return Response body
      */
-    const nlohmann::json &getResponseBody() const {
-        return response_body_;
+    nlohmann::json getResponseBody() const {
+        std::lock_guard<std::mutex> guard(json_mutex_);
+        response_body_data_part_.decode(getResponseHeaders());
+        return response_body_data_part_.getJson();
+    }
+
+    /** Sending timestamp
+     *
+     * @return Microseconds sending timestamp
+     */
+    std::uint64_t getSendingTimestampUs() const {
+        return sending_timestamp_us_;
+    }
+
+    /** Client provision identifier
+     *
+     * @return Client provision identifier
+     */
+    const std::string &getClientProvisionId() const {
+        return client_provision_id_.str();
     }
 };
 
@@ -44,35 +44,20 @@ namespace h2agent
 namespace model
 {
 
-void MockClientEventsHistory::loadEvent(const std::string &clientProvisionId, const std::string &previousState, const std::string &state, const std::chrono::microseconds &sendingTimestampUs, const std::chrono::microseconds &receptionTimestampUs, int responseStatusCode, const nghttp2::asio_http2::header_map &requestHeaders, const nghttp2::asio_http2::header_map &responseHeaders, const std::string &requestBody, DataPart &responseBodyDataPart, std::uint64_t sendSeq, std::int64_t sequence, unsigned int requestDelayMs, unsigned int timeoutMs, bool historyEnabled) {
+std::size_t MockClientEventsHistory::loadEvent(const std::string &clientProvisionId, const std::string &previousState, const std::string &state, const std::chrono::microseconds &sendingTimestampUs, const std::chrono::microseconds &receptionTimestampUs, int responseStatusCode, const nghttp2::asio_http2::header_map &requestHeaders, const nghttp2::asio_http2::header_map &responseHeaders, const std::string &requestBody, DataPart &responseBodyDataPart, std::uint64_t sendSeq, std::int64_t sequence, unsigned int requestDelayMs, unsigned int timeoutMs, bool historyEnabled, std::size_t maxEvents) {
 
-    auto event = std::make_shared<MockClientEvent>();
+    auto event = std::allocate_shared<MockClientEvent>(SlabAllocator<MockClientEvent>()); // pooled: no heap fragmentation on long runs
     event->load(clientProvisionId, previousState, state, sendingTimestampUs, receptionTimestampUs, responseStatusCode, requestHeaders, responseHeaders, requestBody, responseBodyDataPart, sendSeq, sequence, requestDelayMs, timeoutMs);
 
-    MockEventsHistory::loadEvent(std::static_pointer_cast<MockEvent>(event), historyEnabled);
+    return MockEventsHistory::loadEvent(std::static_pointer_cast<MockEvent>(event), sendSeq, historyEnabled, maxEvents);
 }
 
 bool MockClientEventsHistory::removeEventBySendSeq(std::uint64_t sendSeq) {
-
-    write_guard_t guard(rw_mutex_);
-    for (auto it = events_.begin(); it != events_.end(); ++it) {
-        if (std::static_pointer_cast<MockClientEvent>(*it)->getSendSeq() == sendSeq) {
-            events_.erase(it);
-            return true;
-        }
-    }
-    return false;
+    return removeEventBySequence(sendSeq);
 }
 
 std::shared_ptr<MockEvent> MockClientEventsHistory::getEventBySendSeq(std::uint64_t sendSeq) {
-
-    read_guard_t guard(rw_mutex_);
-    for (const auto& event : events_) {
-        if (std::static_pointer_cast<MockClientEvent>(event)->getSendSeq() == sendSeq) {
-            return event;
-        }
-    }
-    return nullptr;
+    return getEventBySequence(sendSeq);
 }
 
 }
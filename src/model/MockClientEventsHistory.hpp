@@ -52,8 +52,9 @@ public:
     * Constructor
     *
     * @param dataKey Events key (client endpoint id, method & uri).
+    * @param storageBytes Optional counter where the estimated size of stored events is accumulated.
     */
-    MockClientEventsHistory(const DataKey &dataKey) : MockEventsHistory(dataKey) {;}
+    MockClientEventsHistory(const DataKey &dataKey, std::shared_ptr<std::atomic<std::int64_t>> storageBytes = nullptr) : MockEventsHistory(dataKey, storageBytes) {;}
 
     // setters:
 
@@ -77,8 +78,11 @@ public:
      * @param timeoutMs Timeout in milliseconds
      *
      * @param historyEnabled Events complete history storage
+     * @param maxEvents Maximum number of events kept when history is enabled (zero for no limit)
+     *
+     * @return Number of oldest events dropped to honor the maximum
      */
-    void loadEvent(const std::string &clientProvisionId, const std::string &previousState, const std::string &state, const std::chrono::microseconds &sendingTimestampUs, const std::chrono::microseconds &receptionTimestampUs, int responseStatusCode, const nghttp2::asio_http2::header_map &requestHeaders, const nghttp2::asio_http2::header_map &responseHeaders, const std::string &requestBody, DataPart &responseBodyDataPart, std::uint64_t sendSeq, std::int64_t sequence, unsigned int requestDelayMs, unsigned int timeoutMs, bool historyEnabled);
+    std::size_t loadEvent(const std::string &clientProvisionId, const std::string &previousState, const std::string &state, const std::chrono::microseconds &sendingTimestampUs, const std::chrono::microseconds &receptionTimestampUs, int responseStatusCode, const nghttp2::asio_http2::header_map &requestHeaders, const nghttp2::asio_http2::header_map &responseHeaders, const std::string &requestBody, DataPart &responseBodyDataPart, std::uint64_t sendSeq, std::int64_t sequence, unsigned int requestDelayMs, unsigned int timeoutMs, bool historyEnabled, std::size_t maxEvents = 0);
 
     /**
      * Removes event matching a given client sequence
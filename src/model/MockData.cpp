@@ -34,6 +34,8 @@ SOFTWARE.
 */
 
 #include <string>
+#include <algorithm>
+#include <tuple>
 
 #include <ert/tracing/Logger.hpp>
 
@@ -53,7 +55,84 @@ std::shared_ptr<MockEventsHistory> MockData::getEvents(const DataKey &dataKey, b
         return result;
     }
     maiden = true;
-    return std::make_shared<MockEventsHistory>(dataKey);
+    return std::make_shared<MockEventsHistory>(dataKey, storage_bytes_);
+}
+
+void MockData::queueEvictions() {
+
+    std::vector<std::tuple<std::uint64_t, std::uint64_t, ValueType>> histories; // recency, last used, history
+    this->forEach([&](const KeyType&, const ValueType& value) {
+        histories.emplace_back(value->recency(), value->lastUsedUs(), value);
+    });
+    std::sort(histories.begin(), histories.end(), [](const auto &a, const auto &b) {
+        return std::tie(std::get<0>(a), std::get<1>(a)) < std::tie(std::get<0>(b), std::get<1>(b));
+    });
+
+    eviction_queue_.clear();
+    for (const auto &history: histories) {
+        eviction_queue_.emplace_back(std::get<0>(history), std::get<2>(history));
+    }
+}
+
+void MockData::retain(const std::shared_ptr<MockEventsHistory> &history, std::size_t droppedEvents) {
+
+    if (droppedEvents != 0 && evicted_events_counter_) evicted_events_counter_->Increment(droppedEvents);
+
+    if (max_bytes_.load(std::memory_order_relaxed) == 0) return;
+
+    history->setRecency(recency_clock_.fetch_add(1, std::memory_order_relaxed) + 1);
+    enforceBudget(history->getKey().getKey());
+}
+
+void MockData::enforceBudget(const KeyType &current) {
+
+    std::int64_t maxBytes = static_cast<std::int64_t>(max_bytes_.load(std::memory_order_relaxed));
+    if (maxBytes == 0 || storage_bytes_->load(std::memory_order_relaxed) <= maxBytes) return;
+
+    std::unique_lock<std::mutex> lock(eviction_mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) return; // another thread is already evicting
+
+    bool queued{}; // snapshot taken during this enforcement
+    while (storage_bytes_->load(std::memory_order_relaxed) > maxBytes) {
+        if (eviction_queue_.empty()) {
+            if (queued) break;
+            queueEvictions();
+            queued = true;
+            if (eviction_queue_.empty()) break;
+        }
+        auto oldest = std::move(eviction_queue_.front());
+        eviction_queue_.pop_front();
+
+        auto candidate = oldest.second.lock();
+        if (!candidate || candidate->recency() != oldest.first) continue; // removed or updated later
+
+        const KeyType &key = candidate->getKey().getKey();
+        ValueType stored{};
+        if (!tryGet(key, stored) || stored != candidate) continue; // replaced by a new history
+
+        if (key == current) {
+            std::int64_t excess = storage_bytes_->load(std::memory_order_relaxed) - maxBytes;
+            std::size_t dropped = candidate->dropOldest(static_cast<std::size_t>(excess));
+            if (dropped != 0) {
+                if (evicted_events_counter_) evicted_events_counter_->Increment(dropped);
+                LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("Trimmed %zu events from key '%s' (storage budget exceeded)", dropped, key.c_str()), ERT_FILE_LOCATION));
+            }
+            if (storage_bytes_->load(std::memory_order_relaxed) <= maxBytes) {
+                eviction_queue_.push_front(std::move(oldest)); // still the least recently updated
+                break;
+            }
+        }
+
+        bool exists{};
+        remove(key, exists);
+        if (!exists) continue;
+        evicted(key);
+        if (evicted_keys_counter_) evicted_keys_counter_->Increment();
+        LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("Evicted key '%s' (storage budget exceeded)", key.c_str()), ERT_FILE_LOCATION));
+    }
+
+    std::int64_t excess = storage_bytes_->load(std::memory_order_relaxed) - maxBytes;
+    if (excess > 0) evictOther(excess, current);
 }
 
 bool MockData::clear(bool &somethingDeleted, const EventKey &ekey)
@@ -64,6 +143,8 @@ bool MockData::clear(bool &somethingDeleted, const EventKey &ekey)
     if (ekey.empty()) {
         somethingDeleted = (size() > 0);
         Map::clear();
+        std::lock_guard<std::mutex> guard(eviction_mutex_);
+        eviction_queue_.clear();
         return result;
     }
 
@@ -215,37 +296,6 @@ bool MockData::findLastRegisteredRequestState(const DataKey &key, std::string &s
     return false;
 }
 
-bool MockData::findLastRegisteredRequestState(const DataKey &key, std::string &state, std::map<std::string, std::string> &chainVariables) const {
-
-    bool exists{};
-    auto result = get(key.getKey(), exists);
-
-    if (exists) {
-        state = result->getLastRegisteredRequestState();
-        chainVariables = result->getChainVariables();
-        if (state.empty()) {
-            state = DEFAULT_ADMIN_PROVISION_STATE;
-            chainVariables.clear();
-        }
-
-        return true;
-    }
-
-    state = DEFAULT_ADMIN_PROVISION_STATE;
-    chainVariables.clear();
-    return false;
-}
-
-void MockData::storeChainVariables(const DataKey &key, const std::map<std::string, std::string> &chainVariables) {
-
-    bool exists{};
-    auto result = get(key.getKey(), exists);
-
-    if (exists) {
-        result->setChainVariables(chainVariables);
-    }
-}
-
 }
 }
 
@@ -36,10 +36,16 @@ SOFTWARE.
 #pragma once
 
 #include <vector>
+#include <deque>
+#include <utility>
 #include <cstdint>
+#include <atomic>
+#include <mutex>
 
 #include <nlohmann/json.hpp>
 
+#include <ert/metrics/Metrics.hpp>
+
 #include <Map.hpp>
 #include <MockEventsHistory.hpp>
 #include <MockEvent.hpp>
@@ -58,18 +64,108 @@ namespace model
  * Also, the last request for an specific key, is used to know the state which is used to get the
  * corresponding provision information.
  */
-class MockData : public Map<mock_events_key_t, std::shared_ptr<MockEventsHistory>>
+class MockData : public Map<mock_events_key_t, std::shared_ptr<MockEventsHistory>, TrafficMapStripes>
 {
+public:
+    using KeyType = mock_events_key_t;
+    using ValueType = std::shared_ptr<MockEventsHistory>;
+
+private:
+    // Retention (zero means no limit):
+    std::atomic<std::uint64_t> max_events_per_key_{};
+    std::atomic<std::uint64_t> max_bytes_{};
+    std::mutex eviction_mutex_{};
+
+    // Budget eviction order (least recently updated first): every update just stamps the history
+    // from an atomic clock (no lock on the traffic path). The eviction queue is a snapshot of the
+    // stamps, sorted when eviction runs out of candidates: entries updated again since then are
+    // more recent than any other queued one, so they are skipped, as those removed.
+    std::atomic<std::uint64_t> recency_clock_{};
+    std::deque<std::pair<std::uint64_t, std::weak_ptr<MockEventsHistory>>> eviction_queue_{}; // protected by eviction_mutex_
+
+    void queueEvictions(); // snapshot of every key by recency (then by last update, for keys never stamped)
+
 protected:
+    EventInterners interners_{}; // repeated strings of this store events (released with them)
+    std::shared_ptr<std::atomic<std::int64_t>> storage_bytes_{std::make_shared<std::atomic<std::int64_t>>(0)}; // shared with histories
+
+    // metrics:
+    ert::metrics::counter_t *evicted_events_counter_{};
+    ert::metrics::counter_t *evicted_keys_counter_{};
+
     // Get the events list for data key provided, and pass by reference a boolean to know if the list must be inaugurated
     std::shared_ptr<MockEventsHistory> getEvents(const DataKey &dataKey, bool &maiden);
 
+    /**
+     * Applies retention after loading an event
+     *
+     * Events dropped from the key history (ring buffer) are accounted, and the storage budget is enforced.
+     *
+     * @param history Key history just updated
+     * @param droppedEvents Oldest events dropped from the key history to honor the maximum events per key
+     */
+    void retain(const std::shared_ptr<MockEventsHistory> &history, std::size_t droppedEvents);
+
+    /**
+     * Enforces the storage budget
+     *
+     * Whole keys are evicted, least recently updated first, while the storage exceeds the bytes budget.
+     * The current key is evicted last: its oldest events are dropped first, so a single key larger than
+     * the budget is trimmed down to its latest event (and evicted if that is still too large).
+     *
+     * @param current Key just updated
+     */
+    void enforceBudget(const KeyType &current);
+
+    /**
+     * Called for every key evicted by the storage budget
+     *
+     * @param key Key evicted
+     */
+    virtual void evicted(const KeyType &key) {}
+
+    /**
+     * Called when the storage still exceeds the budget once every events history is evicted,
+     * to release other data accounted in the storage
+     *
+     * @param excess Bytes over the budget
+     * @param current Key just updated (to be kept)
+     */
+    virtual void evictOther(std::int64_t excess, const KeyType &current) {}
+
 public:
     MockData() {};
-    ~MockData() = default;
+    virtual ~MockData() = default;
 
-    using KeyType = mock_events_key_t;
-    using ValueType = std::shared_ptr<MockEventsHistory>;
+    /**
+     * Configures data retention
+     *
+     * @param maxEventsPerKey Maximum number of events per key history (the oldest is dropped when exceeded). Zero for no limit.
+     * @param maxBytes Storage budget in bytes (least recently updated keys are evicted when exceeded). Zero for no limit.
+     */
+    void setRetention(std::uint64_t maxEventsPerKey, std::uint64_t maxBytes) {
+        max_events_per_key_.store(maxEventsPerKey, std::memory_order_relaxed);
+        max_bytes_.store(maxBytes, std::memory_order_relaxed);
+        if (maxBytes == 0) {
+            std::lock_guard<std::mutex> guard(eviction_mutex_);
+            eviction_queue_.clear();
+        }
+    }
+
+    /** Maximum number of events per key history (zero for no limit) */
+    std::uint64_t getMaxEventsPerKey() const {
+        return max_events_per_key_.load(std::memory_order_relaxed);
+    }
+
+    /** Storage budget in bytes (zero for no limit) */
+    std::uint64_t getMaxBytes() const {
+        return max_bytes_.load(std::memory_order_relaxed);
+    }
+
+    /** Estimated storage in bytes for the events stored */
+    std::int64_t getStorageBytes() const {
+        return storage_bytes_->load(std::memory_order_relaxed);
+    }
 
 
     /** Clears internal data
@@ -140,26 +236,6 @@ public:
      * @return Boolean about if the request is found or not
      */
     bool findLastRegisteredRequestState(const DataKey &key, std::string &state) const;
-
-    /**
-     * Finds most recent mock context entry state and chain variables.
-     *
-     * @param key Data key triggered.
-     * @param state Request current state filled by reference.
-     * @param chainVariables Chain variables filled by reference.
-     * If nothing found or no state (unprovisioned events), 'initial' will be set and variables will be empty.
-     *
-     * @return Boolean about if the request is found or not
-     */
-    bool findLastRegisteredRequestState(const DataKey &key, std::string &state, std::map<std::string, std::string> &chainVariables) const;
-
-    /**
-     * Stores chain variables for a given data key.
-     *
-     * @param key Data key.
-     * @param chainVariables Chain variables to store.
-     */
-    void storeChainVariables(const DataKey &key, const std::map<std::string, std::string> &chainVariables);
 };
 
 }
@@ -43,28 +43,31 @@ namespace h2agent
 namespace model
 {
 
-void MockEvent::load(const std::string &previousState, const std::string &state, const std::chrono::microseconds &receptionTimestampUs, int responseStatusCode, const nghttp2::asio_http2::header_map &requestHeaders, const nghttp2::asio_http2::header_map &responseHeaders) {
+void MockEvent::load(const std::string &previousState, const std::string &state, const std::chrono::microseconds &receptionTimestampUs, int responseStatusCode, const nghttp2::asio_http2::header_map &requestHeaders, const nghttp2::asio_http2::header_map &responseHeaders, EventInterners *interners) {
 
-    previous_state_ = previousState;
-    state_ = state;
+    if (!interners) interners = &EventInterners::shared();
+    previous_state_.assign(previousState, interners->tokens);
+    state_.assign(state, interners->tokens);
     reception_timestamp_us_ = receptionTimestampUs.count();
     response_status_code_ = responseStatusCode;
-    request_headers_ = requestHeaders;
-    response_headers_ = responseHeaders;
+    request_headers_.assign(requestHeaders);
+    response_headers_.assign(responseHeaders);
+}
+
+void MockEvent::buildJson() const {
 
-    // Update json_:
-    if (!previous_state_.empty() /* server mode: unprovisioned 501 comes with empty value, and states are meaningless there */) json_["previousState"] = previous_state_;
-    if(!state_.empty() /* server mode: unprovisioned 501 comes with empty value, and states are meaningless there */) json_["state"] = state_;
+    if (!previous_state_.empty() /* server mode: unprovisioned 501 comes with empty value, and states are meaningless there */) json_["previousState"] = previous_state_.str();
+    if(!state_.empty() /* server mode: unprovisioned 501 comes with empty value, and states are meaningless there */) json_["state"] = state_.str();
     json_["receptionTimestampUs"] = (std::uint64_t)reception_timestamp_us_;
     json_["responseStatusCode"] = (int)response_status_code_;
     for (const auto& [field, member] : {
-                std::pair{"requestHeaders", request_headers_}, std::pair{"responseHeaders", response_headers_} // LCOV_EXCL_LINE
+                std::pair{"requestHeaders", &request_headers_}, std::pair{"responseHeaders", &response_headers_} // LCOV_EXCL_LINE
             }) {
-        if (member.size()) {
+        if (!member->empty()) {
             nlohmann::json hdrs;
-            for (const auto& [k, v] : member) {
-                hdrs[k] = v.value;
-            }
+            member->forEach([&hdrs](std::string &&name, std::string &&value, bool) {
+                hdrs[name] = std::move(value);
+            });
             json_[field] = hdrs;
         }
     }
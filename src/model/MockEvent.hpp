@@ -37,11 +37,14 @@ SOFTWARE.
 
 #include <string>
 #include <chrono>
+#include <atomic>
+#include <mutex>
 
 #include <nghttp2/asio_http2_server.h>
 #include <nlohmann/json.hpp>
 
 #include <DataPart.hpp>
+#include <EventArena.hpp>
 
 
 namespace h2agent
@@ -52,20 +55,39 @@ namespace model
 
 class MockEvent
 {
-    std::string previous_state_{};
-    std::string state_{};
+    InternedString previous_state_{};
+    InternedString state_{};
     std::uint64_t reception_timestamp_us_{};
     unsigned int response_status_code_{};
-    nghttp2::asio_http2::header_map request_headers_{};
-    nghttp2::asio_http2::header_map response_headers_{};
+    CompactHeaders request_headers_{};
+    CompactHeaders response_headers_{};
+
+    mutable std::atomic<bool> json_built_{};
 
 protected:
 
-    nlohmann::json json_{}; // kept synchronized on load()
+    // Json view is built on first access (most events are never queried), and never modified once published:
+    mutable nlohmann::json json_{};
+    mutable std::mutex json_mutex_{}; // protects json_ building and lazy body decoding
+
+    /**
+     * Builds json view from event information (called once, under json mutex)
+     * Derived classes extend it with their own fields.
+     */
+    virtual void buildJson() const;
+
+    /**
+     * Adds the fields which could be updated after the json view is built (merged on every query).
+     * Derived classes add their own ones.
+     *
+     * @param json Json object where fields are added
+     */
+    virtual void addUpdatedJson(nlohmann::json &json) const {}
 
 public:
 
     MockEvent() {;}
+    virtual ~MockEvent() {;}
 
     // setters:
 
@@ -78,8 +100,9 @@ public:
      * @param responseStatusCode Response status code
      * @param requestHeaders Request headers
      * @param responseHeaders Response headers
+     * @param interners Interners for repeated strings (store ones). Shared ones by default.
      */
-    void load(const std::string &previousState, const std::string &state, const std::chrono::microseconds &receptionTimestampUs, int responseStatusCode, const nghttp2::asio_http2::header_map &requestHeaders, const nghttp2::asio_http2::header_map &responseHeaders);
+    void load(const std::string &previousState, const std::string &state, const std::chrono::microseconds &receptionTimestampUs, int responseStatusCode, const nghttp2::asio_http2::header_map &requestHeaders, const nghttp2::asio_http2::header_map &responseHeaders, EventInterners *interners = nullptr);
 
     // getters:
 
@@ -88,7 +111,23 @@ public:
      * @return current state
      */
     const std::string &getState() const {
-        return state_;
+        return state_.str();
+    }
+
+    /** Estimated storage for the event (json view excluded)
+     *
+     * @return Bytes estimation
+     */
+    virtual std::size_t storageBytes() const {
+        return request_headers_.bytes() + response_headers_.bytes();
+    }
+
+    /** Reception timestamp
+     *
+     * @return Microseconds reception timestamp
+     */
+    std::uint64_t getReceptionTimestampUs() const {
+        return reception_timestamp_us_;
     }
 
     /** Request headers
@@ -96,7 +135,7 @@ public:
      * @return Request headers
      */
     const nghttp2::asio_http2::header_map &getRequestHeaders() const {
-        return request_headers_;
+        return request_headers_.map();
     }
 
     /** Response headers
@@ -104,7 +143,7 @@ public:
      * @return Response headers
      */
     const nghttp2::asio_http2::header_map &getResponseHeaders() const {
-        return response_headers_;
+        return response_headers_.map();
     }
 
     /**
@@ -112,13 +151,29 @@ public:
      *
      * @param path within the object to restrict selection (empty by default).
      *
-     * @return Json object
+     * @return Json object (null if the path is not found)
      */
-    const nlohmann::json &getJson(const std::string &path = "") const {
-        if (path.empty()) return json_;
+    nlohmann::json getJson(const std::string &path = "") const {
+        if (!json_built_.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> guard(json_mutex_);
+            if (!json_built_.load(std::memory_order_relaxed)) {
+                buildJson();
+                json_built_.store(true, std::memory_order_release);
+            }
+        }
+        const nlohmann::json &built = json_; // read only: shared by concurrent queries
+
+        if (path.empty()) {
+            nlohmann::json result = built;
+            addUpdatedJson(result);
+            return result;
+        }
 
         nlohmann::json::json_pointer p(path);
-        return json_[p];
+        nlohmann::json updated = nlohmann::json::object();
+        addUpdatedJson(updated);
+        if (updated.contains(p)) return updated[p];
+        return (built.contains(p) ? built[p] : nlohmann::json());
     }
 };
 
@@ -33,6 +33,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+#include <algorithm>
+
 #include <ert/tracing/Logger.hpp>
 
 #include <MockEventsHistory.hpp>
@@ -43,26 +45,194 @@ namespace h2agent
 namespace model
 {
 
-void MockEventsHistory::loadEvent(std::shared_ptr<MockEvent> event, bool historyEnabled) {
+std::size_t MockEventsHistory::loadEvent(std::shared_ptr<MockEvent> event, std::uint64_t sequence, bool historyEnabled, std::size_t maxEvents) {
+
+    std::size_t dropped{};
 
     write_guard_t guard(rw_mutex_);
 
+    last_used_us_.store(event->getReceptionTimestampUs(), std::memory_order_relaxed);
+    account(event->storageBytes());
+
     if (!historyEnabled && events_.size() != 0) {
-        events_[0] = event; // overwrite with this latest reception
+        // overwrite with this latest reception:
+        if (events_[0]) {
+            unindex();
+            account(-static_cast<std::int64_t>(events_[0]->storageBytes()));
+        }
+        else {
+            holes_--;
+            leading_ = 0;
+        }
+
+        events_[0] = event;
+        sequences_[0] = sequence;
+        index(sequence, 0);
     }
     else {
         events_.push_back(event);
+        sequences_.push_back(sequence);
+        index(sequence, events_.size() - 1);
+
+        // Ring buffer: drop the oldest events beyond the maximum
+        if (maxEvents != 0) {
+            while (events_.size() - holes_ > maxEvents) {
+                unindex();
+                removeAt(leading_);
+                dropped++;
+            }
+        }
+    }
+
+    return dropped;
+}
+
+std::size_t MockEventsHistory::dropOldest(std::size_t bytes) {
+
+    std::size_t dropped{};
+
+    write_guard_t guard(rw_mutex_);
+
+    std::size_t target = (bytes_ > bytes) ? (bytes_ - bytes) : 0;
+    while (bytes_ > target && events_.size() - holes_ > 1) {
+        unindex();
+        removeAt(leading_);
+        dropped++;
+    }
+
+    return dropped;
+}
+
+std::size_t MockEventsHistory::position(std::uint64_t eventNumber, bool reverse) const {
+
+    std::size_t size = events_.size();
+    if (eventNumber == 0 || eventNumber > size - holes_) return size;
+
+    if (holes_ == leading_) { // contiguous events
+        return (reverse ? (size - eventNumber):(leading_ + eventNumber - 1));
+    }
+
+    // Skip holes:
+    std::uint64_t count{};
+    for (std::size_t k = 0; k < size; k++) {
+        std::size_t pos = (reverse ? (size - 1 - k):k);
+        if (events_[pos] && ++count == eventNumber) return pos;
+    }
+
+    return size;
+}
+
+std::size_t MockEventsHistory::findSequence(std::uint64_t sequence) const {
+
+    // Sequences are unique in practice, but the first loaded one wins (as the former linear search did):
+    for (auto it = std::lower_bound(positions_.begin(), positions_.end(), std::make_pair(sequence, std::size_t(0)));
+            it != positions_.end() && it->first == sequence; ++it) {
+        if (indexed(*it)) return it->second;
+    }
+
+    return events_.size();
+}
+
+bool MockEventsHistory::indexed(const std::pair<std::uint64_t, std::size_t> &entry) const {
+
+    return (entry.second < events_.size() && events_[entry.second] && sequences_[entry.second] == entry.first);
+}
+
+void MockEventsHistory::index(std::uint64_t sequence, std::size_t pos) {
+
+    if (stale_ != 0 && stale_ * 2 >= positions_.size()) reindex();
+
+    auto entry = std::make_pair(sequence, pos);
+    if (positions_.empty() || positions_.back() < entry) positions_.push_back(entry);
+    else positions_.insert(std::upper_bound(positions_.begin(), positions_.end(), entry), entry);
+}
+
+void MockEventsHistory::unindex() {
+
+    stale_++; // entry becomes invalid once its position is removed or overwritten
+}
+
+void MockEventsHistory::reindex() {
+
+    positions_.erase(std::remove_if(positions_.begin(), positions_.end(), [this](const std::pair<std::uint64_t, std::size_t> &entry) {
+        return !indexed(entry);
+    }), positions_.end());
+    positions_.erase(std::unique(positions_.begin(), positions_.end()), positions_.end());
+    stale_ = 0;
+}
+
+void MockEventsHistory::account(std::int64_t bytes) {
+
+    bytes_ += bytes;
+    if (storage_bytes_) storage_bytes_->fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void MockEventsHistory::removeAt(std::size_t pos) {
+
+    account(-static_cast<std::int64_t>(events_[pos]->storageBytes()));
+    events_[pos] = nullptr;
+    holes_++;
+
+    // Leading holes are skipped in O(1):
+    if (pos == leading_) {
+        while (leading_ < events_.size() && !events_[leading_]) leading_++;
+    }
+
+    // Trailing holes are dropped:
+    while (!events_.empty() && !events_.back()) {
+        events_.pop_back();
+        sequences_.pop_back();
+        holes_--;
     }
+    if (events_.empty()) leading_ = 0;
+
+    if (holes_ != 0 && holes_ * 2 >= events_.size()) compact();
+}
+
+void MockEventsHistory::compact() {
+
+    std::size_t dst{};
+    positions_.clear();
+    for (std::size_t src = 0; src < events_.size(); src++) {
+        if (!events_[src]) continue;
+        if (dst != src) {
+            events_[dst] = std::move(events_[src]);
+            sequences_[dst] = sequences_[src];
+        }
+        positions_.emplace_back(sequences_[dst], dst);
+        dst++;
+    }
+    if (!std::is_sorted(positions_.begin(), positions_.end())) std::sort(positions_.begin(), positions_.end());
+    stale_ = 0;
+
+    events_.resize(dst);
+    sequences_.resize(dst);
+    holes_ = 0;
+    leading_ = 0;
 }
 
 bool MockEventsHistory::removeEvent(std::uint64_t eventNumber, bool reverse) {
 
     write_guard_t guard(rw_mutex_);
 
-    if (events_.size() == 0 || eventNumber == 0) return false;
-    if (eventNumber > events_.size()) return false;
+    std::size_t pos = position(eventNumber, reverse);
+    if (pos == events_.size()) return false;
 
-    events_.erase(events_.begin() + (reverse ? (events_.size() - eventNumber):(eventNumber - 1)));
+    unindex();
+    removeAt(pos);
+
+    return true;
+}
+
+bool MockEventsHistory::removeEventBySequence(std::uint64_t sequence) {
+
+    write_guard_t guard(rw_mutex_);
+
+    std::size_t pos = findSequence(sequence);
+    if (pos == events_.size()) return false;
+
+    unindex();
+    removeAt(pos);
 
     return true;
 }
@@ -71,17 +241,28 @@ std::shared_ptr<MockEvent> MockEventsHistory::getEvent(std::uint64_t eventNumber
 
     read_guard_t guard(rw_mutex_);
 
-    if (events_.size() == 0) return nullptr;
-    if (eventNumber == 0) return nullptr;
+    std::size_t pos = position(eventNumber, reverse);
+    if (pos == events_.size()) return nullptr;
+
+    return events_[pos];
+}
+
+std::shared_ptr<MockEvent> MockEventsHistory::getEventBySequence(std::uint64_t sequence) const {
+
+    read_guard_t guard(rw_mutex_);
+
+    std::size_t pos = findSequence(sequence);
+    if (pos == events_.size()) return nullptr;
 
-    if (eventNumber > events_.size()) return nullptr;
+    return events_[pos];
+}
 
-    if (reverse) {
-        return *(events_.begin() + (events_.size() - eventNumber));
-        //return *(std::prev(events_.end())); // this would be the last
-    }
+void MockEventsHistory::forEachEvent(const std::function<void(const std::shared_ptr<MockEvent>&)> &func) const {
 
-    return *(events_.begin() + (eventNumber - 1));
+    read_guard_t guard(rw_mutex_);
+    for (const auto &event: events_) {
+        if (event) func(event);
+    }
 }
 
 nlohmann::json MockEventsHistory::getJson() const {
@@ -91,7 +272,7 @@ nlohmann::json MockEventsHistory::getJson() const {
 
     read_guard_t guard(rw_mutex_);
     for (auto it = events_.begin(); it != events_.end(); it ++) {
-        result["events"].push_back((*it)->getJson());
+        if (*it) result["events"].push_back((*it)->getJson());
     }
 
     return result;
@@ -38,7 +38,9 @@ SOFTWARE.
 
 #include <vector>
 #include <map>
+#include <atomic>
 #include <memory>
+#include <functional>
 
 #include <MockEvent.hpp>
 #include <keys.hpp>
@@ -52,21 +54,71 @@ namespace model
 
 class MockEventsHistory
 {
-    std::map<std::string, std::string> chain_variables_{}; // scoped variables propagated across outState chain
+    // Events removed by sequence leave a null hole (O(1) removal) until the vector is compacted,
+    // which happens once holes reach half of the vector (amortized O(1)). Trailing holes are
+    // popped at once, so the last entry is never a hole.
+    std::vector<std::uint64_t> sequences_{}; // parallel to events_
+    // Sequences index, sorted by (sequence, position) and found by binary search. Sequences are loaded
+    // almost in ascending order, so insertions append in practice. Removed positions are just left
+    // stale, until they reach half of the index (then they are purged) or the vector is compacted.
+    std::vector<std::pair<std::uint64_t, std::size_t>> positions_{}; // (sequence, events_ position)
+    std::size_t stale_{}; // stale entries in positions_
+    std::size_t holes_{};
+    std::size_t leading_{}; // holes before the first event (oldest events dropped): they are skipped in O(1)
+
+    // Retention:
+    std::size_t bytes_{}; // estimated storage for events
+    std::shared_ptr<std::atomic<std::int64_t>> storage_bytes_{}; // whole storage accounting (optional)
+    std::atomic<std::uint64_t> last_used_us_{}; // reception timestamp of the latest event loaded
+    std::atomic<std::uint64_t> recency_{}; // storage budget eviction order (see MockData)
+
+    // Following helpers must be called under write lock:
+    std::size_t position(std::uint64_t eventNumber, bool reverse) const; // events_ position for history number, or events_.size() if missing
+    std::size_t findSequence(std::uint64_t sequence) const; // earliest events_ position, or events_.size() if missing
+    bool indexed(const std::pair<std::uint64_t, std::size_t> &entry) const; // entry still valid
+    void index(std::uint64_t sequence, std::size_t pos); // adds position to sequences index
+    void unindex(); // accounts a removed or overwritten position as stale in sequences index
+    void reindex(); // purges stale entries
+    void removeAt(std::size_t pos);
+    void compact();
+    void account(std::int64_t bytes);
 
 protected:
     std::vector<std::shared_ptr<MockEvent>> events_{};
-    mutable mutex_t rw_mutex_{}; // specific mutex to protect events_ and chain_variables_
+    mutable mutex_t rw_mutex_{}; // specific mutex to protect events_
     DataKey data_key_;
 
+    /**
+     * Removes the first event loaded with a given sequence
+     *
+     * @param sequence Event sequence (recvseq for server events, sendseq for client events)
+     *
+     * @return Boolean about if something was deleted
+     */
+    bool removeEventBySequence(std::uint64_t sequence);
+
+    /**
+     * Gets the first event loaded with a given sequence
+     *
+     * @param sequence Event sequence (recvseq for server events, sendseq for client events)
+     *
+     * @return Mock event or nullptr if not found
+     */
+    std::shared_ptr<MockEvent> getEventBySequence(std::uint64_t sequence) const;
+
 public:
 
     /**
     * Constructor
     *
     * @param dataKey Events key ([client enpoint id,] method & uri).
+    * @param storageBytes Optional counter where the estimated size of stored events is accumulated.
     */
-    MockEventsHistory(const DataKey &dataKey) : data_key_(dataKey) {;}
+    MockEventsHistory(const DataKey &dataKey, std::shared_ptr<std::atomic<std::int64_t>> storageBytes = nullptr) : storage_bytes_(storageBytes), data_key_(dataKey) {;}
+
+    virtual ~MockEventsHistory() {
+        if (storage_bytes_) storage_bytes_->fetch_sub(bytes_, std::memory_order_relaxed);
+    }
 
     // setters:
 
@@ -74,11 +126,16 @@ public:
     * Loads event into history
     *
     * @param event Event to load
+    * @param sequence Event sequence, indexed for O(log n) access by sequence
     * @param historyEnabled Events complete history storage
+    * @param maxEvents Maximum number of events kept when history is enabled: the oldest one is dropped
+    * when exceeded (ring buffer). Zero means no limit.
     *
     * Memory must be reserved by the user
+    *
+    * @return Number of events dropped to honor the maximum
     */
-    void loadEvent(std::shared_ptr<MockEvent> event, bool historyEnabled);
+    std::size_t loadEvent(std::shared_ptr<MockEvent> event, std::uint64_t sequence, bool historyEnabled, std::size_t maxEvents = 0);
 
     /**
      * Removes vector item for a given position
@@ -91,6 +148,24 @@ public:
      */
     bool removeEvent(std::uint64_t eventNumber, bool reverse);
 
+    /**
+     * Drops the oldest events to release storage, keeping at least the latest one
+     *
+     * @param bytes Storage to release
+     *
+     * @return Number of events dropped
+     */
+    std::size_t dropOldest(std::size_t bytes);
+
+    /**
+     * Sets the recency stamp used to order storage budget evictions
+     *
+     * @param stamp Recency stamp (higher is more recent)
+     */
+    void setRecency(std::uint64_t stamp) {
+        recency_.store(stamp, std::memory_order_relaxed);
+    }
+
     // getters:
 
     /**
@@ -121,54 +196,52 @@ public:
         return data_key_;
     }
 
-    /** Events vector (for iteration under external lock)
+    /** Iterates events in chronological order under read lock
     *
-    * @return Events vector reference
+    * @param func Function called for each event
     */
-    const std::vector<std::shared_ptr<MockEvent>> &getEvents() const {
-        return events_;
-    }
-
-    /** Mutex for external locking
-    *
-    * @return Mutex reference
-    */
-    mutex_t &getMutex() const {
-        return rw_mutex_;
-    }
+    void forEachEvent(const std::function<void(const std::shared_ptr<MockEvent>&)> &func) const;
 
     /** Number of events
     *
     * @return Events list size
     */
     size_t size() const {
-        return events_.size();
+        read_guard_t guard(rw_mutex_);
+        return events_.size() - holes_;
     }
 
-    /** Last registered request state
+    /** Estimated storage for events
     *
-    * @return Last registered request state
+    * @return Bytes estimation
     */
-    const std::string &getLastRegisteredRequestState() const;
+    size_t bytes() const {
+        read_guard_t guard(rw_mutex_);
+        return bytes_;
+    }
 
-    /** Sets chain variables (scoped variables propagated across outState chain)
+    /** Last time this history was updated
     *
-    * @param vars Variables map to store
+    * @return Reception timestamp in microseconds for the latest event loaded
     */
-    void setChainVariables(const std::map<std::string, std::string> &vars) {
-        write_guard_t guard(rw_mutex_);
-        chain_variables_ = vars;
+    std::uint64_t lastUsedUs() const {
+        return last_used_us_.load(std::memory_order_relaxed);
     }
 
-    /** Gets chain variables
+    /** Recency stamp for storage budget evictions
     *
-    * @return Chain variables map
+    * @return Recency stamp set on the latest update
     */
-    std::map<std::string, std::string> getChainVariables() const {
-        read_guard_t guard(rw_mutex_);
-        return chain_variables_;
+    std::uint64_t recency() const {
+        return recency_.load(std::memory_order_relaxed);
     }
 
+    /** Last registered request state
+    *
+    * @return Last registered request state
+    */
+    const std::string &getLastRegisteredRequestState() const;
+
 };
 
 }
@@ -46,16 +46,173 @@ namespace h2agent
 namespace model
 {
 
-void MockServerData::loadEvent(const DataKey &dataKey, const std::string &previousState, const std::string &state, const std::chrono::microseconds &receptionTimestampUs, unsigned int responseStatusCode, const nghttp2::asio_http2::header_map &requestHeaders, const nghttp2::asio_http2::header_map &responseHeaders, DataPart &requestBodyDataPart, const std::string &responseBody, std::uint64_t serverSequence, unsigned int responseDelayMs, bool historyEnabled, const std::string &virtualOriginComingFromMethod, const std::string &virtualOriginComingFromUri) {
+MockServerSession::MockServerSession(const CompositeKeyView &key, const std::string &sessionState, std::shared_ptr<const std::map<std::string, std::string>> sessionChainVariables, std::shared_ptr<std::atomic<std::int64_t>> storage) :
+    state(sessionState), chainVariables(std::move(sessionChainVariables)), storageBytes(std::move(storage)) {
 
-    bool maiden{};
-    auto events = std::static_pointer_cast<MockServerEventsHistory>(getEvents(dataKey, maiden));
+    bytes = sizeof(MockServerSession) + key.size() + state.size();
+    if (chainVariables) {
+        for (const auto &var: *chainVariables) bytes += var.first.size() + var.second.size();
+    }
+    if (storageBytes) storageBytes->fetch_add(bytes, std::memory_order_relaxed);
+}
+
+MockServerSession::~MockServerSession() {
+    if (storageBytes) storageBytes->fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+std::shared_ptr<MockServerEvent> MockServerData::loadEvent(const DataKey &dataKey, const std::string &previousState, const std::string &state, const std::chrono::microseconds &receptionTimestampUs, unsigned int responseStatusCode, const nghttp2::asio_http2::header_map &requestHeaders, const nghttp2::asio_http2::header_map &responseHeaders, DataPart &requestBodyDataPart, const std::string &responseBody, std::uint64_t serverSequence, unsigned int responseDelayMs, bool historyEnabled, const std::string &virtualOriginComingFromMethod, const std::string &virtualOriginComingFromUri) {
+
+    // Event is built out of the stripe lock, which just links it into the key history:
+    auto event = std::allocate_shared<MockServerEvent>(SlabAllocator<MockServerEvent>()); // pooled: no heap fragmentation on long runs
+    event->load(previousState, state, receptionTimestampUs, responseStatusCode, requestHeaders, responseHeaders, requestBodyDataPart, responseBody, serverSequence, responseDelayMs, virtualOriginComingFromMethod, virtualOriginComingFromUri, &interners_);
+
+    std::size_t dropped{};
+    std::shared_ptr<MockEventsHistory> events;
+
+    modifyOrInsert(dataKey.getKey(), [&](std::shared_ptr<MockEventsHistory> &entry) {
+        if (!entry) entry = std::make_shared<MockServerEventsHistory>(dataKey, storage_bytes_);
+        events = entry;
+        dropped = entry->loadEvent(event, serverSequence, historyEnabled, getMaxEventsPerKey());
+    });
+
+    retain(events, dropped);
+
+    return event;
+}
+
+void MockServerData::enableMetrics(ert::metrics::Metrics *metrics, const std::string &source) {
+
+    if (metrics) {
+        ert::metrics::labels_t familyLabels = {{"source", source}};
+
+        ert::metrics::counter_family_t& cf = metrics->addCounterFamily("h2agent_traffic_server_data_evictions_counter", "Server data retention evictions counter in h2agent_traffic_server", familyLabels);
+        evicted_events_counter_ = &(cf.Add({{"type", "event"}}));
+        evicted_keys_counter_ = &(cf.Add({{"type", "key"}}));
+        evicted_sessions_counter_ = &(cf.Add({{"type", "session"}}));
+    }
+}
+
+void MockServerData::resyncSession(const DataKey &dataKey) {
+
+    bool exists{};
+    auto events = get(dataKey.getKey(), exists);
+    if (!exists) {
+        removeSession(dataKey);
+        return;
+    }
+
+    std::string state = events->getLastRegisteredRequestState();
+    if (state.empty()) { // unprovisioned event must be understood as missing (ignore register)
+        removeSession(dataKey);
+        return;
+    }
+    updateSessionState(dataKey, state);
+}
+
+bool MockServerData::clear(bool &somethingDeleted, const EventKey &ekey) {
+
+    bool result = MockData::clear(somethingDeleted, ekey);
+    if (!result) return false;
+
+    if (ekey.empty()) {
+        sessions_.clear();
+    }
+    else if (!ekey.hasNumber()) {
+        removeSession(ekey);
+    }
+    else if (somethingDeleted) {
+        resyncSession(ekey);
+    }
+
+    return result;
+}
 
-    events->loadEvent(previousState, state, receptionTimestampUs, responseStatusCode, requestHeaders, responseHeaders, requestBodyDataPart, responseBody, serverSequence, responseDelayMs, historyEnabled, virtualOriginComingFromMethod, virtualOriginComingFromUri);
+std::shared_ptr<const MockServerSession> MockServerData::findSession(const CompositeKeyView &key) const {
 
-    if (maiden) add(dataKey.getKey(), events); // push the key in the map:
+    std::shared_ptr<const MockServerSession> result{};
+    if (sessions_.empty()) return result; // i.e. stateless traffic: skip the lookup
 
-    last_loaded_event_ = std::static_pointer_cast<MockServerEvent>(events->getEvent(1, true /* reverse: last */));
+    sessions_.tryGet(key, result);
+    return result;
+}
+
+void MockServerData::updateSession(const CompositeKeyView &key, const std::string &state, std::shared_ptr<const std::map<std::string, std::string>> chainVariables) {
+
+    if (chainVariables && chainVariables->empty()) chainVariables.reset();
+
+    // Empty state (unprovisioned) also drops chain variables:
+    if (state.empty() || (state == DEFAULT_ADMIN_PROVISION_STATE && !chainVariables)) {
+        removeSession(key);
+        return;
+    }
+
+    sessions_.add(key, std::make_shared<const MockServerSession>(key, state, std::move(chainVariables), storage_bytes_));
+    enforceSessionsBudget(key);
+}
+
+void MockServerData::updateSessionState(const CompositeKeyView &key, const std::string &state) {
+
+    if (state.empty()) {
+        removeSession(key);
+        return;
+    }
+
+    // Current chain variables are kept within the same atomic update:
+    bool kept{};
+    sessions_.modifyOrErase(key, [&](std::shared_ptr<const MockServerSession> &session) {
+        auto chainVariables = session ? session->chainVariables : nullptr;
+        kept = (state != DEFAULT_ADMIN_PROVISION_STATE || chainVariables);
+        if (kept) session = std::make_shared<const MockServerSession>(key, state, std::move(chainVariables), storage_bytes_);
+        return kept;
+    });
+    if (kept) enforceSessionsBudget(key);
+}
+
+void MockServerData::enforceSessionsBudget(const CompositeKeyView &key) {
+
+    if (getMaxBytes() == 0 || getStorageBytes() <= static_cast<std::int64_t>(getMaxBytes())) return;
+
+    std::string current{};
+    key.compose(current);
+    enforceBudget(current);
+}
+
+void MockServerData::evicted(const KeyType &key) {
+
+    if (sessions_.empty()) return;
+
+    bool aux{};
+    sessions_.remove(key, aux); // evicted key restarts from initial state
+}
+
+void MockServerData::evictOther(std::int64_t excess, const KeyType &current) {
+
+    // Sessions have no recency order: they are released down to three quarters of the budget,
+    // so this scan is amortized over the following updates:
+    excess += static_cast<std::int64_t>(getMaxBytes() / 4);
+
+    std::vector<KeyType> keys{};
+    sessions_.forEach([&](const KeyType &key, const std::shared_ptr<const MockServerSession> &session) {
+        if (excess <= 0 || key == current) return;
+        excess -= session->bytes;
+        keys.push_back(key);
+    });
+
+    for (const auto &key: keys) {
+        bool exists{};
+        sessions_.remove(key, exists);
+        if (!exists) continue;
+        if (evicted_sessions_counter_) evicted_sessions_counter_->Increment();
+        LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("Evicted session '%s' (storage budget exceeded)", key.c_str()), ERT_FILE_LOCATION));
+    }
+}
+
+void MockServerData::removeSession(const CompositeKeyView &key) {
+
+    if (sessions_.empty()) return;
+
+    bool aux{};
+    sessions_.remove(key, aux);
 }
 
 bool MockServerData::removeEventByRecvSeq(const DataKey &dataKey, std::uint64_t recvSeq) {
@@ -72,6 +229,8 @@ bool MockServerData::removeEventByRecvSeq(const DataKey &dataKey, std::uint64_t
         remove(dataKey.getKey(), aux);
     }
 
+    if (deleted) resyncSession(dataKey);
+
     return deleted;
 }
 
@@ -102,10 +261,9 @@ std::string MockServerData::getSequence(std::uint64_t fromTimestampUs, std::uint
         if (!requestMethod.empty() && method != requestMethod) return;
         if (uriRegex && !std::regex_search(uri, *uriRegex)) return;
 
-        read_guard_t guard(history->getMutex());
-        for (const auto &ev : history->getEvents()) {
+        history->forEachEvent([&](const std::shared_ptr<MockEvent> &ev) {
             auto serverEv = std::static_pointer_cast<MockServerEvent>(ev);
-            std::uint64_t recTs = serverEv->getJson()["receptionTimestampUs"].get<std::uint64_t>();
+            std::uint64_t recTs = serverEv->getReceptionTimestampUs();
             std::uint64_t sendTs = serverEv->getSendingTimestampUs();
 
             // Recv entry:
@@ -116,7 +274,7 @@ std::string MockServerData::getSequence(std::uint64_t fromTimestampUs, std::uint
             if (sendTs && (!fromTimestampUs || sendTs >= fromTimestampUs) && (!toTimestampUs || sendTs <= toTimestampUs)) {
                 entries.push_back({sendTs, "send", method, uri});
             }
-        }
+        });
     });
 
     std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
@@ -36,6 +36,8 @@ SOFTWARE.
 #pragma once
 
 #include <vector>
+#include <map>
+#include <memory>
 #include <cstdint>
 #include <regex>
 
@@ -53,21 +55,61 @@ namespace model
 {
 
 
+/**
+ * Session for a data key: current state and chain variables propagated across the outState chain.
+ * Sessions are published as immutable objects, so readers just share them.
+ */
+struct MockServerSession {
+    std::string state{};
+    std::shared_ptr<const std::map<std::string, std::string>> chainVariables{}; // null when empty
+
+    // Estimated storage, accounted while the session lives (like events histories):
+    std::size_t bytes{};
+    std::shared_ptr<std::atomic<std::int64_t>> storageBytes{};
+
+    MockServerSession(const CompositeKeyView &key, const std::string &sessionState, std::shared_ptr<const std::map<std::string, std::string>> sessionChainVariables, std::shared_ptr<std::atomic<std::int64_t>> storage);
+    ~MockServerSession();
+
+    MockServerSession(const MockServerSession&) = delete;
+    MockServerSession& operator=(const MockServerSession&) = delete;
+};
+
 /**
  * This class stores the mock server events.
  *
  * This is useful to post-verify the internal data (content and schema validation) on testing system.
- * Also, the last request for an specific key, is used to know the state which is used to get the
- * corresponding provision information.
+ * Also, a compact sessions table keeps the current state (and chain variables) for each key, which
+ * is used to get the corresponding provision information. Sessions are kept apart from the events
+ * (they survive history trimming), but they are only updated when server data is stored, and are cleared
+ * together with it (admin deletion or purge). Sessions are accounted in the storage budget: they are
+ * evicted with their key events, and, when no events are left to evict, on their own.
  */
 class MockServerData : public MockData
 {
-    std::shared_ptr<MockServerEvent> last_loaded_event_{};
+    // Only keys out of the initial state (or with chain variables) have a session:
+    Map<mock_events_key_t, std::shared_ptr<const MockServerSession>, TrafficMapStripes> sessions_{};
+
+    // Resynchronizes the key session state with its remaining history after an event removal:
+    void resyncSession(const DataKey &dataKey);
+
+    // Storage budget hooks (sessions are accounted together with the events):
+    ert::metrics::counter_t *evicted_sessions_counter_{};
+    void enforceSessionsBudget(const CompositeKeyView &key);
+    void evicted(const KeyType &key) override;
+    void evictOther(std::int64_t excess, const KeyType &current) override;
 
 public:
     MockServerData() {};
     ~MockServerData() = default;
 
+    /**
+     * Enables metrics for data retention
+     *
+     * @param metrics Optional metrics object to compute counters
+     * @param source Source label for prometheus metrics
+     */
+    void enableMetrics(ert::metrics::Metrics *metrics, const std::string &source);
+
     /**
      * Loads event data
      *
@@ -88,8 +130,62 @@ public:
      * @param historyEnabled Events complete history storage
      * @param virtualOriginComingFromMethod Marks event as virtual one, adding a field with the origin method which caused it. Non-virtual by default (empty parameter).
      * @param virtualOriginComingFromUri Marks event as virtual one, adding a field with the origin uri which caused it. Non-virtual by default (empty parameter).
+     *
+     * @return Loaded event (it could be already evicted by retention)
      */
-    void loadEvent(const DataKey &dataKey, const std::string &previousState, const std::string &state, const std::chrono::microseconds &receptionTimestampUs, unsigned int responseStatusCode, const nghttp2::asio_http2::header_map &requestHeaders, const nghttp2::asio_http2::header_map &responseHeaders, DataPart &requestBodyDataPart, const std::string &responseBody, std::uint64_t serverSequence, unsigned int responseDelayMs, bool historyEnabled, const std::string &virtualOriginComingFromMethod = "", const std::string &virtualOriginComingFromUri = "");
+    std::shared_ptr<MockServerEvent> loadEvent(const DataKey &dataKey, const std::string &previousState, const std::string &state, const std::chrono::microseconds &receptionTimestampUs, unsigned int responseStatusCode, const nghttp2::asio_http2::header_map &requestHeaders, const nghttp2::asio_http2::header_map &responseHeaders, DataPart &requestBodyDataPart, const std::string &responseBody, std::uint64_t serverSequence, unsigned int responseDelayMs, bool historyEnabled, const std::string &virtualOriginComingFromMethod = "", const std::string &virtualOriginComingFromUri = "");
+
+    /** Clears internal data and the corresponding sessions
+     *
+     * @param somethingDeleted boolean to know if some event was deleted, by reference
+     * @param ekey Event key given by data key and event history number (1..N) to filter selection
+     * Empty event key will remove the whole history for data key provided.
+     * Event number '-1' will select the latest event in events history.
+     *
+     * @return Boolean about success of operation (not related to the number of events removed)
+     * @see MockData::clear()
+     */
+    bool clear(bool &somethingDeleted, const EventKey &ekey);
+
+    /**
+     * Finds the current session for a data key
+     *
+     * @param key Data key triggered (composite view avoids building the aggregated key)
+     *
+     * @return Session shared (nullptr when the key is on initial state without chain variables)
+     */
+    std::shared_ptr<const MockServerSession> findSession(const CompositeKeyView &key) const;
+
+    /**
+     * Updates the session for a data key
+     *
+     * Initial (or empty) state without chain variables just removes the session.
+     *
+     * @param key Data key
+     * @param state New state
+     * @param chainVariables Chain variables (nullptr when empty)
+     */
+    void updateSession(const CompositeKeyView &key, const std::string &state, std::shared_ptr<const std::map<std::string, std::string>> chainVariables);
+
+    /**
+     * Updates the session state for a data key, keeping its chain variables
+     *
+     * @param key Data key
+     * @param state New state
+     */
+    void updateSessionState(const CompositeKeyView &key, const std::string &state);
+
+    /**
+     * Removes the session for a data key (back to initial state)
+     *
+     * @param key Data key
+     */
+    void removeSession(const CompositeKeyView &key);
+
+    /** Number of keys out of the initial state (or with chain variables) */
+    std::size_t sessionsSize() const {
+        return sessions_.size();
+    }
 
     /**
      * Removes event matching a given receive sequence within a data key
@@ -111,15 +207,6 @@ public:
      */
     std::shared_ptr<MockEvent> getEventByRecvSeq(const DataKey &dataKey, std::uint64_t recvSeq);
 
-    /**
-     * Gets the last loaded event (from the most recent loadEvent call)
-     *
-     * @return Last loaded server event
-     */
-    std::shared_ptr<MockServerEvent> getLastLoadedEvent() const {
-        return last_loaded_event_;
-    }
-
     /**
      * Gets chronologically ordered sequence of events (method + uri + timestamps)
      *
@@ -43,35 +43,49 @@ namespace h2agent
 namespace model
 {
 
-void MockServerEvent::load(const std::string &previousState, const std::string &state, const std::chrono::microseconds &receptionTimestampUs, unsigned int responseStatusCode, const nghttp2::asio_http2::header_map &requestHeaders, const nghttp2::asio_http2::header_map &responseHeaders, DataPart &requestBodyDataPart, const std::string &responseBody, std::uint64_t recvSeq, unsigned int responseDelayMs, const std::string &virtualOriginComingFromMethod, const std::string &virtualOriginComingFromUri) {
+void MockServerEvent::load(const std::string &previousState, const std::string &state, const std::chrono::microseconds &receptionTimestampUs, unsigned int responseStatusCode, const nghttp2::asio_http2::header_map &requestHeaders, const nghttp2::asio_http2::header_map &responseHeaders, DataPart &requestBodyDataPart, const std::string &responseBody, std::uint64_t recvSeq, unsigned int responseDelayMs, const std::string &virtualOriginComingFromMethod, const std::string &virtualOriginComingFromUri, EventInterners *interners) {
+
+    if (!interners) interners = &EventInterners::shared();
 
     // Base class:
-    MockEvent::load(previousState, state, receptionTimestampUs, responseStatusCode, requestHeaders, responseHeaders);
+    MockEvent::load(previousState, state, receptionTimestampUs, responseStatusCode, requestHeaders, responseHeaders, interners);
 
-    requestBodyDataPart.decode(requestHeaders);
-    request_body_ = requestBodyDataPart.getJson();
-    response_body_data_part_.assign(std::move(responseBody));
-    response_body_data_part_.decode(responseHeaders);
+    request_body_data_part_.assign(requestBodyDataPart.str()); // raw copy: caller data part is shared by virtual events
+    response_body_data_part_.assign(responseBody);
     recv_seq_ = recvSeq;
     response_delay_ms_ = responseDelayMs;
-    virtual_origin_coming_from_method_ = virtualOriginComingFromMethod;
-    virtual_origin_coming_from_uri_ = virtualOriginComingFromUri;
+    virtual_origin_coming_from_method_.assign(virtualOriginComingFromMethod, interners->tokens);
+    virtual_origin_coming_from_uri_.assign(virtualOriginComingFromUri, interners->uris);
+}
+
+void MockServerEvent::buildJson() const {
+
+    // Base class:
+    MockEvent::buildJson();
 
-    // Update json_:
-    if (!request_body_.empty()) {
-        json_["requestBody"] = request_body_;
+    request_body_data_part_.decode(getRequestHeaders());
+    if (!request_body_data_part_.getJson().empty()) {
+        json_["requestBody"] = request_body_data_part_.getJson();
     }
     if (!response_body_data_part_.str().empty()) {
+        response_body_data_part_.decode(getResponseHeaders());
         json_["responseBody"] = response_body_data_part_.getJson();
     }
     json_["recvseq"] = (std::uint64_t)recv_seq_;
     json_["responseDelayMs"] = (unsigned int)response_delay_ms_;
     if (!virtual_origin_coming_from_method_.empty()) {
-        json_["virtualOrigin"]["method"] = virtual_origin_coming_from_method_;
-        json_["virtualOrigin"]["uri"] = virtual_origin_coming_from_uri_;
+        json_["virtualOrigin"]["method"] = virtual_origin_coming_from_method_.str();
+        json_["virtualOrigin"]["uri"] = virtual_origin_coming_from_uri_.str();
     }
 }
 
+void MockServerEvent::addUpdatedJson(nlohmann::json &json) const {
+
+    // Set on stream close, usually after the view is built:
+    std::uint64_t sendingTimestampUs = sending_timestamp_us_.load();
+    if (sendingTimestampUs != 0) json["sendingTimestampUs"] = sendingTimestampUs;
+}
+
 }
 }
 
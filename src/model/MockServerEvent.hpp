@@ -47,13 +47,19 @@ namespace model
 
 class MockServerEvent : public MockEvent
 {
-    nlohmann::json request_body_{};
-    DataPart response_body_data_part_{};
+    // Bodies are stored raw, and decoded lazily (json mutex) when json view is required:
+    mutable DataPart request_body_data_part_{};
+    mutable DataPart response_body_data_part_{};
     std::uint64_t recv_seq_{};
     unsigned int response_delay_ms_{};
-    std::string virtual_origin_coming_from_method_{};
-    std::string virtual_origin_coming_from_uri_{};
-    std::uint64_t sending_timestamp_us_{};
+    InternedString virtual_origin_coming_from_method_{};
+    InternedString virtual_origin_coming_from_uri_{};
+    std::atomic<std::uint64_t> sending_timestamp_us_{};
+
+protected:
+
+    void buildJson() const override;
+    void addUpdatedJson(nlohmann::json &json) const override;
 
 public:
 
@@ -78,8 +84,9 @@ public:
      *
      * @param virtualOriginComingFromMethod Marks event as virtual one, adding a field with the origin method which caused it. Non-virtual by default (empty parameter).
      * @param virtualOriginComingFromUri Marks event as virtual one, adding a field with the origin uri which caused it. Non-virtual by default (empty parameter).
+     * @param interners Interners for repeated strings (store ones). Shared ones by default.
      */
-    void load(const std::string &previousState, const std::string &state, const std::chrono::microseconds &receptionTimestampUs, unsigned int responseStatusCode, const nghttp2::asio_http2::header_map &requestHeaders, const nghttp2::asio_http2::header_map &responseHeaders, DataPart &requestBodyDataPart, const std::string &responseBody, std::uint64_t recvSeq, unsigned int responseDelayMs, const std::string &virtualOriginComingFromMethod = "", const std::string &virtualOriginComingFromUri = "");
+    void load(const std::string &previousState, const std::string &state, const std::chrono::microseconds &receptionTimestampUs, unsigned int responseStatusCode, const nghttp2::asio_http2::header_map &requestHeaders, const nghttp2::asio_http2::header_map &responseHeaders, DataPart &requestBodyDataPart, const std::string &responseBody, std::uint64_t recvSeq, unsigned int responseDelayMs, const std::string &virtualOriginComingFromMethod = "", const std::string &virtualOriginComingFromUri = "", EventInterners *interners = nullptr);
 
     // getters
 
@@ -91,12 +98,18 @@ public:
         return recv_seq_;
     }
 
+    std::size_t storageBytes() const override {
+        return sizeof(MockServerEvent) + MockEvent::storageBytes() + request_body_data_part_.str().capacity() + response_body_data_part_.str().capacity();
+    }
+
     /** Request body
      *
      * @return Request body
      */
-    const nlohmann::json &getRequestBody() const {
-        return request_body_;
+    nlohmann::json getRequestBody() const {
+        std::lock_guard<std::mutex> guard(json_mutex_);
+        request_body_data_part_.decode(getRequestHeaders());
+        return request_body_data_part_.getJson();
     }
 
     /**
@@ -106,7 +119,6 @@ public:
      */
     void setSendingTimestampUs(const std::chrono::microseconds &sendingTimestampUs) {
         sending_timestamp_us_ = sendingTimestampUs.count();
-        json_["sendingTimestampUs"] = sending_timestamp_us_;
     }
 
     /** Sending timestamp (response out)
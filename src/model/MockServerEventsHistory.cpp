@@ -44,41 +44,27 @@ namespace h2agent
 namespace model
 {
 
-void MockServerEventsHistory::loadEvent(const std::string &previousState, const std::string &state,
-                                        const std::chrono::microseconds &receptionTimestampUs, unsigned int responseStatusCode,
-                                        const nghttp2::asio_http2::header_map &requestHeaders, const nghttp2::asio_http2::header_map &responseHeaders,
-                                        DataPart &requestBodyDataPart, const std::string &responseBody,
-                                        std::uint64_t serverSequence, unsigned int responseDelayMs,
-                                        bool historyEnabled, const std::string &virtualOriginComingFromMethod, const std::string &virtualOriginComingFromUri) {
+std::size_t MockServerEventsHistory::loadEvent(const std::string &previousState, const std::string &state,
+                                               const std::chrono::microseconds &receptionTimestampUs, unsigned int responseStatusCode,
+                                               const nghttp2::asio_http2::header_map &requestHeaders, const nghttp2::asio_http2::header_map &responseHeaders,
+                                               DataPart &requestBodyDataPart, const std::string &responseBody,
+                                               std::uint64_t serverSequence, unsigned int responseDelayMs,
+                                               bool historyEnabled, const std::string &virtualOriginComingFromMethod, const std::string &virtualOriginComingFromUri,
+                                               std::size_t maxEvents) {
 
 
-    auto event = std::make_shared<MockServerEvent>();
+    auto event = std::allocate_shared<MockServerEvent>(SlabAllocator<MockServerEvent>()); // pooled: no heap fragmentation on long runs
     event->load(previousState, state, receptionTimestampUs, responseStatusCode, requestHeaders, responseHeaders, requestBodyDataPart, responseBody, serverSequence, responseDelayMs, virtualOriginComingFromMethod, virtualOriginComingFromUri);
 
-    MockEventsHistory::loadEvent(std::static_pointer_cast<MockEvent>(event), historyEnabled);
+    return MockEventsHistory::loadEvent(std::static_pointer_cast<MockEvent>(event), serverSequence, historyEnabled, maxEvents);
 }
 
 bool MockServerEventsHistory::removeEventByRecvSeq(std::uint64_t recvSeq) {
-
-    write_guard_t guard(rw_mutex_);
-    for (auto it = events_.begin(); it != events_.end(); ++it) {
-        if (std::static_pointer_cast<MockServerEvent>(*it)->getRecvSeq() == recvSeq) {
-            events_.erase(it);
-            return true;
-        }
-    }
-    return false;
+    return removeEventBySequence(recvSeq);
 }
 
 std::shared_ptr<MockEvent> MockServerEventsHistory::getEventByRecvSeq(std::uint64_t recvSeq) {
-
-    read_guard_t guard(rw_mutex_);
-    for (const auto& event : events_) {
-        if (std::static_pointer_cast<MockServerEvent>(event)->getRecvSeq() == recvSeq) {
-            return event;
-        }
-    }
-    return nullptr;
+    return getEventBySequence(recvSeq);
 }
 
 }
@@ -52,8 +52,9 @@ public:
     * Constructor
     *
     * @param dataKey Events key (method & uri).
+    * @param storageBytes Optional counter where the estimated size of stored events is accumulated.
     */
-    MockServerEventsHistory(const DataKey &dataKey) : MockEventsHistory(dataKey) {;}
+    MockServerEventsHistory(const DataKey &dataKey, std::shared_ptr<std::atomic<std::int64_t>> storageBytes = nullptr) : MockEventsHistory(dataKey, storageBytes) {;}
 
     // setters:
 
@@ -75,8 +76,11 @@ public:
      * @param historyEnabled Events complete history storage
      * @param virtualOriginComingFromMethod Marks event as virtual one, adding a field with the origin method which caused it. Non-virtual by default (empty parameter).
      * @param virtualOriginComingFromUri Marks event as virtual one, adding a field with the origin uri which caused it. Non-virtual by default (empty parameter).
+     * @param maxEvents Maximum number of events kept when history is enabled (zero for no limit)
+     *
+     * @return Number of oldest events dropped to honor the maximum
      */
-    void loadEvent(const std::string &previousState, const std::string &state, const std::chrono::microseconds &receptionTimestampUs, unsigned int responseStatusCode, const nghttp2::asio_http2::header_map &requestHeaders, const nghttp2::asio_http2::header_map &responseHeaders, DataPart &requestBodyDataPart, const std::string &responseBody, std::uint64_t serverSequence, unsigned int responseDelayMs, bool historyEnabled, const std::string &virtualOriginComingFromMethod = "", const std::string &virtualOriginComingFromUri = "");
+    std::size_t loadEvent(const std::string &previousState, const std::string &state, const std::chrono::microseconds &receptionTimestampUs, unsigned int responseStatusCode, const nghttp2::asio_http2::header_map &requestHeaders, const nghttp2::asio_http2::header_map &responseHeaders, DataPart &requestBodyDataPart, const std::string &responseBody, std::uint64_t serverSequence, unsigned int responseDelayMs, bool historyEnabled, const std::string &virtualOriginComingFromMethod = "", const std::string &virtualOriginComingFromUri = "", std::size_t maxEvents = 0);
 
     /**
      * Removes event matching a given receive sequence
@@ -0,0 +1,141 @@
+/*
+ ___________________________________________
+|    _     ___                        _     |
+|   | |   |__ \                      | |    |
+|   | |__    ) |__ _  __ _  ___ _ __ | |_   |
+|   | '_ \  / // _` |/ _` |/ _ \ '_ \| __|  |  HTTP/2 AGENT FOR MOCK TESTING
+|   | | | |/ /| (_| | (_| |  __/ | | | |_   |  Version 0.0.z
+|   |_| |_|____\__,_|\__, |\___|_| |_|\__|  |  https://github.com/testillano/h2agent
+|                     __/ |                 |
+|                    |___/                  |
+|___________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+
+namespace h2agent
+{
+namespace model
+{
+
+/**
+ * Unbounded lock-free queue for multiple producers and a single consumer.
+ *
+ * Producers link a new node with one atomic exchange (no lock, no retry loop), so a
+ * producer is never blocked by the consumer or by other producers. Only one thread
+ * may pop at a time.
+ *
+ * A node being linked by a producer may be briefly invisible to the consumer, so
+ * pop() could report an empty queue just before the push completes: the consumer
+ * must be woken by the producer after push() (see SseManager).
+ *
+ * @tparam Value The type of the stored value (default-constructible and movable).
+ */
+template<typename Value>
+class MpscQueue {
+
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        Value value{};
+    };
+
+    std::atomic<Node*> head_; // last pushed node (producers)
+    Node *tail_; // last consumed node, acting as sentinel (consumer)
+    std::atomic<std::size_t> size_{0};
+
+public:
+    MpscQueue() {
+        Node *sentinel = new Node();
+        head_.store(sentinel, std::memory_order_relaxed);
+        tail_ = sentinel;
+    }
+
+    ~MpscQueue() {
+        Node *node = tail_;
+        while (node) {
+            Node *next = node->next.load(std::memory_order_relaxed);
+            delete node;
+            node = next;
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * Appends a value (any thread)
+     *
+     * @param value Value to append
+     */
+    void push(Value value) {
+        Node *node = new Node();
+        node->value = std::move(value);
+        size_.fetch_add(1); // sequentially consistent: see empty()
+        Node *previous = head_.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    /**
+     * Extracts the oldest value (single consumer thread)
+     *
+     * @param value Value extracted, by reference
+     *
+     * @return Boolean about value extracted
+     */
+    bool pop(Value &value) {
+        Node *next = tail_->next.load(std::memory_order_acquire);
+        if (!next) return false;
+
+        value = std::move(next->value);
+        delete tail_;
+        tail_ = next; // becomes the new sentinel
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * Approximate number of queued values
+     */
+    std::size_t size() const {
+        return size_.load();
+    }
+
+    /**
+     * Approximate emptiness: a value is accounted before being linked, so a consumer
+     * raising a sequentially consistent flag before checking emptiness, and producers
+     * checking that flag after push(), cannot miss each other.
+     */
+    bool empty() const {
+        return size() == 0;
+    }
+};
+
+}
+}
+
@@ -0,0 +1,222 @@
+/*
+ ___________________________________________
+|    _     ___                        _     |
+|   | |   |__ \                      | |    |
+|   | |__    ) |__ _  __ _  ___ _ __ | |_   |
+|   | '_ \  / // _` |/ _` |/ _ \ '_ \| __|  |  HTTP/2 AGENT FOR MOCK TESTING
+|   | | | |/ /| (_| | (_| |  __/ | | | |_   |  Version 0.0.z
+|   |_| |_|____\__,_|\__, |\___|_| |_|\__|  |  https://github.com/testillano/h2agent
+|                     __/ |                 |
+|                    |___/                  |
+|___________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+
+namespace h2agent
+{
+namespace model
+{
+
+/**
+ * Fixed-capacity table for values pending of a later notification, indexed by a sequence id.
+ *
+ * Slots are preallocated at construction and selected by 'id % Capacity', so there is no
+ * global lock and no allocation per operation: each slot is guarded by its own spinlock,
+ * which is only contended when two in-flight ids collide in the same slot.
+ *
+ * Overflow: when an id lands on a slot still occupied by another id (more than 'Capacity'
+ * entries in flight), the older entry is evicted and accounted as dropped. Taking an
+ * evicted id later just finds nothing.
+ *
+ * @tparam Value The type of the stored value (default-constructible and movable).
+ * @tparam Capacity Number of slots (power of two).
+ */
+template<typename Value, std::size_t Capacity>
+class PendingTable {
+
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "PendingTable capacity must be a power of two");
+
+    struct Slot {
+        std::atomic_flag busy = ATOMIC_FLAG_INIT;
+        bool used{};
+        std::uint64_t id{};
+        Value value{};
+
+        void lock() {
+            while (busy.test_and_set(std::memory_order_acquire)) {}
+        }
+        void unlock() {
+            busy.clear(std::memory_order_release);
+        }
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::size_t> size_{0}; // used slots (cheap emptiness check before touching any slot)
+
+    Slot &slot(std::uint64_t id) const {
+        return slots_[id & (Capacity - 1)];
+    }
+
+public:
+    PendingTable() : slots_(new Slot[Capacity]) {}
+    ~PendingTable() = default;
+
+    PendingTable(const PendingTable&) = delete;
+    PendingTable& operator=(const PendingTable&) = delete;
+
+    /**
+     * Stores a value for the provided id
+     *
+     * @param id Sequence identifier
+     * @param value Value to store
+     *
+     * @return Boolean about another pending entry evicted (dropped) to store this one
+     */
+    bool add(std::uint64_t id, Value value) {
+        [[maybe_unused]] Value evicted{}; // destroyed out of the slot lock
+        bool dropped{};
+
+        Slot &s = slot(id);
+        s.lock();
+        if (s.used && s.id != id) {
+            evicted = std::move(s.value);
+            dropped = true;
+        }
+        if (!s.used) size_.fetch_add(1, std::memory_order_relaxed);
+        s.id = id;
+        s.used = true;
+        s.value = std::move(value);
+        s.unlock();
+
+        if (dropped) dropped_.fetch_add(1, std::memory_order_relaxed);
+        return dropped;
+    }
+
+    /**
+     * Extracts the value stored for the provided id, releasing the slot
+     *
+     * @param id Sequence identifier
+     * @param value Extracted value (untouched when missing)
+     *
+     * @return Boolean about value found
+     */
+    bool take(std::uint64_t id, Value &value) {
+        bool found{};
+
+        Slot &s = slot(id);
+        s.lock();
+        if (s.used && s.id == id) {
+            value = std::move(s.value);
+            s.value = Value{};
+            s.used = false;
+            found = true;
+            size_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        s.unlock();
+
+        return found;
+    }
+
+    /**
+     * Copies the value stored for the provided id, keeping it in the table
+     *
+     * @param id Sequence identifier
+     * @param value Copied value (untouched when missing)
+     *
+     * @return Boolean about value found
+     */
+    bool find(std::uint64_t id, Value &value) const {
+        bool found{};
+
+        Slot &s = slot(id);
+        s.lock();
+        if (s.used && s.id == id) {
+            value = s.value;
+            found = true;
+        }
+        s.unlock();
+
+        return found;
+    }
+
+    /**
+     * Releases every slot
+     */
+    void clear() {
+        for (std::size_t k = 0; k < Capacity; k++) {
+            [[maybe_unused]] Value released{}; // destroyed out of the slot lock
+
+            Slot &s = slots_[k];
+            s.lock();
+            if (s.used) {
+                released = std::move(s.value);
+                s.value = Value{};
+                s.used = false;
+                size_.fetch_sub(1, std::memory_order_relaxed);
+            }
+            s.unlock();
+        }
+    }
+
+    /**
+     * Number of entries stored
+     */
+    std::size_t size() const {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Boolean about no entries stored
+     */
+    bool empty() const {
+        return (size() == 0);
+    }
+
+    /**
+     * Number of entries evicted before being taken, since creation
+     */
+    std::uint64_t dropped() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Number of slots
+     */
+    static constexpr std::size_t capacity() {
+        return Capacity;
+    }
+};
+
+}
+}
+
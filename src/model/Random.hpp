@@ -0,0 +1,155 @@
+/*
+ ___________________________________________
+|    _     ___                        _     |
+|   | |   |__ \                      | |    |
+|   | |__    ) |__ _  __ _  ___ _ __ | |_   |
+|   | '_ \  / // _` |/ _` |/ _ \ '_ \| __|  |  HTTP/2 AGENT FOR MOCK TESTING
+|   | | | |/ /| (_| | (_| |  __/ | | | |_   |  Version 0.0.z
+|   |_| |_|____\__,_|\__, |\___|_| |_|\__|  |  https://github.com/testillano/h2agent
+|                     __/ |                 |
+|                    |___/                  |
+|___________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace h2agent
+{
+namespace model
+{
+
+/**
+ * xoshiro256** generator (Blackman & Vigna), seeded through splitmix64.
+ *
+ * Each worker thread owns its own instance (see @ref randomGenerator), so drawing
+ * numbers involves no shared state nor locks, as opposed to the C library rand().
+ */
+class RandomGenerator {
+
+    std::uint64_t s_[4];
+
+    static std::uint64_t rotl(std::uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    static std::uint64_t splitmix64(std::uint64_t &x) {
+        std::uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+public:
+
+    explicit RandomGenerator(std::uint64_t seed = 0) {
+        this->seed(seed);
+    }
+
+    /** Reset the generator state from a 64-bit seed */
+    void seed(std::uint64_t seed) {
+        for (auto &word: s_) word = splitmix64(seed);
+    }
+
+    /** Next 64-bit pseudo-random value */
+    std::uint64_t next() {
+        const std::uint64_t result = rotl(s_[1] * 5, 7) * 9;
+        const std::uint64_t t = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = rotl(s_[3], 45);
+        return result;
+    }
+
+    /**
+     * Unbiased value in [0, n) by means of Lemire's multiply-and-reject method
+     *
+     * @param n Upper bound (excluded). Zero means the whole 64-bit range.
+     */
+    std::uint64_t below(std::uint64_t n) {
+        if (n == 0) return next();
+        unsigned __int128 m = (unsigned __int128)next() * n;
+        std::uint64_t low = (std::uint64_t)m;
+        if (low < n) {
+            const std::uint64_t threshold = -n % n;
+            while (low < threshold) {
+                m = (unsigned __int128)next() * n;
+                low = (std::uint64_t)m;
+            }
+        }
+        return (std::uint64_t)(m >> 64);
+    }
+};
+
+namespace random_detail
+{
+inline std::atomic<std::uint64_t> BaseSeed{0};
+inline std::atomic<std::uint64_t> ThreadOrdinal{0};
+}
+
+/**
+ * Sets the base seed for the thread generators
+ *
+ * Must be called at process start, before any worker thread draws a number. Every
+ * thread generator is then seeded from this base and the thread creation ordinal,
+ * so a given seed reproduces the same sequences for the same threads layout.
+ *
+ * @param seed Base seed. Zero (default) selects a time-based seed.
+ */
+inline void setRandomSeed(std::uint64_t seed) {
+    random_detail::BaseSeed.store(seed, std::memory_order_relaxed);
+}
+
+/** Thread-local generator, lazily seeded on first use */
+inline RandomGenerator &randomGenerator() {
+    thread_local RandomGenerator generator([] {
+        std::uint64_t base = random_detail::BaseSeed.load(std::memory_order_relaxed);
+        if (base == 0) base = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+        return base + 0x9e3779b97f4a7c15ULL * random_detail::ThreadOrdinal.fetch_add(1, std::memory_order_relaxed);
+    }());
+    return generator;
+}
+
+/** Unbiased random integer within the closed range [min, max] */
+inline std::int64_t randomInRange(std::int64_t min, std::int64_t max) {
+    return min + (std::int64_t)randomGenerator().below((std::uint64_t)max - (std::uint64_t)min + 1);
+}
+
+/** Unbiased random index within [0, size) */
+inline std::size_t randomIndex(std::size_t size) {
+    return (std::size_t)randomGenerator().below(size);
+}
+
+}
+}
+
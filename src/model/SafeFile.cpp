@@ -34,6 +34,12 @@ SOFTWARE.
 */
 
 #include <string>
+#include <algorithm>
+#include <cerrno>
+#include <climits> // IOV_MAX
+#include <cstring>
+#include <fcntl.h>
+#include <sys/uio.h> // writev
 
 #include <ert/tracing/Logger.hpp>
 
@@ -47,6 +53,30 @@ namespace h2agent
 namespace model
 {
 
+namespace
+{
+// Writes every buffer, resuming after partial writes and signal interruptions
+bool writeAll(int fd, struct iovec *iov, int iovcnt) {
+    while (iovcnt > 0) {
+        ssize_t n = ::writev(fd, iov, iovcnt);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        while (iovcnt > 0 && static_cast<size_t>(n) >= iov->iov_len) {
+            n -= iov->iov_len;
+            iov++;
+            iovcnt--;
+        }
+        if (iovcnt > 0) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + n;
+            iov->iov_len -= n;
+        }
+    }
+    return true;
+}
+}
+
 std::atomic<int> SafeFile::CurrentOpenedFiles(0);
 std::mutex SafeFile::MutexOpenedFiles;
 std::condition_variable SafeFile::OpenedFilesCV;
@@ -56,15 +86,16 @@ SafeFile::SafeFile (FileManager *fileManager, const std::string& path, boost::as
     io_context_(timersIoContext),
     file_manager_(fileManager),
     opened_(false),
-    read_cached_(false),
     timer_(nullptr)
 {
     max_open_files_ = sysconf(_SC_OPEN_MAX /* 1024 probably */) - 10 /* margin just in case the process open other files */;
-    open(mode);
+    // Reads use their own descriptor (opening a named pipe here would consume its writer):
+    if (mode & std::ios_base::out) open(mode);
 }
 
 SafeFile::~SafeFile() {
     close();
+    closeDescriptor();
     delete timer_;
 }
 
@@ -128,46 +159,128 @@ void SafeFile::close() {
 }
 
 void SafeFile::empty() {
+    closeDescriptor();
     close();
     open(std::ofstream::out | std::ofstream::trunc);
     close();
+    {
+        std::unique_lock<std::shared_mutex> lock(read_cache_mutex_);
+        read_cache_.reset();
+    }
     // metrics
     file_manager_->incrementObservedEmptyOperationCounter();
 }
 
-std::string SafeFile::read(bool &success, std::ios_base::openmode mode, bool cached) {
+bool SafeFile::readCached(const struct stat &st, std::string &data) {
 
-    // Check cached data:
-    if (cached && read_cached_) {
-        success = true;
-        return data_;
+    // Cached content is current:
+    std::shared_ptr<const ReadCache> cache;
+    {
+        std::shared_lock<std::shared_mutex> lock(read_cache_mutex_);
+        cache = read_cache_;
+    }
+    if (cache && cache->matches(st)) {
+        data = cache->data;
+        return true;
     }
 
-    std::string result;
-    success = false;
-
-    if (open(mode)) {
-        success = true;
-        std::string chunk;
-        while (std::getline (file_, chunk))
-        {
-            result += chunk;
+    // Read again (file created, modified, replaced or truncated). Status is taken before reading,
+    // so changes during the read are detected on the next call:
+    auto fresh = std::make_shared<ReadCache>();
+    struct stat current {};
+    bool result = readDescriptor(fresh->data, &current);
+    if (result && S_ISREG(current.st_mode) && current.st_size > 0) {
+        fresh->dev = current.st_dev;
+        fresh->ino = current.st_ino;
+        fresh->size = current.st_size;
+        fresh->mtime = current.st_mtim;
+        data = fresh->data;
+        cache = std::move(fresh);
+        LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("'%s' cached (%zu bytes)", path_.c_str(), data.size()), ERT_FILE_LOCATION));
+    }
+    else {
+        data = std::move(fresh->data);
+        cache.reset();
+    }
+
+    std::unique_lock<std::shared_mutex> lock(read_cache_mutex_);
+    read_cache_ = std::move(cache);
+    return result;
+}
+
+bool SafeFile::readDescriptor(std::string &data, struct stat *st) {
+
+    data.clear();
+
+    int fd = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        LOGWARNING(ert::tracing::Logger::warning(ert::tracing::Logger::asString("Failed to open '%s' for read: %s", path_.c_str(), strerror(errno)), ERT_FILE_LOCATION));
+        // metrics
+        file_manager_->incrementObservedErrorOpenOperationCounter();
+        return false;
+    }
+    // metrics
+    file_manager_->incrementObservedOpenOperationCounter();
+
+    // Regular files are read at once (plus the end of file). Sizes of other files are unknown:
+    struct stat status {};
+    if (!st) st = &status;
+    std::size_t chunk = 4096;
+    if (::fstat(fd, st) == 0 && S_ISREG(st->st_mode)) chunk = std::max(chunk, static_cast<std::size_t>(st->st_size) + 1);
+
+    bool result = true;
+    while (true) {
+        std::size_t offset = data.size();
+        data.resize(offset + chunk);
+        ssize_t n = ::read(fd, &data[offset], chunk);
+        data.resize(offset + std::max(n, ssize_t(0)));
+        if (n > 0) continue;
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) {
+            LOGWARNING(ert::tracing::Logger::warning(ert::tracing::Logger::asString("Failed to read '%s': %s", path_.c_str(), strerror(errno)), ERT_FILE_LOCATION));
+            data.clear();
+            result = false;
         }
-        LOGDEBUG(
-            std::string output;
-            h2agent::model::asAsciiString(result, output);
-            ert::tracing::Logger::debug(ert::tracing::Logger::asString("Read '%s': %s", path_.c_str(), output.c_str()), ERT_FILE_LOCATION);
-        );
+        break;
     }
 
-    // close the file after reading it:
+    ::close(fd);
+    // metrics
+    file_manager_->incrementObservedCloseOperationCounter();
+
+    return result;
+}
+
+std::string SafeFile::read(bool &success, std::ios_base::openmode mode, bool cached) {
+
+    std::string result;
+
+    // Stream possibly opened on construction is not used to read:
     close();
 
-    if (cached) {
-        read_cached_ = success;
-        data_ = std::move(result);
-        return data_;
+    read_cached_ = cached;
+
+    // Only non-empty regular files are cached (empty ones could be generated on read, as /proc entries):
+    struct stat st {};
+    if (cached && ::stat(path_.c_str(), &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        success = readCached(st, result);
     }
+    else {
+        if (cached) { // release former content
+            std::unique_lock<std::shared_mutex> lock(read_cache_mutex_);
+            read_cache_.reset();
+        }
+        success = readDescriptor(result);
+    }
+
+    // Text content has line feeds removed (as read line by line):
+    if (!(mode & std::ios::binary)) result.erase(std::remove(result.begin(), result.end(), '\n'), result.end());
+
+    LOGDEBUG(
+        std::string output;
+        h2agent::model::asAsciiString(result, output);
+        ert::tracing::Logger::debug(ert::tracing::Logger::asString("Read '%s': %s", path_.c_str(), output.c_str()), ERT_FILE_LOCATION);
+    );
 
     return result;
 }
@@ -181,7 +294,7 @@ nlohmann::json SafeFile::getJson() const {
     std::string::size_type size = file.tellg();
     if (size != std::string::npos /* -1 */) {
         result["bytes"] = (unsigned int)size;
-        result["state"] = (opened_ ? "opened":"closed");
+        result["state"] = ((opened_ || fd_ >= 0) ? "opened":"closed");
     }
     else {
         result["state"] = "missing";
@@ -190,6 +303,15 @@ nlohmann::json SafeFile::getJson() const {
 
     if (read_cached_) result["readCache"] = "true";
 
+    if (group_writes_ != 0 || queued_writes_ != 0) {
+        nlohmann::json writer;
+        writer["queuedWrites"] = queued_writes_.load();
+        writer["groupWrites"] = group_writes_.load();
+        writer["lastWriteLatencyUsecs"] = last_write_latency_us_.load();
+        writer["maxWriteLatencyUsecs"] = max_write_latency_us_.load();
+        result["backgroundWriter"] = writer;
+    }
+
     return result;
 }
 
@@ -220,6 +342,76 @@ void SafeFile::write (const std::string& data, unsigned int closeDelayUs) {
     }
 }
 
+bool SafeFile::openDescriptor() {
+    // Stream possibly opened on construction is not used for appends:
+    close();
+
+    int fd = ::open(path_.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        LOGWARNING(ert::tracing::Logger::warning(ert::tracing::Logger::asString("Failed to open '%s' for append: %s", path_.c_str(), strerror(errno)), ERT_FILE_LOCATION));
+        // metrics
+        file_manager_->incrementObservedErrorOpenOperationCounter();
+        return false;
+    }
+
+    fd_ = fd;
+    CurrentOpenedFiles++;
+    LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("'%s' opened for append (currently opened: %d)", path_.c_str(), CurrentOpenedFiles.load()), ERT_FILE_LOCATION));
+    // metrics
+    file_manager_->incrementObservedOpenOperationCounter();
+
+    return true;
+}
+
+bool SafeFile::appendGroup(const std::vector<std::string> &chunks, bool sync, std::chrono::steady_clock::time_point enqueued) {
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (fd_ < 0 && !openDescriptor()) return false;
+
+    std::vector<struct iovec> iov;
+    iov.reserve(std::min(chunks.size(), static_cast<std::size_t>(IOV_MAX)));
+    std::size_t k = 0;
+    while (k < chunks.size()) {
+        iov.clear();
+        for (; k < chunks.size() && iov.size() < IOV_MAX; k++) {
+            if (chunks[k].empty()) continue;
+            iov.push_back({const_cast<char*>(chunks[k].data()), chunks[k].size()});
+        }
+        if (!writeAll(fd_, iov.data(), static_cast<int>(iov.size()))) {
+            LOGWARNING(ert::tracing::Logger::warning(ert::tracing::Logger::asString("Failed to write into '%s': %s", path_.c_str(), strerror(errno)), ERT_FILE_LOCATION));
+            return false;
+        }
+    }
+    if (sync) ::fdatasync(fd_);
+
+    group_writes_++;
+    std::uint64_t latencyUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - enqueued).count();
+    last_write_latency_us_ = latencyUs;
+    if (latencyUs > max_write_latency_us_) max_write_latency_us_ = latencyUs; // single writer thread
+    LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("%zu writes appended into '%s' (latency: %lu usecs)", chunks.size(), path_.c_str(), latencyUs), ERT_FILE_LOCATION));
+
+    // metrics
+    file_manager_->incrementObservedWriteOperationCounter(chunks.size());
+    file_manager_->setObservedWriterLatency(latencyUs);
+
+    return true;
 }
+
+void SafeFile::closeDescriptor() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (fd_ < 0) return;
+
+    ::close(fd_);
+    fd_ = -1;
+    CurrentOpenedFiles--;
+    LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("'%s' closed for append (currently opened: %d)", path_.c_str(), CurrentOpenedFiles.load()), ERT_FILE_LOCATION));
+    // metrics
+    file_manager_->incrementObservedCloseOperationCounter();
+
+    lock.unlock();
+    OpenedFilesCV.notify_one();
 }
 
+}
+}
@@ -37,9 +37,15 @@ SOFTWARE.
 
 #include <fstream>
 #include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <vector>
 #include <unistd.h> // sysconf
+#include <sys/stat.h>
 
 #include <boost/asio.hpp>
 #include <boost/thread.hpp>
@@ -70,12 +76,35 @@ class SafeFile {
     boost::asio::steady_timer *timer_{};
     boost::asio::io_context *io_context_{};
 
-    std::string data_; // used for read cache, but never shown in json string representation (just in case it is huge)
-    bool read_cached_;
+    // Read cache: content kept together with the file status it was read with (read again when it changes):
+    struct ReadCache {
+        dev_t dev{};
+        ino_t ino{};
+        off_t size{};
+        struct timespec mtime {};
+        std::string data{};
+
+        bool matches(const struct stat &st) const {
+            return (st.st_dev == dev && st.st_ino == ino && st.st_size == size && st.st_mtim.tv_sec == mtime.tv_sec && st.st_mtim.tv_nsec == mtime.tv_nsec);
+        }
+    };
+    std::atomic<bool> read_cached_{false};
+    std::shared_ptr<const ReadCache> read_cache_;
+    std::shared_mutex read_cache_mutex_;
 
     FileManager *file_manager_{};
 
+    // Descriptor for appends from the background writer (@see FileWriter):
+    std::atomic<int> fd_{-1};
+    std::atomic<std::uint64_t> queued_writes_{0};
+    std::atomic<std::uint64_t> group_writes_{0};
+    std::atomic<std::uint64_t> last_write_latency_us_{0};
+    std::atomic<std::uint64_t> max_write_latency_us_{0};
+
     void delayedClose(unsigned int closeDelayUs);
+    bool openDescriptor();
+    bool readCached(const struct stat &st, std::string &data);
+    bool readDescriptor(std::string &data, struct stat *st = nullptr);
 
 public:
 
@@ -90,6 +119,7 @@ public:
     * regardless the close delay configured.
     * @param mode open mode. By default, text files and append is selected. You
     * could anyway add other flags, for example for binary dumps: std::ios::binary
+    * The file is opened on construction only for output modes.
     */
     SafeFile (FileManager *fileManager,
               const std::string& path,
@@ -98,6 +128,11 @@ public:
 
     ~SafeFile();
 
+    /** File path */
+    const std::string &getPath() const {
+        return path_;
+    }
+
     // Opened files control:
     static std::atomic<int> CurrentOpenedFiles;
     static std::mutex MutexOpenedFiles;
@@ -125,13 +160,20 @@ public:
 
     /**
     * Read the file content.
+    * Text content has line feeds removed. Binary content is read as is.
+    *
+    * With cache mode, the content of non-empty regular files is kept and served while
+    * the file status (device, inode, size, modification time) does not change, so
+    * modified, replaced or truncated files are read again. Without cache mode, or for
+    * other files (named pipes, devices, empty files as /proc entries), the file is read
+    * on every call.
     *
     * @param success success of the read operation.
     * @param mode open mode. By default, text files are assumed, but you could
     * pass binary flag: std::ios::binary
     * @param cached enable cache mode to retrieve data
     *
-    * @return Content read. Empty if failed to read. with cache enabled, empty data could be returned with success (no way no know if the file was empty or failed to read).
+    * @return Content read. Empty if failed to read.
     */
     std::string read(bool &success, std::ios_base::openmode mode = std::ifstream::in, bool cached = false);
 
@@ -160,6 +202,46 @@ public:
     * by 200000, that is to say, 0,00512 seconds = 5000 microseconds.
     */
     void write(const std::string& data, unsigned int closeDelayUs = 1000000);
+
+    /**
+    * Accounts a write queued in the background writer (@see FileWriter)
+    */
+    void queuedWrite() {
+        queued_writes_++;
+    }
+
+    /**
+    * Accounts writes completed by the background writer (once written and closed if needed)
+    *
+    * @param count writes completed
+    */
+    void writtenQueued(std::size_t count) {
+        queued_writes_ -= count;
+    }
+
+    /**
+    * Writes queued in the background writer and not yet written
+    */
+    std::uint64_t queuedWrites() const {
+        return queued_writes_;
+    }
+
+    /**
+    * Appends a group of queued writes with a single gathering write (@see FileWriter).
+    * The file is opened for append when needed, and kept open until closeDescriptor().
+    *
+    * @param chunks data to append, in order
+    * @param sync flush written data to the storage device (fdatasync)
+    * @param enqueued time when the oldest chunk was queued (write latency)
+    *
+    * @return Boolean about success operation.
+    */
+    bool appendGroup(const std::vector<std::string> &chunks, bool sync, std::chrono::steady_clock::time_point enqueued);
+
+    /**
+    * Close the descriptor used by appendGroup()
+    */
+    void closeDescriptor();
 };
 
 }
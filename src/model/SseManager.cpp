@@ -33,6 +33,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+#include <vector>
+
 #include <SseManager.hpp>
 
 #include <ert/tracing/Logger.hpp>
@@ -42,42 +44,176 @@ namespace h2agent
 namespace model
 {
 
-uint64_t SseManager::addConnection(std::unordered_set<std::string> keys, write_cb_t writeCb) {
+// Notifications distributed per connections lock:
+static constexpr std::size_t DispatchBatchSize = 256;
+
+SseManager::~SseManager() {
+    stop();
+}
+
+void SseManager::enableMetrics(ert::metrics::Metrics *metrics, const std::string &source) {
+
+    if (metrics) {
+        ert::metrics::labels_t familyLabels = {{"source", source}};
+
+        ert::metrics::counter_family_t& cf = metrics->addCounterFamily("h2agent_vault_events_counter", "Vault events not streamed as such to SSE subscribers in h2agent", familyLabels);
+        dropped_events_counter_ = &(cf.Add({{"result", "dropped"}}));
+        coalesced_events_counter_ = &(cf.Add({{"result", "coalesced"}}));
+    }
+}
+
+void SseManager::start() {
+    if (dispatcher_.joinable()) return;
+    running_ = true;
+    dispatcher_ = std::thread([this] { run(); });
+}
+
+void SseManager::stop() {
+    if (!dispatcher_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(dispatcher_mutex_);
+        running_ = false;
+    }
+    dispatcher_cv_.notify_one();
+    dispatcher_.join();
+}
+
+void SseManager::run() {
+    while (running_) {
+        if (dispatch() != 0) continue;
+
+        // Idle flag is raised before checking the queue, so a producer pushing meanwhile
+        // either is seen here or sees the flag (and then wakes us under the lock):
+        std::unique_lock<std::mutex> lock(dispatcher_mutex_);
+        dispatcher_idle_ = true;
+        dispatcher_cv_.wait(lock, [this] { return !running_ || !notifications_.empty(); });
+        dispatcher_idle_ = false;
+    }
+}
+
+uint64_t SseManager::addConnection(std::unordered_set<std::string> keys, bool coalesce, wake_cb_t wakeCb) {
     uint64_t id = next_id_.fetch_add(1);
     std::lock_guard<std::mutex> lock(mutex_);
-    connections_[id] = {std::move(keys), std::move(writeCb)};
-    LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("SSE connection added (id=%lu, keys=%zu, total=%zu)", id, connections_[id].keys.size(), connections_.size()), ERT_FILE_LOCATION));
+    Connection &conn = connections_[id];
+    conn.keys = std::move(keys);
+    conn.coalesce = coalesce;
+    conn.wakeCb = std::move(wakeCb);
+    connections_size_ = connections_.size();
+    LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("SSE connection added (id=%lu, keys=%zu, coalesce=%s, total=%zu)", id, conn.keys.size(), coalesce ? "true":"false", connections_.size()), ERT_FILE_LOCATION));
     return id;
 }
 
 void SseManager::removeConnection(uint64_t id) {
     std::lock_guard<std::mutex> lock(mutex_);
     connections_.erase(id);
+    connections_size_ = connections_.size();
     LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("SSE connection removed (id=%lu, remaining=%zu)", id, connections_.size()), ERT_FILE_LOCATION));
 }
 
+void SseManager::notify(const std::string &key, std::shared_ptr<const nlohmann::json> value) {
+    if (connections_size_ == 0) return;
+
+    notifications_.push(Notification{key, std::move(value)});
+
+    if (dispatcher_idle_) {
+        std::lock_guard<std::mutex> lock(dispatcher_mutex_);
+        dispatcher_cv_.notify_one();
+    }
+}
+
 void SseManager::notify(const std::string &key, const nlohmann::json &value) {
+    if (connections_size_ == 0) return;
+    notify(key, std::make_shared<const nlohmann::json>(value));
+}
+
+void SseManager::enqueue(Connection &conn, const std::string &key, const std::shared_ptr<const std::string> &event, std::uint64_t &dropped, std::uint64_t &coalesced) {
+
+    if (conn.coalesce) {
+        auto it = conn.queued.find(key);
+        if (it != conn.queued.end()) {
+            it->second->event = event; // last value wins, keeping the position of the pending one
+            coalesced++;
+            return;
+        }
+    }
+
+    if (conn.queue.size() >= ConnectionQueueCapacity) {
+        if (conn.coalesce) conn.queued.erase(conn.queue.front().key);
+        conn.queue.pop_front();
+        dropped++;
+    }
+
+    conn.queue.push_back(Pending{key, event});
+    if (conn.coalesce) conn.queued[key] = std::prev(conn.queue.end());
+}
+
+std::size_t SseManager::dispatch() {
+
+    std::vector<Notification> batch;
+    Notification notification;
+    while (batch.size() < DispatchBatchSize && notifications_.pop(notification)) {
+        batch.push_back(std::move(notification));
+    }
+    if (batch.empty()) return 0;
+
+    // Format SSE events out of the connections lock
+    std::vector<std::shared_ptr<const std::string>> events;
+    events.reserve(batch.size());
+    for (const auto &n: batch) {
+        nlohmann::json data;
+        data["key"] = n.key;
+        data["value"] = *n.value;
+        events.push_back(std::make_shared<const std::string>("event: vault-set\ndata: " + data.dump() + "\n\n"));
+    }
+
+    std::uint64_t dropped{}, coalesced{};
+    std::vector<wake_cb_t> wakes;
     {
         std::lock_guard<std::mutex> lock(mutex_);
-        if (connections_.empty()) return;
+        for (auto &[id, conn] : connections_) {
+            bool wasEmpty = conn.queue.empty();
+            for (std::size_t k = 0; k < batch.size(); k++) {
+                if (conn.keys.empty() || conn.keys.count(batch[k].key)) {
+                    enqueue(conn, batch[k].key, events[k], dropped, coalesced);
+                }
+            }
+            if (wasEmpty && !conn.queue.empty()) wakes.push_back(conn.wakeCb);
+        }
     }
 
-    // Format SSE event only if there are active connections
-    nlohmann::json data;
-    data["key"] = key;
-    data["value"] = value;
-    std::string event = "event: vault-set\ndata: " + data.dump() + "\n\n";
+    if (dropped != 0) {
+        dropped_events_ += dropped;
+        if (dropped_events_counter_) dropped_events_counter_->Increment(dropped);
+        LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("SSE events dropped (connection queues full): %lu", dropped), ERT_FILE_LOCATION));
+    }
+    if (coalesced != 0) {
+        coalesced_events_ += coalesced;
+        if (coalesced_events_counter_) coalesced_events_counter_->Increment(coalesced);
+    }
 
-    std::lock_guard<std::mutex> lock(mutex_);
-    for (auto &[id, conn] : connections_) {
-        if (conn.keys.empty() || conn.keys.count(key)) {
-            try {
-                conn.writeCb(event);
-            } catch (...) {
-                LOGWARNING(ert::tracing::Logger::warning(ert::tracing::Logger::asString("SSE write failed for connection %lu", id), ERT_FILE_LOCATION));
-            }
+    for (auto &wake: wakes) {
+        try {
+            wake();
+        } catch (...) {
+            LOGWARNING(ert::tracing::Logger::warning("SSE wake failed for connection", ERT_FILE_LOCATION));
         }
     }
+
+    return batch.size();
+}
+
+bool SseManager::take(uint64_t id, std::string &data) {
+    std::list<Pending> pending;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = connections_.find(id);
+        if (it == connections_.end() || it->second.queue.empty()) return false;
+        pending.swap(it->second.queue);
+        it->second.queued.clear();
+    }
+
+    for (const auto &p: pending) data += *(p.event);
+    return true;
 }
 
 size_t SseManager::activeConnections() const {
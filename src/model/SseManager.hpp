@@ -32,18 +32,26 @@ LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
-
 #pragma once
 
 #include <string>
+#include <list>
+#include <memory>
 #include <unordered_set>
 #include <unordered_map>
 #include <functional>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
 #include <atomic>
+#include <cstdint>
 
 #include <nlohmann/json.hpp>
 
+#include <ert/metrics/Metrics.hpp>
+
+#include <MpscQueue.hpp>
+
 namespace h2agent
 {
 namespace model
@@ -52,49 +60,134 @@ namespace model
 /**
  * Manages Server-Sent Events (SSE) connections for vault event streaming.
  *
- * Each connection watches a set of vault keys. When a vault mutation occurs,
- * matching connections receive the event via their write callback.
+ * Each connection watches a set of vault keys. Vault mutations are pushed into a
+ * lock-free queue (the writer thread never serializes nor waits for subscribers),
+ * and a dispatcher thread formats them and distributes them into a bounded queue
+ * per matching connection. Each connection drains its own queue when its stream is
+ * ready to send, so a slow subscriber only loses its own oldest events.
  */
 class SseManager
 {
 public:
-    using write_cb_t = std::function<void(const std::string &)>;
+    /** Callback to resume a connection stream when it has pending events (called from dispatcher). */
+    using wake_cb_t = std::function<void()>;
+
+    // Maximum pending events per connection (oldest are dropped beyond it):
+    static constexpr std::size_t ConnectionQueueCapacity = 1024;
 
     SseManager() = default;
-    ~SseManager() = default;
+    ~SseManager();
+
+    SseManager(const SseManager&) = delete;
+    SseManager& operator=(const SseManager&) = delete;
+
+    /**
+     * Enables metrics (dropped and coalesced events counters)
+     *
+     * @param metrics Optional metrics object to register counters
+     * @param source Source label
+     */
+    void enableMetrics(ert::metrics::Metrics *metrics, const std::string &source);
+
+    /** Starts the dispatcher thread. Without it, events are distributed by dispatch() calls. */
+    void start();
+
+    /** Stops the dispatcher thread (pending notifications are kept). */
+    void stop();
 
     /**
      * Registers an SSE connection.
      *
      * @param keys Set of vault keys this connection watches (empty = all keys)
-     * @param writeCb Callback to write SSE-formatted data to the stream
+     * @param coalesce Keep only the last value of a key while its event is pending (last-value-wins)
+     * @param wakeCb Callback to resume the stream when pending events are available
      * @return Connection ID for later removal
      */
-    uint64_t addConnection(std::unordered_set<std::string> keys, write_cb_t writeCb);
+    uint64_t addConnection(std::unordered_set<std::string> keys, bool coalesce, wake_cb_t wakeCb);
 
     /**
-     * Removes an SSE connection.
+     * Removes an SSE connection (pending events are discarded).
      */
     void removeConnection(uint64_t id);
 
     /**
-     * Notifies all matching connections of a vault mutation.
-     * Called by Vault on every write.
+     * Queues a vault mutation for matching connections.
+     * Called by Vault on every write: it costs an atomic load when nobody is subscribed.
      */
+    void notify(const std::string &key, std::shared_ptr<const nlohmann::json> value);
     void notify(const std::string &key, const nlohmann::json &value);
 
+    /**
+     * Extracts the pending events of a connection, already SSE-formatted.
+     *
+     * @param id Connection ID
+     * @param data Events text, appended by reference
+     *
+     * @return Boolean about something appended
+     */
+    bool take(uint64_t id, std::string &data);
+
+    /**
+     * Distributes queued notifications into connections queues (dispatcher thread).
+     *
+     * @return Number of notifications processed
+     */
+    std::size_t dispatch();
+
     /** Returns number of active SSE connections. */
     size_t activeConnections() const;
 
+    /** Returns number of events dropped because a connection queue was full. */
+    std::uint64_t droppedEvents() const {
+        return dropped_events_;
+    }
+
+    /** Returns number of events replaced by a newer value of the same key while pending. */
+    std::uint64_t coalescedEvents() const {
+        return coalesced_events_;
+    }
+
 private:
+    struct Notification {
+        std::string key;
+        std::shared_ptr<const nlohmann::json> value;
+    };
+
+    struct Pending {
+        std::string key;
+        std::shared_ptr<const std::string> event; // shared by every connection receiving it
+    };
+
     struct Connection {
         std::unordered_set<std::string> keys; // empty = watch all
-        write_cb_t writeCb;
+        bool coalesce{};
+        wake_cb_t wakeCb;
+        std::list<Pending> queue;
+        std::unordered_map<std::string, std::list<Pending>::iterator> queued; // coalescing index
     };
 
     mutable std::mutex mutex_;
     std::unordered_map<uint64_t, Connection> connections_;
+    std::atomic<size_t> connections_size_{0};
     std::atomic<uint64_t> next_id_{1};
+
+    // Notifications from vault writers to the dispatcher:
+    MpscQueue<Notification> notifications_;
+    std::thread dispatcher_;
+    std::mutex dispatcher_mutex_;
+    std::condition_variable dispatcher_cv_;
+    std::atomic<bool> dispatcher_idle_{false};
+    std::atomic<bool> running_{false};
+
+    std::atomic<std::uint64_t> dropped_events_{0};
+    std::atomic<std::uint64_t> coalesced_events_{0};
+
+    // metrics:
+    ert::metrics::counter_t *dropped_events_counter_{};
+    ert::metrics::counter_t *coalesced_events_counter_{};
+
+    void run();
+    void enqueue(Connection &conn, const std::string &key, const std::shared_ptr<const std::string> &event, std::uint64_t &dropped, std::uint64_t &coalesced);
 };
 
 }
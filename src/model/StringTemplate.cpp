@@ -0,0 +1,113 @@
+/*
+ ___________________________________________
+|    _     ___                        _     |
+|   | |   |__ \                      | |    |
+|   | |__    ) |__ _  __ _  ___ _ __ | |_   |
+|   | '_ \  / // _` |/ _` |/ _ \ '_ \| __|  |  HTTP/2 AGENT FOR MOCK TESTING
+|   | | | |/ /| (_| | (_| |  __/ | | | |_   |  Version 0.0.z
+|   |_| |_|____\__,_|\__, |\___|_| |_|\__|  |  https://github.com/testillano/h2agent
+|                     __/ |                 |
+|                    |___/                  |
+|___________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <StringTemplate.hpp>
+#include <Vault.hpp>
+
+
+namespace h2agent
+{
+namespace model
+{
+
+bool appendVariableValue(std::string &out, const std::string &name, const std::map<std::string,std::string> &vars, const Vault *vault) {
+
+    if (!vars.empty()) {
+        auto it = vars.find(name);
+        if (it != vars.end()) {
+            out += it->second;
+            return true;
+        }
+    }
+
+    if (vault && !vault->empty()) {
+        return vault->tryRead(name, [&out](const nlohmann::json &value) {
+            if (value.is_string()) out += value.get_ref<const std::string&>();
+            else if (!value.is_null()) out += value.dump();
+        });
+    }
+
+    return false;
+}
+
+void StringTemplate::compile(const std::string &str, bool withVariables) {
+
+    segments_.clear();
+    literals_size_ = 0;
+    has_variables_ = false;
+
+    // Same patterns as collected for transformations: @{[^{}]*}
+    std::string::size_type pos = withVariables ? 0 : std::string::npos, literal = 0;
+    while (pos != std::string::npos && (pos = str.find("@{", pos)) != std::string::npos) {
+        std::string::size_type end = str.find_first_of("{}", pos + 2);
+        if (end == std::string::npos) break;
+        if (str[end] == '{') { // nested brace: not a pattern
+            pos++;
+            continue;
+        }
+        if (pos > literal) {
+            segments_.push_back({str.substr(literal, pos - literal), false});
+            literals_size_ += pos - literal;
+        }
+        segments_.push_back({str.substr(pos + 2, end - pos - 2), true});
+        has_variables_ = true;
+        literal = pos = end + 1;
+    }
+    if (literal < str.size()) {
+        segments_.push_back({str.substr(literal), false});
+        literals_size_ += str.size() - literal;
+    }
+}
+
+void StringTemplate::render(std::string &out, const std::map<std::string,std::string> &vars, const Vault *vault) const {
+
+    out.clear();
+    out.reserve(literals_size_);
+
+    for (const auto &segment : segments_) {
+        if (!segment.variable) {
+            out += segment.text;
+        }
+        else if (!appendVariableValue(out, segment.text, vars, vault)) {
+            out += "@{";
+            out += segment.text;
+            out += '}';
+        }
+    }
+}
+
+}
+}
+
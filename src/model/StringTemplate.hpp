@@ -0,0 +1,108 @@
+/*
+ ___________________________________________
+|    _     ___                        _     |
+|   | |   |__ \                      | |    |
+|   | |__    ) |__ _  __ _  ___ _ __ | |_   |
+|   | '_ \  / // _` |/ _` |/ _ \ '_ \| __|  |  HTTP/2 AGENT FOR MOCK TESTING
+|   | | | |/ /| (_| | (_| |  __/ | | | |_   |  Version 0.0.z
+|   |_| |_|____\__,_|\__, |\___|_| |_|\__|  |  https://github.com/testillano/h2agent
+|                     __/ |                 |
+|                    |___/                  |
+|___________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace h2agent
+{
+namespace model
+{
+
+class Vault;
+
+/**
+ * Appends the value of a variable: scoped variables have priority over
+ * vault entries with the same name (read in place, without copy).
+ *
+ * @param out string where the value is appended
+ * @param name variable name
+ * @param vars scoped variables source map
+ * @param vault vault
+ *
+ * @return Boolean about variable found
+ */
+bool appendVariableValue(std::string &out, const std::string &name, const std::map<std::string,std::string> &vars, const Vault *vault);
+
+/**
+ * String with @{varname} patterns, split once into literal and variable segments.
+ *
+ * Rendering is done in one pass over the segments, instead of a search/replace
+ * over the whole string for every pattern. Variables not found are kept as they
+ * were written (@{varname}).
+ */
+class StringTemplate
+{
+    struct Segment {
+        std::string text{}; // literal, or variable name
+        bool variable{};
+    };
+
+    std::vector<Segment> segments_{};
+    std::size_t literals_size_{};
+    bool has_variables_{};
+
+public:
+
+    /**
+     * Compiles the template
+     *
+     * @param str string with @{varname} patterns
+     * @param withVariables false to take the whole string as literal (i.e. complex regular expressions)
+     */
+    void compile(const std::string &str, bool withVariables = true);
+
+    /** Template has variables to be replaced */
+    bool hasVariables() const {
+        return has_variables_;
+    }
+
+    /**
+     * Renders the template
+     *
+     * @param out rendered string, overwritten (its capacity is reused)
+     * @param vars scoped variables source map
+     * @param vault vault
+     */
+    void render(std::string &out, const std::map<std::string,std::string> &vars, const Vault *vault) const;
+};
+
+}
+}
+
@@ -353,6 +353,10 @@ bool Transformation::load(const nlohmann::json &j) {
     else if (std::regex_match(sourceSpec, matches, random)) { // range "<min>.<max>", i.e.: "-3.8", "0.100", "-15.+2", etc. These go to -> [source_i1_] and [source_i2_]
         source_i1_ = stoi(matches.str(1));
         source_i2_ = stoi(matches.str(2));
+        if (source_i1_ > source_i2_) {
+            ert::tracing::Logger::error(ert::tracing::Logger::asString("Invalid random range for: '%s' (minimum is greater than maximum)", sourceSpec.c_str()), ERT_FILE_LOCATION);
+            return false;
+        }
         source_type_ = SourceType::Random;
     }
     else if (std::regex_match(sourceSpec, matches, randomSet)) { // random set given by tokenized pipe-separated list of values
@@ -368,6 +372,7 @@ bool Transformation::load(const nlohmann::json &j) {
     else if (std::regex_match(sourceSpec, matches, timestamp)) { // unit (s: seconds, ms: milliseconds, us: microseconds, ns: nanoseconds)
         source_ = matches.str(1);
         source_type_ = SourceType::Timestamp;
+        source_i1_ = (source_ == "s") ? 0 : (source_ == "ms") ? 1 : (source_ == "us") ? 2 : 3;
     }
     else if (std::regex_match(sourceSpec, matches, strftime)) { // current date/time formatted by as described in https://www.cplusplus.com/reference/ctime/strftime/
         source_ = matches.str(1);
@@ -758,6 +763,40 @@ bool Transformation::load(const nlohmann::json &j) {
     collectVariablePatterns(target_, target_patterns_);
     collectVariablePatterns(target2_, target2_patterns_);
 
+    // Templates compiled once (filter ones, only when its patterns are collected):
+    source_template_.compile(source_);
+    filter_template_.compile(filter_, collectFilterPatterns);
+    target_template_.compile(target_);
+    target2_template_.compile(target2_);
+
+    // Json pointers compiled once (when no variables must be replaced on traffic):
+    try {
+        if ((source_type_ == SourceType::RequestBody || source_type_ == SourceType::ResponseBody) && !source_.empty() && source_patterns_.empty()) {
+            source_pointer_ = nlohmann::json::json_pointer(source_);
+            has_source_pointer_ = true;
+        }
+    }
+    catch (std::exception& e) {
+        LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("Source path '%s' kept to be evaluated on traffic: %s", source_.c_str(), e.what()), ERT_FILE_LOCATION));
+    }
+    try {
+        bool jsonTarget = (target_type_ >= TargetType::ResponseBodyJson_String && target_type_ <= TargetType::ResponseBodyJson_JsonString) ||
+                          (target_type_ >= TargetType::RequestBodyJson_String && target_type_ <= TargetType::RequestBodyJson_JsonString);
+        if (jsonTarget && target_patterns_.empty()) {
+            target_pointer_ = nlohmann::json::json_pointer(target_);
+            has_target_pointer_ = true;
+        }
+    }
+    catch (std::exception& e) {
+        LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("Target path '%s' kept to be evaluated on traffic: %s", target_.c_str(), e.what()), ERT_FILE_LOCATION));
+    }
+
+    // Math expression compiled once:
+    if (source_type_ == SourceType::Math) {
+        math_expression_ = std::make_shared<MathExpression>();
+        math_expression_->load(source_, source_patterns_);
+    }
+
     // onFilterFail:
     auto off_it = j.find("onFilterFail");
     if (off_it != j.end() && off_it->is_array()) {
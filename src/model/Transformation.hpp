@@ -40,10 +40,14 @@ SOFTWARE.
 #include <vector>
 #include <regex>
 #include <cstdint>
+#include <memory>
 
 
 #include <nlohmann/json.hpp>
 
+#include <MathExpression.hpp>
+#include <StringTemplate.hpp>
+
 
 namespace h2agent
 {
@@ -114,13 +118,18 @@ private:
     // RequestHeader, Math, Timestamp, Strftime, SVar, SGVar(key), Value, STxtFile(path), SBinFile (path), Command(expression)
     std::string source2_{}; // SGVar (optional json path)
     std::vector<std::string> source_tokenized_{}; // RandomSet, ServerEvent
-    int source_i1_{}, source_i2_{}; // Random
+    int source_i1_{}, source_i2_{}; // Random; Timestamp (source_i1_ as unit: 0: s, 1: ms, 2: us, 3: ns)
+    nlohmann::json::json_pointer source_pointer_{}; // RequestBody, ResponseBody (precompiled node path without variables)
+    bool has_source_pointer_{};
+    std::shared_ptr<MathExpression> math_expression_{}; // Math
 
     TargetType target_type_{};
     std::string target_{}; // ResponseBodyJson_String/Integer/Unsigned/Float/Boolean/Object/JsonString(empty: whole, path: node),
     // ResponseHeader, TVar, TGVar, OutState (foreign method part), TTxtFile(path), TBinFile (path), UDPSocket (path[.delayMs])
     std::vector<std::string> target_tokenized_{}; // ServerEventToPurge
     std::string target2_{}; // OutState (foreign uri part), TGVar (optional json path)
+    nlohmann::json::json_pointer target_pointer_{}; // ResponseBodyJson_*/RequestBodyJson_* (precompiled path without variables)
+    bool has_target_pointer_{};
 
     bool has_filter_{};
     FilterType filter_type_{};
@@ -146,6 +155,12 @@ private:
     std::map<std::string, std::string> target_patterns_;
     std::map<std::string, std::string> target2_patterns_;
 
+    // Precompiled templates for source, filter, target and target2 strings:
+    StringTemplate source_template_{};
+    StringTemplate filter_template_{};
+    StringTemplate target_template_{};
+    StringTemplate target2_template_{};
+
     std::vector<std::shared_ptr<Transformation>> on_filter_fail_;
 
 public:
@@ -176,6 +191,18 @@ public:
     int getSourceI2() const {
         return source_i2_;
     }
+    /** Gets source timestamp unit (0: s, 1: ms, 2: us, 3: ns) */
+    int getSourceTimestampUnit() const {
+        return source_i1_;
+    }
+    /** Gets precompiled source json pointer, nullptr when it must be built on every use */
+    const nlohmann::json::json_pointer *getSourcePointer() const {
+        return has_source_pointer_ ? &source_pointer_ : nullptr;
+    }
+    /** Gets precompiled math expression */
+    const MathExpression *getMathExpression() const {
+        return math_expression_.get();
+    }
 
     /** Gets target type */
     TargetType getTargetType() const {
@@ -193,6 +220,20 @@ public:
     const std::string &getTarget2() const {
         return target2_;
     }
+    /**
+     * Gets target json pointer: the precompiled one, or the one built from the provided path
+     * when it had variables to be replaced on traffic.
+     *
+     * @param target Target path with variables already replaced
+     * @param built Storage for the pointer built when it is not precompiled
+     *
+     * @return Json pointer for the target path
+     */
+    const nlohmann::json::json_pointer &getTargetPointer(const std::string &target, nlohmann::json::json_pointer &built) const {
+        if (has_target_pointer_) return target_pointer_;
+        built = nlohmann::json::json_pointer(target);
+        return built;
+    }
 
     /** Gets filter existence */
     bool hasFilter() const {
@@ -255,6 +296,23 @@ public:
     const std::map<std::string, std::string> &getTarget2Patterns() const {
         return target2_patterns_;
     }
+
+    /** Source template */
+    const StringTemplate &getSourceTemplate() const {
+        return source_template_;
+    }
+    /** Filter template */
+    const StringTemplate &getFilterTemplate() const {
+        return filter_template_;
+    }
+    /** Target template */
+    const StringTemplate &getTargetTemplate() const {
+        return target_template_;
+    }
+    /** Target2 template */
+    const StringTemplate &getTarget2Template() const {
+        return target2_template_;
+    }
 };
 
 }
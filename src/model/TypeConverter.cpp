@@ -70,27 +70,25 @@ void replaceVariables(std::string &str, const std::map<std::string, std::string>
     if (patterns.empty()) return;
     if (vars.empty() && vault->empty()) return;
 
-    std::map<std::string,std::string>::const_iterator it;
-
-    nlohmann::json aux{};
-
-    for (auto pit = patterns.begin(); pit != patterns.end(); pit++) {
-
-        // local var has priority over a vault with the same name
-        if (!vars.empty()) {
-            it = vars.find(pit->second);
-            if (it != vars.end()) {
-                searchReplaceAll(str, pit->first, it->second);
-                continue; // all is done
-            }
+    // One pass over the string (patterns as collected: @{[^{}]*}):
+    std::string result{}, name{};
+    result.reserve(str.size());
+    std::string::size_type pos = 0, literal = 0;
+    while ((pos = str.find("@{", pos)) != std::string::npos) {
+        std::string::size_type end = str.find_first_of("{}", pos + 2);
+        if (end == std::string::npos) break;
+        if (str[end] == '{') { // nested brace: not a pattern
+            pos++;
+            continue;
         }
-
-        if (!vault->empty()) { // this is much more efficient that find() == end() below
-            if (vault->tryGet(pit->second, aux)) {
-                searchReplaceAll(str, pit->first, jsonToString(aux));
-            }
-        }
-    }
+        result.append(str, literal, pos - literal);
+        name.assign(str, pos + 2, end - pos - 2);
+        if (!appendVariableValue(result, name, vars, vault)) result.append(str, pos, end - pos + 1); // kept when missing
+        literal = pos = end + 1;
+    }
+    if (literal == 0) return; // nothing replaced
+    result.append(str, literal, std::string::npos);
+    str.swap(result);
 }
 
 void TypeConverter::setString(const std::string &str) {
@@ -128,6 +126,13 @@ void TypeConverter::setBoolean(bool boolean) {
     LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("Boolean value: %s", b_value_ ? "true":"false"), ERT_FILE_LOCATION));
 }
 
+void TypeConverter::setStringReplacingVariables(const StringTemplate &strTemplate, const std::map<std::string,std::string> &vars, Vault *vault) {
+    clear();
+    strTemplate.render(s_value_, vars, vault);
+    native_type_ = NativeType::String;
+    LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("String value: %s", s_value_.c_str()), ERT_FILE_LOCATION));
+}
+
 void TypeConverter::setStringReplacingVariables(const std::string &str, const std::map<std::string, std::string> &patterns, const std::map<std::string,std::string> &vars, Vault *vault) {
 
     setString(str);
@@ -141,7 +146,7 @@ const std::string &TypeConverter::getString(bool &success) {
     switch (native_type_) {
     case NativeType::Object:
     {
-        s_value_ = j_value_.dump();
+        s_value_ = jsonValue().dump();
         break;
     }
     case NativeType::Integer:
@@ -416,7 +421,7 @@ const nlohmann::json &TypeConverter::getObject(bool &success) {
     LOGDEBUG(
         std::string msg;
     if (success) {
-    msg = ert::tracing::Logger::asString("Json object value: %s", j_value_.dump().c_str());
+    msg = ert::tracing::Logger::asString("Json object value: %s", jsonValue().dump().c_str());
     }
     else {
         msg = ert::tracing::Logger::asString("Unable to get json object from source: %s", asString().c_str());
@@ -425,7 +430,7 @@ const nlohmann::json &TypeConverter::getObject(bool &success) {
     ert::tracing::Logger::debug(msg, ERT_FILE_LOCATION);
     );
 
-    return j_value_;
+    return jsonValue();
 }
 
 void TypeConverter::clear() {
@@ -435,6 +440,8 @@ void TypeConverter::clear() {
     f_value_ = 0;
     b_value_ = false;
     j_value_.clear();
+    j_shared_.reset();
+    j_shared_value_ = nullptr;
     native_type_ = NativeType::String;
 }
 
@@ -465,35 +472,91 @@ bool TypeConverter::setObject(const nlohmann::json &jsonSource, const std::strin
         }
     }
 
-    if (j_value_.is_object() || j_value_.is_array()) {
+    assignNativeType();
+    return true;
+}
+
+bool TypeConverter::setObject(const nlohmann::json &jsonSource, const nlohmann::json::json_pointer &pointer) {
+    clear();
+
+    LOGDEBUG(
+        std::string msg = ert::tracing::Logger::asString("Json path: %s | Json object: %s", pointer.to_string().c_str(), jsonSource.dump().c_str());
+        ert::tracing::Logger::debug(msg, ERT_FILE_LOCATION);
+    );
+
+    try {
+        j_value_ = jsonSource.at(pointer);
+        if (j_value_.empty()) return false; // null extracted (path not found)
+    }
+    catch (std::exception& e)
+    {
+        ert::tracing::Logger::error(e.what(), ERT_FILE_LOCATION);
+        return false;
+    }
+
+    assignNativeType();
+    return true;
+}
+
+bool TypeConverter::setObject(std::shared_ptr<const nlohmann::json> jsonSource, const std::string &path) {
+    clear();
+    if (!jsonSource) return false;
+
+    LOGDEBUG(
+        std::string msg = ert::tracing::Logger::asString("Json path: %s | Json object: %s", path.c_str(), jsonSource->dump().c_str());
+        ert::tracing::Logger::debug(msg, ERT_FILE_LOCATION);
+    );
+
+    const nlohmann::json *value = jsonSource.get();
+    if (!path.empty()) {
+        try {
+            value = &(jsonSource->at(nlohmann::json::json_pointer(path)));
+            if (value->empty()) return false; // null extracted (path not found)
+        }
+        catch (std::exception& e)
+        {
+            ert::tracing::Logger::error(e.what(), ERT_FILE_LOCATION);
+            return false;
+        }
+    }
+
+    j_shared_ = std::move(jsonSource);
+    j_shared_value_ = value;
+
+    assignNativeType();
+    return true;
+}
+
+void TypeConverter::assignNativeType() {
+
+    const nlohmann::json &value = jsonValue();
+
+    if (value.is_object() || value.is_array()) {
         native_type_ = NativeType::Object;
     }
-    else if (j_value_.is_string()) {
-        s_value_ = j_value_;
+    else if (value.is_string()) {
+        s_value_ = value;
         native_type_ = NativeType::String;
     }
-    else if (j_value_.is_number_unsigned()) { // this condition here (before integer), because integer also becomes true for unsigned source
-        u_value_ = j_value_;
+    else if (value.is_number_unsigned()) { // this condition here (before integer), because integer also becomes true for unsigned source
+        u_value_ = value;
         native_type_ = NativeType::Unsigned;
     }
-    else if (j_value_.is_number_integer()) {
-        i_value_ = j_value_;
+    else if (value.is_number_integer()) {
+        i_value_ = value;
         native_type_ = NativeType::Integer;
     }
-    else if (j_value_.is_number_float()) {
-        f_value_ = j_value_;
+    else if (value.is_number_float()) {
+        f_value_ = value;
         native_type_ = NativeType::Float;
     }
-    else if (j_value_.is_boolean()) {
-        b_value_ = j_value_;
+    else if (value.is_boolean()) {
+        b_value_ = value;
         native_type_ = NativeType::Boolean;
     }
     //else {
     //    ert::tracing::Logger::error("Unrecognized json pointer value format", ERT_FILE_LOCATION); // this shouldn't happen as all the possible formats are checked above
-    //    return false;
     //}
-
-    return true;
 }
 
 std::string TypeConverter::asString() {
@@ -505,7 +568,7 @@ std::string TypeConverter::asString() {
        << " | " << ((getNativeType() == NativeType::Unsigned) ? "UNSIGNED":"Unsigned") << ": " << u_value_
        << " | " << ((getNativeType() == NativeType::Float) ? "FLOAT":"Float") << ": " << f_value_
        << " | " << ((getNativeType() == NativeType::Boolean) ? "BOOLEAN":"Boolean") << ": " << (b_value_ ? "true":"false")
-       << " | " << ((getNativeType() == NativeType::Object) ? "OBJECT":"Object") << ": " << j_value_.dump();
+       << " | " << ((getNativeType() == NativeType::Object) ? "OBJECT":"Object") << ": " << jsonValue().dump();
 
     return (ss.str());
 }
@@ -40,7 +40,9 @@ SOFTWARE.
 #include <string>
 #include <sstream>
 #include <cstdint>
+#include <memory>
 #include <Vault.hpp>
+#include <StringTemplate.hpp>
 
 namespace h2agent
 {
@@ -82,9 +84,19 @@ private:
     double f_value_{}; // float number
     bool b_value_{}; // boolean
     nlohmann::json j_value_{}; // json object
+    std::shared_ptr<const nlohmann::json> j_shared_{}; // shared json document (not copied) ...
+    const nlohmann::json *j_shared_value_{}; // ... and json object extracted from it
 
     NativeType native_type_{};
 
+    // Json object extracted (shared or owned):
+    const nlohmann::json &jsonValue() const {
+        return j_shared_value_ ? *j_shared_value_ : j_value_;
+    }
+
+    // Native type (and scalar container) for the json value extracted:
+    void assignNativeType();
+
 public:
 
     /**
@@ -119,6 +131,15 @@ public:
     */
     void setStringReplacingVariables(const std::string &str, const std::map<std::string, std::string> &patterns, const std::map<std::string,std::string> &vars, Vault *vault);
 
+    /**
+    * Sets string to vault rendering a precompiled template
+    *
+    * @param strTemplate template rendered over the internal string (no intermediate copies)
+    * @param vars scoped variables source map
+    * @param vault vault
+    */
+    void setStringReplacingVariables(const StringTemplate &strTemplate, const std::map<std::string,std::string> &vars, Vault *vault);
+
     /**
     * Sets integer to vault
     *
@@ -163,6 +184,31 @@ public:
     */
     bool setObject(const nlohmann::json &jsonSource, const std::string &path);
 
+    /**
+    * Sets object to vault from a precompiled json pointer
+    *
+    * Same as @see setObject(), but the path is not parsed again on every call.
+    *
+    * @param jsonSource Json Document from which extract the information
+    * @param pointer Json pointer to extract from provided json document
+    *
+    * @return Return boolean for successful extraction (path is found), false otherwise (null extracted)
+    */
+    bool setObject(const nlohmann::json &jsonSource, const nlohmann::json::json_pointer &pointer);
+
+    /**
+    * Sets object to vault from a shared read-only json document
+    *
+    * Same as @see setObject(), but the document is retained instead of copied, and
+    * the extracted object is a reference into it.
+    *
+    * @param jsonSource Shared json document from which extract the information
+    * @param path Json path to extract from provided json document
+    *
+    * @return Return boolean for successful extraction (path is found), false otherwise (null extracted)
+    */
+    bool setObject(std::shared_ptr<const nlohmann::json> jsonSource, const std::string &path);
+
     // getters
 
     /**
@@ -34,6 +34,8 @@ SOFTWARE.
 */
 
 #include <string>
+#include <stdexcept>
+#include <charconv>
 
 #include <ert/tracing/Logger.hpp>
 
@@ -47,37 +49,164 @@ namespace h2agent
 namespace model
 {
 
+namespace
+{
+const std::string ResponseDelayPrefix = "__core:response-delay-ms:";
+
+// Reception identifier for reserved dynamic response delay variables:
+bool responseDelayReception(const std::string &variable, std::uint64_t &receptionId) {
+    if (variable.compare(0, ResponseDelayPrefix.size(), ResponseDelayPrefix) != 0) return false;
+
+    const char *begin = variable.data() + ResponseDelayPrefix.size();
+    const char *end = variable.data() + variable.size();
+    auto [ptr, ec] = std::from_chars(begin, end, receptionId);
+    return (begin != end && ec == std::errc() && ptr == end);
+}
+}
+
 Vault::Vault() {
     vault_schema_.setJson(h2agent::adminSchemas::vault); // won't fail
 }
 
+bool Vault::loadResponseDelay(const std::string &variable, const nlohmann::json &value) {
+
+    std::uint64_t receptionId{};
+    if (!responseDelayReception(variable, receptionId)) return false;
+
+    // Parsed once here, instead of on every delay check:
+    std::int64_t ms{};
+    std::string valStr = jsonToString(value);
+    try {
+        ms = std::stoll(valStr);
+        LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("Dynamic response delay loaded (%s = %s)", variable.c_str(), valStr.c_str()), ERT_FILE_LOCATION));
+    } catch (const std::invalid_argument& e) {
+        LOGWARNING(ert::tracing::Logger::warning(ert::tracing::Logger::asString("Variable value is not a number (%s = %s)", variable.c_str(), valStr.c_str()), ERT_FILE_LOCATION));
+    } catch (const std::out_of_range& e) {
+        LOGWARNING(ert::tracing::Logger::warning(ert::tracing::Logger::asString("Variable value invalid range (%s = %s)", variable.c_str(), valStr.c_str()), ERT_FILE_LOCATION));
+    }
+
+    if (response_delays_.add(receptionId, ms)) {
+        LOGWARNING(ert::tracing::Logger::warning(ert::tracing::Logger::asString("Dynamic response delays table overflow (capacity %zu): older delay is released", response_delays_.capacity()), ERT_FILE_LOCATION));
+    }
+
+    return true;
+}
+
+bool Vault::removeResponseDelay(const std::string &variable, bool &exists) {
+
+    std::uint64_t receptionId{};
+    if (!responseDelayReception(variable, receptionId)) return false;
+
+    std::int64_t ms{};
+    exists = response_delays_.take(receptionId, ms);
+    return true;
+}
+
+bool Vault::findResponseDelay(const std::string &variable, bool &exists, std::int64_t &ms) const {
+
+    std::uint64_t receptionId{};
+    if (!responseDelayReception(variable, receptionId)) return false;
+
+    exists = (!response_delays_.empty() && response_delays_.find(receptionId, ms));
+    return true;
+}
+
+std::int64_t Vault::getResponseDelayMs(std::uint64_t receptionId) const {
+
+    std::int64_t result{};
+    if (!response_delays_.empty()) response_delays_.find(receptionId, result);
+    return result;
+}
+
+void Vault::releaseResponseDelay(std::uint64_t receptionId) {
+
+    if (response_delays_.empty()) return;
+
+    std::int64_t ms{};
+    response_delays_.take(receptionId, ms);
+}
+
+void Vault::remove(const std::string &variable, bool &exists) {
+
+    if (removeResponseDelay(variable, exists)) return;
+    Map::remove(variable, exists);
+}
+
+bool Vault::clear() {
+
+    bool result = !response_delays_.empty();
+    response_delays_.clear();
+    return (Map::clear() || result);
+}
+
+nlohmann::json Vault::get(const std::string &variable, bool &exists) const {
+
+    std::int64_t ms{};
+    if (findResponseDelay(variable, exists, ms)) return (exists ? nlohmann::json(ms) : nlohmann::json{});
+
+    ValueType value = Map::get(variable, exists);
+    return (exists ? *value : nlohmann::json{});
+}
+
+bool Vault::tryGet(const std::string &variable, nlohmann::json &value) const {
+
+    ValueType result{};
+    if (!tryGet(variable, result)) return false;
+    value = *result;
+    return true;
+}
+
+bool Vault::tryGet(const std::string &variable, ValueType &value) const {
+
+    bool exists{};
+    std::int64_t ms{};
+    if (findResponseDelay(variable, exists, ms)) {
+        if (exists) value = std::make_shared<const nlohmann::json>(ms);
+        return exists;
+    }
+
+    return Map::tryGet(variable, value);
+}
+
+void Vault::add(const std::string &variable, nlohmann::json value) {
+    if (loadResponseDelay(variable, value)) return;
+    Map::add(variable, std::make_shared<const nlohmann::json>(std::move(value)));
+}
+
 void Vault::load(const std::string &variable, const nlohmann::json &value) {
-    add(variable, value);
-    if (wait_manager_) wait_manager_->notify();
-    if (sse_manager_) sse_manager_->notify(variable, value);
+    if (loadResponseDelay(variable, value)) return;
+    auto stored = std::make_shared<const nlohmann::json>(value);
+    Map::add(variable, stored);
+    if (wait_manager_) wait_manager_->notify(variable, *stored);
+    if (sse_manager_) sse_manager_->notify(variable, stored);
 }
 
 void Vault::load(const std::string &variable, nlohmann::json &&value) {
-    add(variable, std::move(value));
-    if (wait_manager_) wait_manager_->notify();
-    if (sse_manager_) {
-        nlohmann::json v;
-        tryGet(variable, v);
-        sse_manager_->notify(variable, v);
-    }
+    if (loadResponseDelay(variable, value)) return;
+    auto stored = std::make_shared<const nlohmann::json>(std::move(value));
+    Map::add(variable, stored);
+    if (wait_manager_) wait_manager_->notify(variable, *stored);
+    if (sse_manager_) sse_manager_->notify(variable, stored);
 }
 
 void Vault::loadAtPath(const std::string &variable, const std::string &path, const nlohmann::json &value) {
-    modifyOrInsert(variable, [&](nlohmann::json &current) {
-        if (!current.is_object()) current = nlohmann::json::object();
-        current[nlohmann::json::json_pointer(path)] = value;
-    });
-    if (wait_manager_) wait_manager_->notify();
-    if (sse_manager_) {
-        nlohmann::json v;
-        tryGet(variable, v);
-        sse_manager_->notify(variable, v);
+    nlohmann::json::json_pointer pointer(path);
+    std::uint64_t receptionId{};
+    if (responseDelayReception(variable, receptionId)) {
+        LOGWARNING(ert::tracing::Logger::warning(ert::tracing::Logger::asString("Dynamic response delay is not a json document: path '%s' ignored for '%s'", path.c_str(), variable.c_str()), ERT_FILE_LOCATION));
+        return;
     }
+    ValueType stored{};
+    modifyOrInsert(variable, [&](ValueType &current) {
+        // Copy-on-write: readers holding the former value are not affected
+        auto next = (current && current->is_object()) ? std::make_shared<nlohmann::json>(*current) : std::make_shared<nlohmann::json>(nlohmann::json::object());
+        if (!current) current = next; // never leave an empty entry
+        (*next)[pointer] = value;
+        current = std::move(next);
+        stored = current;
+    });
+    if (wait_manager_) wait_manager_->notify(variable, *stored);
+    if (sse_manager_) sse_manager_->notify(variable, stored);
 }
 
 bool Vault::loadJson(const nlohmann::json &j) {
@@ -99,10 +228,12 @@ bool Vault::loadJson(const nlohmann::json &j) {
     // Map::add(map_t) expects unordered_map<string, json>, which nlohmann::json
     // object iteration provides directly.
     for (auto it = j.begin(); it != j.end(); ++it) {
-        add(it.key(), it.value());
-        if (sse_manager_) sse_manager_->notify(it.key(), it.value());
+        if (loadResponseDelay(it.key(), it.value())) continue;
+        auto stored = std::make_shared<const nlohmann::json>(it.value());
+        Map::add(it.key(), stored);
+        if (wait_manager_) wait_manager_->notify(it.key(), *stored);
+        if (sse_manager_) sse_manager_->notify(it.key(), stored);
     }
-    if (wait_manager_) wait_manager_->notify();
 
     return true;
 }
@@ -113,7 +244,13 @@ std::string Vault::asJsonString() const {
 }
 
 nlohmann::json Vault::getJson() const {
-    return Map::getJson();
+
+    nlohmann::json result = nlohmann::json::object();
+    forEach([&result](const std::string &variable, const ValueType &value) {
+        result[variable] = *value;
+    });
+
+    return result;
 }
 
 }
@@ -35,9 +35,12 @@ SOFTWARE.
 
 #pragma once
 
+#include <cstdint>
+
 #include <nlohmann/json.hpp>
 
 #include <Map.hpp>
+#include <PendingTable.hpp>
 #include <JsonSchema.hpp>
 
 
@@ -61,17 +64,93 @@ inline std::string jsonToString(const nlohmann::json &j) {
 
 /**
  * This class stores the vault list.
+ *
+ * Values are immutable json documents shared by reference: readers take a pointer (no deep copy
+ * under the lock), and writers publish a new document (copy-on-write for partial updates).
+ *
+ * The underlying map is not exposed: every accessor routes reserved dynamic response delays
+ * ('__core:response-delay-ms:<recvseq>') to their own table, so they can't be bypassed.
  */
-class Vault : public Map<std::string, nlohmann::json>
+class Vault : private Map<std::string, std::shared_ptr<const nlohmann::json>, TrafficMapStripes>
 {
     h2agent::jsonschema::JsonSchema vault_schema_{};
     WaitManager *wait_manager_{};
     SseManager *sse_manager_{};
 
+    // Reserved dynamic response delays ('__core:response-delay-ms:<recvseq>') are kept apart, in a
+    // per-reception table released at stream close. Capacity bounds the delayed streams in flight:
+    // beyond it, oldest delays are dropped (their answers are released).
+    static constexpr std::size_t ResponseDelaysCapacity = 16384;
+    PendingTable<std::int64_t, ResponseDelaysCapacity> response_delays_{};
+
+    // Returns true if the variable is a reserved dynamic response delay (then it is processed)
+    bool loadResponseDelay(const std::string &variable, const nlohmann::json &value);
+    bool removeResponseDelay(const std::string &variable, bool &exists);
+    bool findResponseDelay(const std::string &variable, bool &exists, std::int64_t &ms) const;
+
 public:
     Vault();
     ~Vault() = default;
 
+    using ValueType = std::shared_ptr<const nlohmann::json>;
+
+    using Map::size;
+    using Map::empty;
+
+    /**
+     * Gets a copy of the variable value (prefer tryGet() pointer variant on traffic paths)
+     *
+     * @param variable variable name
+     * @param exists boolean about variable existence, by reference
+     *
+     * @return Json value (null when missing)
+     */
+    nlohmann::json get(const std::string &variable, bool &exists) const;
+
+    /**
+     * Gets a copy of the variable value (prefer tryGet() pointer variant on traffic paths)
+     *
+     * @param variable variable name
+     * @param value json value copied (untouched when missing)
+     *
+     * @return Boolean about variable existence
+     */
+    bool tryGet(const std::string &variable, nlohmann::json &value) const;
+
+    /**
+     * Gets the shared variable value (no deep copy)
+     *
+     * @param variable variable name
+     * @param value shared json value (untouched when missing)
+     *
+     * @return Boolean about variable existence
+     */
+    bool tryGet(const std::string &variable, ValueType &value) const;
+
+    /**
+     * Reads a variable value in place (reader is called out of the lock)
+     *
+     * @param variable variable name
+     * @param reader function receiving a const reference to the json value
+     *
+     * @return Boolean about variable existence (reader is only called when found)
+     */
+    template<typename Reader>
+    bool tryRead(const std::string &variable, Reader&& reader) const {
+        ValueType value{};
+        if (!tryGet(variable, value)) return false;
+        reader(*value);
+        return true;
+    }
+
+    /**
+     * Adds a variable without notifications (see load())
+     *
+     * @param variable variable name
+     * @param value json value to store
+     */
+    void add(const std::string &variable, nlohmann::json value);
+
     void setWaitManager(WaitManager *p) { wait_manager_ = p; }
     void setSseManager(SseManager *p) { sse_manager_ = p; }
 
@@ -84,6 +163,37 @@ public:
     void load(const std::string &variable, const nlohmann::json &value);
     void load(const std::string &variable, nlohmann::json &&value);
 
+    /**
+     * Removes variable
+     *
+     * @param variable variable name
+     * @param exists boolean about variable existence, by reference
+     */
+    void remove(const std::string &variable, bool &exists);
+
+    /**
+     * Clears every variable (reserved dynamic response delays included)
+     *
+     * @return Boolean about something deleted
+     */
+    bool clear();
+
+    /**
+     * Gets the dynamic response delay for a reception ('__core:response-delay-ms:<recvseq>')
+     *
+     * @param receptionId Reception identifier (server sequence)
+     *
+     * @return Delay in milliseconds (zero when missing or invalid)
+     */
+    std::int64_t getResponseDelayMs(std::uint64_t receptionId) const;
+
+    /**
+     * Releases the dynamic response delay for a reception (stream closed)
+     *
+     * @param receptionId Reception identifier (server sequence)
+     */
+    void releaseResponseDelay(std::uint64_t receptionId);
+
     /**
      * Loads a value at a specific path within an existing json variable.
      * Creates the variable as an empty object if it does not exist.
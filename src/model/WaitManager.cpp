@@ -44,66 +44,168 @@ namespace h2agent
 namespace model
 {
 
-bool WaitManager::waitForVault(const std::string &key, const nlohmann::json &targetValue,
-                                        unsigned int timeoutMs,
-                                        nlohmann::json &resultValue, nlohmann::json &previousValue) {
+std::uint64_t WaitManager::watch(const std::string &key, const nlohmann::json &targetValue, completion_cb_t cb) {
 
-    timeoutMs = std::min(timeoutMs, MAX_TIMEOUT_MS);
+    nlohmann::json previousValue = nullptr;
+    std::uint64_t id{};
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
 
-    std::unique_lock<std::mutex> lock(mutex_);
+        if (shutdown_ || active_waiters_ >= MAX_WAITERS) {
+            return 0; // caller should return 429
+        }
 
-    if (active_waiters_ >= MAX_WAITERS) {
-        return false; // caller should return 429
+        id = next_id_++;
+        // Accounted before capturing the value: a concurrent write stored after the capture
+        // cannot skip notify() then, and it will find this waiter once the lock is released.
+        active_waiters_++;
+
+        Vault::ValueType current{};
+        bool exists = vault_ && vault_->tryGet(key, current);
+        if (exists) previousValue = *current;
+
+        // Check if already satisfied
+        if (!(exists && !targetValue.is_null() && previousValue == targetValue)) {
+            waiters_[key].push_back(Waiter{id, targetValue, previousValue, std::move(cb)});
+            return id;
+        }
+        active_waiters_--;
     }
 
-    if (shutdown_) return false;
+    cb(true, previousValue, previousValue);
+    return id;
+}
 
-    // Capture initial value
-    previousValue = nullptr;
-    if (vault_) vault_->tryGet(key, previousValue);
+bool WaitManager::cancel(const std::string &key, std::uint64_t id, nlohmann::json &previousValue) {
+    std::lock_guard<std::mutex> lock(mutex_);
 
-    // Check if already satisfied
-    if (!targetValue.is_null() && previousValue == targetValue) {
-        resultValue = previousValue;
-        return true;
-    }
+    auto it = waiters_.find(key);
+    if (it == waiters_.end()) return false;
 
-    active_waiters_++;
-    bool result = cv_.wait_for(lock, std::chrono::milliseconds(timeoutMs), [&] {
-        if (shutdown_) return true;
-        resultValue = nullptr;
-        bool exists = vault_ && vault_->tryGet(key, resultValue);
-        if (targetValue.is_null()) {
-            return exists && resultValue != previousValue;
-        }
-        return exists && resultValue == targetValue;
+    auto &list = it->second;
+    auto w = std::find_if(list.begin(), list.end(), [id](const Waiter &waiter) {
+        return waiter.id == id;
     });
+    if (w == list.end()) return false;
+
+    previousValue = std::move(w->previousValue);
+    list.erase(w);
+    if (list.empty()) waiters_.erase(it);
     active_waiters_--;
 
-    if (shutdown_) return false;
+    return true;
+}
+
+bool WaitManager::waitForVault(const std::string &key, const nlohmann::json &targetValue,
+                                        unsigned int timeoutMs,
+                                        nlohmann::json &resultValue, nlohmann::json &previousValue,
+                                        bool *rejected) {
+
+    if (rejected) *rejected = false;
+    timeoutMs = std::min(timeoutMs, MAX_TIMEOUT_MS);
 
-    if (!result) {
-        resultValue = nullptr;
-        if (vault_) vault_->tryGet(key, resultValue);
+    if (blocking_waiters_.fetch_add(1) >= MAX_BLOCKING_WAITERS) {
+        blocking_waiters_--;
+        if (rejected) *rejected = true;
+        return false; // caller should return 429
+    }
+    struct BlockingSlot {
+        std::atomic<size_t> &counter;
+        ~BlockingSlot() { counter--; }
+    } slot{blocking_waiters_};
+
+    struct Completion {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool done{};
+        bool met{};
+        nlohmann::json value;
+        nlohmann::json previousValue;
+    } completion;
+
+    auto complete = [&completion](bool met, const nlohmann::json &value, const nlohmann::json &previous) {
+        std::lock_guard<std::mutex> lock(completion.mutex);
+        completion.met = met;
+        completion.value = value;
+        completion.previousValue = previous;
+        completion.done = true;
+        completion.cv.notify_one();
+    };
+
+    std::uint64_t id = watch(key, targetValue, complete);
+    if (id == 0) { // too many waiters or shutdown
+        if (rejected) *rejected = true;
+        return false;
     }
 
-    return result;
+    std::unique_lock<std::mutex> lock(completion.mutex);
+    if (!completion.cv.wait_for(lock, std::chrono::milliseconds(timeoutMs), [&completion] { return completion.done; })) {
+        lock.unlock();
+        if (cancel(key, id, previousValue)) {
+            resultValue = nullptr;
+            if (vault_) vault_->tryGet(key, resultValue);
+            return false;
+        }
+        // Completed meanwhile: the callback is in progress
+        lock.lock();
+        completion.cv.wait(lock, [&completion] { return completion.done; });
+    }
+
+    resultValue = std::move(completion.value);
+    previousValue = std::move(completion.previousValue);
+    return completion.met;
 }
 
 void WaitManager::shutdown() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    shutdown_ = true;
-    cv_.notify_all();
+    std::unordered_map<std::string, std::vector<Waiter>> aborted;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shutdown_ = true;
+        aborted.swap(waiters_);
+        active_waiters_ = 0;
+    }
+
+    for (auto &kv: aborted) {
+        for (auto &waiter: kv.second) waiter.cb(false, nullptr, waiter.previousValue);
+    }
 }
 
-void WaitManager::notify() {
-    cv_.notify_all();
+void WaitManager::notify(const std::string &key, const nlohmann::json &value) {
+    if (active_waiters_ == 0) return; // nobody waiting: nothing to lock
+
+    std::vector<Waiter> completed;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = waiters_.find(key);
+        if (it == waiters_.end()) return;
+
+        // Single pass compaction: satisfied waiters are moved out, the rest keep their order
+        auto &list = it->second;
+        auto kept = list.begin();
+        for (auto w = list.begin(); w != list.end(); ++w) {
+            bool met = w->targetValue.is_null() ? (value != w->previousValue) : (value == w->targetValue);
+            if (met) completed.push_back(std::move(*w));
+            else if (kept != w) *kept++ = std::move(*w);
+            else ++kept;
+        }
+        list.erase(kept, list.end());
+        if (list.empty()) waiters_.erase(it);
+        active_waiters_ -= completed.size();
+    }
+
+    // Callbacks out of the lock (they may register new waiters)
+    for (auto &waiter: completed) waiter.cb(true, value, waiter.previousValue);
 }
 
 size_t WaitManager::activeWaiters() const {
     return active_waiters_;
 }
 
+size_t WaitManager::blockingWaiters() const {
+    return blocking_waiters_;
+}
+
 bool WaitManager::isFull() const {
     return active_waiters_ >= MAX_WAITERS;
 }
@@ -36,9 +36,14 @@ SOFTWARE.
 #pragma once
 
 #include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
 #include <mutex>
 #include <condition_variable>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 
 #include <nlohmann/json.hpp>
 
@@ -50,23 +55,44 @@ namespace model
 class Vault;
 
 /**
- * Manages blocking wait (long-poll) for vault entry changes.
+ * Manages waits (long-poll) for vault entry changes.
  *
- * Provides condition-variable-based synchronization so that external
- * orchestrators can block until a vault entry changes, eliminating
- * polling loops.
+ * Waiters are registered per vault key and completed through a callback when
+ * their own key is written with a value satisfying the wait condition, so no
+ * thread needs to be parked per waiter. Vault writes on keys nobody waits for
+ * only cost an atomic load.
  */
 class WaitManager
 {
-    std::mutex mutex_;
-    std::condition_variable cv_;
-    size_t active_waiters_{};
+public:
+    /**
+     * Completion callback: invoked once per accepted waiter, outside internal locks.
+     * The first argument is false only on shutdown.
+     */
+    using completion_cb_t = std::function<void(bool met, const nlohmann::json &value, const nlohmann::json &previousValue)>;
+
+private:
+    struct Waiter {
+        std::uint64_t id;
+        nlohmann::json targetValue; // null = any change
+        nlohmann::json previousValue;
+        completion_cb_t cb;
+    };
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::vector<Waiter>> waiters_; // key -> waiters registered on it
+    std::atomic<size_t> active_waiters_{};
+    std::atomic<size_t> blocking_waiters_{}; // waitForVault() callers
+    std::atomic<std::uint64_t> next_id_{1};
     bool shutdown_{};
 
     Vault *vault_{};
 
 public:
-    static constexpr size_t MAX_WAITERS = 32;
+    static constexpr size_t MAX_WAITERS = 4096;
+    // Each blocking wait holds an admin worker thread: keep room for the writes releasing them
+    // (admin worker threads default to MAX_BLOCKING_WAITERS + 1).
+    static constexpr size_t MAX_BLOCKING_WAITERS = 32;
     static constexpr unsigned int MAX_TIMEOUT_MS = 300000; // 5 minutes
 
     WaitManager() = default;
@@ -74,35 +100,67 @@ public:
 
     void setVault(Vault *p) { vault_ = p; }
 
-    /** Signals all waiters to abort and prevents new waits. */
+    /** Completes all waiters as not met and prevents new waits. */
     void shutdown();
 
     /**
-     * Blocks until a vault entry changes (any change or specific value).
+     * Registers an asynchronous waiter on a vault entry (any change or specific value).
+     * Timeout is up to the caller, which must cancel the waiter when it expires.
+     *
+     * @param key Variable key to watch.
+     * @param targetValue If non-null, wait until variable equals this value.
+     *                    If null, wait for any change from current value.
+     * @param cb Completion callback. Invoked synchronously (before returning) when
+     *           the condition is already satisfied.
+     *
+     * @return waiter identifier (to cancel it), or 0 if rejected because of too
+     *         many waiters (caller should use 429) or shutdown.
+     */
+    std::uint64_t watch(const std::string &key, const nlohmann::json &targetValue, completion_cb_t cb);
+
+    /**
+     * Removes a pending waiter without completing it (i.e. on timeout).
+     *
+     * @param key Variable key watched.
+     * @param id Waiter identifier returned by watch().
+     * @param previousValue Filled with the value captured when the waiter was registered.
+     *
+     * @return true if it was pending, false if already completed (or unknown).
+     */
+    bool cancel(const std::string &key, std::uint64_t id, nlohmann::json &previousValue);
+
+    /**
+     * Blocks the calling thread until a vault entry changes (any change or specific value).
      *
      * @param key Variable key to watch.
-     * @param targetValue If non-empty, wait until variable equals this value.
-     *                    If empty, wait for any change from current value.
+     * @param targetValue If non-null, wait until variable equals this value.
+     *                    If null, wait for any change from current value.
      * @param timeoutMs Maximum wait time in milliseconds (capped at MAX_TIMEOUT_MS).
      * @param resultValue Filled with the variable value on return.
      * @param previousValue Filled with the value captured before waiting.
+     * @param rejected If provided, set to true when the wait is rejected because there are
+     *                 MAX_BLOCKING_WAITERS blocking waits or MAX_WAITERS waiters (caller should use 429).
      *
-     * @return true if condition met, false on timeout.
-     *         Returns false if too many waiters (caller should use 429).
+     * @return true if condition met, false on timeout or rejection.
      */
     bool waitForVault(const std::string &key, const nlohmann::json &targetValue,
                                unsigned int timeoutMs,
-                               nlohmann::json &resultValue, nlohmann::json &previousValue);
+                               nlohmann::json &resultValue, nlohmann::json &previousValue,
+                               bool *rejected = nullptr);
 
-    /** Wakes all waiters (called after vault entry mutation). */
-    void notify();
+    /** Completes the waiters of a key satisfied by its new value (called after vault entry mutation). */
+    void notify(const std::string &key, const nlohmann::json &value);
 
     /** Returns current number of active waiters. */
     size_t activeWaiters() const;
 
+    /** Returns current number of blocking waits (waitForVault() callers). */
+    size_t blockingWaiters() const;
+
     /** Returns true if waiter limit reached. */
     bool isFull() const;
 };
 
 }
 }
+
@@ -34,6 +34,7 @@ SOFTWARE.
 */
 
 #include <fstream>
+#include <algorithm>
 #include <regex>
 #include <ctype.h>
 
@@ -89,68 +90,84 @@ bool string2uint64andSign(const std::string &input, std::uint64_t &output, bool
     return result;
 }
 
-std::map<std::string, std::string> extractQueryParameters(const std::string &queryParams, std::string *sortedQueryParameters, char separator) {
-    std::map<std::string, std::string> result, resultOriginal;
+bool splitQueryParameters(std::string_view queryParams, std::vector<QueryParameter> &parameters, char separator) {
+    parameters.clear();
 
-    if (queryParams.empty()) return result;
+    if (queryParams.empty()) return true;
 
     // Inspired in https://github.com/ben-zen/uri-library
     // Loop over the query string looking for '&'s (maybe ';'s), then check each one for
-    // an '=' to find keys and values; if there's not an '=' then the key
-    // will have an empty value in the map.
-    size_t pos = 0;
-    size_t qpair_end = queryParams.find_first_of(separator);
-    do
-    {
-        std::string qpair = queryParams.substr(pos, ((qpair_end != std::string::npos) ? (qpair_end - pos) : std::string::npos));
-        size_t key_value_divider = qpair.find_first_of('=');
-        std::string key = qpair.substr(0, key_value_divider);
-        std::string value;
-        if (key_value_divider != std::string::npos)
-        {
-            value = qpair.substr((key_value_divider + 1));
+    // an '=' to find keys and values; if there's not an '=' then the key will have an
+    // empty value. A trailing separator gives an empty key, as any empty pair.
+    std::size_t pos = 0;
+    while (true) {
+        std::size_t qpair_end = queryParams.find(separator, pos);
+        std::string_view qpair = queryParams.substr(pos, (qpair_end != std::string_view::npos) ? (qpair_end - pos) : std::string_view::npos);
+        std::size_t key_value_divider = qpair.find('=');
+        if (key_value_divider != std::string_view::npos) {
+            parameters.push_back(QueryParameter{qpair.substr(0, key_value_divider), qpair.substr(key_value_divider + 1)});
         }
-
-        if (result.count(key) != 0)
-        {
-            ert::tracing::Logger::error("Cannot normalize URI query parameters: repeated key found", ERT_FILE_LOCATION);
-            result.clear();
-            return result;
+        else {
+            parameters.push_back(QueryParameter{qpair, std::string_view{}});
         }
 
-        // Store original value when sorted query parameters list is requested:
-        if (sortedQueryParameters) {
-            resultOriginal.emplace(key, value);
+        if (qpair_end == std::string_view::npos) break;
+        pos = qpair_end + 1;
+    }
+
+    // Sorted by key (few parameters: cheaper than a map), so repeated keys are contiguous:
+    std::sort(parameters.begin(), parameters.end(), [](const QueryParameter &a, const QueryParameter &b) {
+        return a.key < b.key;
+    });
+    auto repeated = std::adjacent_find(parameters.begin(), parameters.end(), [](const QueryParameter &a, const QueryParameter &b) {
+        return a.key == b.key;
+    });
+    if (repeated != parameters.end()) {
+        ert::tracing::Logger::error("Cannot normalize URI query parameters: repeated key found", ERT_FILE_LOCATION);
+        parameters.clear();
+        return false;
+    }
+
+    return true;
+}
+
+void appendQueryParameters(std::string &out, const std::vector<QueryParameter> &parameters, char separator) {
+    for (auto it = parameters.begin(); it != parameters.end(); it++) {
+        if (it != parameters.begin()) out += separator;
+        out += it->key;
+        if (!it->value.empty()) {
+            out += '=';
+            out += it->value;
         }
+    }
+}
 
+std::map<std::string, std::string> queryParametersMap(const std::vector<QueryParameter> &parameters) {
+    std::map<std::string, std::string> result;
+
+    for (const auto &parameter : parameters) {
+        std::string value(parameter.value);
         std::string valueDecoded = ert::http2comm::URLFunctions::decode(value);
         bool decoded = (valueDecoded != value);
-        if (decoded) {
-            value = valueDecoded;
-        }
-        LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("Extracted query parameter %s = %s%s", key.c_str(), value.c_str(), (decoded ? " (decoded)":"")), ERT_FILE_LOCATION));
-        result.emplace(key, value);
-        pos = ((qpair_end != std::string::npos) ? (qpair_end + 1) : std::string::npos);
-        qpair_end = queryParams.find_first_of(separator, pos);
+        LOGDEBUG(ert::tracing::Logger::debug(ert::tracing::Logger::asString("Extracted query parameter %s = %s%s", std::string(parameter.key).c_str(), valueDecoded.c_str(), (decoded ? " (decoded)":"")), ERT_FILE_LOCATION));
+        result.emplace_hint(result.end(), parameter.key, std::move(valueDecoded)); // already sorted
     }
-    while ((qpair_end != std::string::npos) || (pos != std::string::npos));
+
+    return result;
+} // LCOV_EXCL_LINE
+
+std::map<std::string, std::string> extractQueryParameters(const std::string &queryParams, std::string *sortedQueryParameters, char separator) {
+    std::vector<QueryParameter> parameters;
+    splitQueryParameters(queryParams, parameters, separator);
 
     // Build sorted literal:
     if (sortedQueryParameters) {
-        std::string &ref = *sortedQueryParameters;
-        ref.clear();
-        ref.reserve(queryParams.size());
-        for(auto it = resultOriginal.begin(); it != resultOriginal.end(); it ++) {
-            if (it != resultOriginal.begin()) ref += separator;
-            ref += it->first; // key
-            if (!it->second.empty()) {
-                ref += "=";
-                ref += it->second;
-            }
-        }
+        sortedQueryParameters->clear();
+        sortedQueryParameters->reserve(queryParams.size());
+        appendQueryParameters(*sortedQueryParameters, parameters, separator);
     }
 
-    return result;
+    return queryParametersMap(parameters);
 } // LCOV_EXCL_LINE
 
 bool getFileContent(const std::string &filePath, std::string &content)
@@ -360,6 +377,41 @@ std::string fixMetricsName(const std::string &in) {
     return result;
 }
 
+std::string regexLiteralPrefix(const std::string &rgx) {
+
+    // Top-level alternation makes any prefix unreliable ('a|b' fully matches 'b'):
+    int depth = 0;
+    bool inBracket = false;
+    for (std::size_t k = 0; k < rgx.size(); k++) {
+        char c = rgx[k];
+        if (c == '\\') {
+            k++; // skip escaped character
+            continue;
+        }
+        if (inBracket) {
+            if (c == ']') inBracket = false;
+            continue;
+        }
+        if (c == '[') inBracket = true;
+        else if (c == '(') depth++;
+        else if (c == ')') depth--;
+        else if (c == '|' && depth == 0) return std::string{};
+    }
+
+    static const std::string specials = "\\^$.|?*+()[]{}";
+    std::string result{};
+    for (char c : rgx) {
+        if (specials.find(c) != std::string::npos) {
+            // Quantifiers allowing zero occurrences make optional the previous literal:
+            if ((c == '?' || c == '*' || c == '{') && !result.empty()) result.pop_back();
+            break;
+        }
+        result += c;
+    }
+
+    return result;
+}
+
 }
 }
 
@@ -37,6 +37,8 @@ SOFTWARE.
 
 #include <map>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <nghttp2/asio_http2_server.h>
 
@@ -80,6 +82,44 @@ void aggregateKeyPart(std::string &key, const std::string &k1, const std::string
  */
 bool string2uint64andSign(const std::string &input, std::uint64_t &output, bool &negative);
 
+/**
+ * Query parameter as views over the original query string (value is kept percent-encoded)
+ */
+struct QueryParameter {
+    std::string_view key;
+    std::string_view value;
+};
+
+/**
+ * Tokenizes query parameters string into key/value views, sorted by key.
+ * No allocation is done when parameters vector capacity is enough, so it should be reused.
+ *
+ * @param queryParams query parameters URI part (? not included), which must outlive the views
+ * @param parameters sorted key/value views, filled by reference
+ * @param separator key/values separator, ampersand by default
+ *
+ * @return False when repeated keys are found (then, parameters vector is cleared)
+ */
+bool splitQueryParameters(std::string_view queryParams, std::vector<QueryParameter> &parameters, char separator = '&' /* maybe ';' */);
+
+/**
+ * Appends query parameters literal (original values, key alone when value is empty)
+ *
+ * @param out string to append
+ * @param parameters key/value views (sorted with splitQueryParameters() to normalize)
+ * @param separator key/values separator, ampersand by default
+ */
+void appendQueryParameters(std::string &out, const std::vector<QueryParameter> &parameters, char separator = '&' /* maybe ';' */);
+
+/**
+ * Materializes query parameters map with decoded values
+ *
+ * @param parameters key/value views
+ *
+ * @return Map of key/values for query parameters
+ */
+std::map<std::string, std::string> queryParametersMap(const std::vector<QueryParameter> &parameters);
+
 /**
  * Tokenizes query parameters string into key/values
  *
@@ -175,5 +215,16 @@ bool jsonConstraint(const nlohmann::json &received, const nlohmann::json &expect
  */
 std::string fixMetricsName(const std::string &in);
 
+/**
+ * Extracts the literal prefix which any string fully matching the regular expression must start with.
+ * The analysis is conservative: it stops at the first special character, drops the last literal
+ * when it is followed by an optional quantifier, and returns empty string for top-level alternations.
+ *
+ * @param rgx Regular expression (ECMAScript grammar)
+ *
+ * @return Literal prefix (empty when no prefix can be guaranteed)
+ */
+std::string regexLiteralPrefix(const std::string &rgx);
+
 }
 }
@@ -35,6 +35,8 @@ SOFTWARE.
 
 #pragma once
 
+#include <string>
+#include <string_view>
 
 #include <ert/tracing/Logger.hpp>
 
@@ -185,6 +187,65 @@ public:
     }
 };
 
+/**
+ * Composite key view ('k1#k2[#k3]', same aggregation than calculateStringKey()).
+ *
+ * Keeps the parts as views, so lookups on maps indexed by aggregated keys don't need to build
+ * (allocate) a new string for every search (see Map::tryGet()). Parts must outlive the view.
+ * This only covers the key: regular expression searches still allocate within std::regex_match.
+ */
+class CompositeKeyView {
+
+    std::string_view k1_{};
+    std::string_view k2_{};
+    std::string_view k3_{};
+    bool aggregated_{}; // k1 is already the whole key
+
+public:
+
+    /**
+     * Constructor for key parts
+     *
+     * @param k1 First part
+     * @param k2 Second part
+     * @param k3 Third part (optional: omitted when empty)
+     */
+    CompositeKeyView(std::string_view k1, std::string_view k2, std::string_view k3 = {}): k1_(k1), k2_(k2), k3_(k3) {}
+
+    /**
+     * Constructor for already aggregated key
+     *
+     * @param key Data key
+     */
+    CompositeKeyView(const DataKey &key): k1_(key.getKey()), aggregated_(true) {}
+
+    /**
+     * Aggregated key length (without building it)
+     *
+     * @return Number of characters
+     */
+    std::size_t size() const {
+        if (aggregated_) return k1_.size();
+        return k1_.size() + 1 + k2_.size() + (k3_.empty() ? 0 : 1 + k3_.size());
+    }
+
+    /**
+     * Builds the aggregated key
+     *
+     * @param key Aggregated key output (its capacity is reused)
+     */
+    void compose(std::string &key) const {
+        key.assign(k1_.data(), k1_.size());
+        if (aggregated_) return;
+        key += '#';
+        key.append(k2_.data(), k2_.size());
+        if (!k3_.empty()) {
+            key += '#';
+            key.append(k3_.data(), k3_.size());
+        }
+    }
+};
+
 /**
  * Event key
  *
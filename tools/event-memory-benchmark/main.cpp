@@ -0,0 +1,223 @@
+/*
+ ____________________________________________________________________________________________________________________________________________
+|                        _                                                           _                     _                          _      |
+|                       | |                                                         | |                   | |                        | |     |
+|    _____   _____ _ __ | |_   __   _ __ ___   ___ _ __ ___   ___  _ __ _   _   __  | |__   ___ _ __   ___| |__  _ __ ___   __ _ _ __| | __  |
+|   / _ \ \ / / _ \ '_ \| __| |__| | '_ ` _ \ / _ \ '_ ` _ \ / _ \| '__| | | | |__| | '_ \ / _ \ '_ \ / __| '_ \| '_ ` _ \ / _` | '__| |/ /  |  BENCHMARK UTILITY TO REPORT THE HEAP MEMORY USED PER STORED SERVER EVENT
+|  |  __/\ V /  __/ | | | |_       | | | | | |  __/ | | | | | (_) | |  | |_| |      | |_) |  __/ | | | (__| | | | | | | | | (_| | |  |   <   |  Version 0.0.z
+|   \___| \_/ \___|_| |_|\__|      |_| |_| |_|\___|_| |_| |_|\___/|_|   \__, |      |_.__/ \___|_| |_|\___|_| |_|_| |_| |_|\__,_|_|  |_|\_\  |  https://github.com/testillano/h2agent (tools/event-memory-benchmark)
+|                                                                        __/ |                                                               |
+|                                                                       |___/                                                                |
+|____________________________________________________________________________________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <libgen.h> // basename
+#include <malloc.h> // mallinfo2
+
+// Standard
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+
+#include <nghttp2/asio_http2_server.h>
+#include <nlohmann/json.hpp>
+
+#include <DataPart.hpp>
+#include <MockServerEventsHistory.hpp>
+#include <MockServerEvent.hpp>
+
+
+const char* progname;
+
+/**
+ * Server event record as stored before slab pools, interned strings and compact headers
+ */
+struct LegacyServerEvent {
+    std::string previous_state{};
+    std::string state{};
+    std::uint64_t reception_timestamp_us{};
+    unsigned int response_status_code{};
+    nghttp2::asio_http2::header_map request_headers{};
+    nghttp2::asio_http2::header_map response_headers{};
+    std::atomic<bool> json_built{};
+    nlohmann::json json{};
+    std::mutex json_mutex{};
+    h2agent::model::DataPart request_body_data_part{};
+    h2agent::model::DataPart response_body_data_part{};
+    std::uint64_t recv_seq{};
+    unsigned int response_delay_ms{};
+    std::string virtual_origin_coming_from_method{};
+    std::string virtual_origin_coming_from_uri{};
+    std::atomic<std::uint64_t> sending_timestamp_us{};
+};
+
+////////////////////////////
+// Command line functions //
+////////////////////////////
+
+void usage(int rc)
+{
+    auto& ss = (rc == 0) ? std::cout : std::cerr;
+
+    ss << "Usage: " << progname << " [options]\n\nOptions:\n\n"
+
+       << "[-e|--events <value>]\n"
+       << "  Number of events stored. Defaults to 200000.\n\n"
+
+       << "[-k|--keys <value>]\n"
+       << "  Number of different events history keys (method & uri). Defaults to 100.\n\n"
+
+       << "[-h|--help]\n"
+       << "  This help.\n\n"
+
+       << "Stores the same server events with the former record layout (one heap allocation per\n"
+       << "string, header and shared object) and with the current one (slab pooled events, interned\n"
+       << "strings and compact headers), printing the heap memory used per stored event.\n\n"
+
+       << "Examples: " << '\n'
+       << "   " << progname << '\n'
+       << "   " << progname << " --events 1000000 --keys 10" << '\n'
+
+       << '\n';
+
+    exit(rc);
+}
+
+bool cmdOptionExists(char** begin, char** end, const std::string& option,
+                     std::string& value)
+{
+    char** itr = std::find(begin, end, option);
+    bool exists = (itr != end);
+
+    if (exists && ++itr != end)
+    {
+        value = *itr;
+    }
+
+    return exists;
+}
+
+std::size_t heapInUse()
+{
+    malloc_trim(0);
+    return mallinfo2().uordblks;
+}
+
+
+///////////////////
+// MAIN FUNCTION //
+///////////////////
+
+int main(int argc, char* argv[])
+{
+    progname = basename(argv[0]);
+
+    // Parse command-line ///////////////////////////////////////////////////////////////////////////////////////
+    int events = 200000;
+    int keys = 100;
+
+    std::string value;
+
+    if (cmdOptionExists(argv, argv + argc, "-h", value)
+            || cmdOptionExists(argv, argv + argc, "--help", value))
+    {
+        usage(EXIT_SUCCESS);
+    }
+
+    try {
+        if (cmdOptionExists(argv, argv + argc, "-e", value)
+                || cmdOptionExists(argv, argv + argc, "--events", value))
+        {
+            events = std::stoi(value);
+        }
+
+        if (cmdOptionExists(argv, argv + argc, "-k", value)
+                || cmdOptionExists(argv, argv + argc, "--keys", value))
+        {
+            keys = std::stoi(value);
+        }
+    }
+    catch (std::exception &e) {
+        usage(EXIT_FAILURE);
+    }
+
+    if (events <= 0 || keys <= 0) usage(EXIT_FAILURE);
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Typical traffic event:
+    nghttp2::asio_http2::header_map requestHeaders{
+        {"content-type", {"application/json", false}}, {"user-agent", {"h2load nghttp2/1.48.0", false}},
+        {"x-correlation-id", {"3f2a0c1e-6d4b-4f7a-9b1c-8e5d2a7c4b10", false}}
+    };
+    nghttp2::asio_http2::header_map responseHeaders{
+        {"content-type", {"application/json", false}}, {"x-version", {"1.0.0", false}}
+    };
+    h2agent::model::DataPart requestBody(std::string("{\"id\":\"0123456789\",\"node\":\"h2agent\",\"items\":[1,2,3,4,5]}"));
+    std::string responseBody("{\"result\":\"success\",\"code\":0}");
+    std::vector<std::string> uris;
+    for (int k = 0; k < keys; k++) uris.push_back("/app/v1/resources/" + std::to_string(k));
+
+    std::cout << "Events: " << events << " | Keys: " << keys << "\n\n";
+
+    // Former layout:
+    std::size_t base = heapInUse();
+    {
+        std::vector<std::vector<std::shared_ptr<LegacyServerEvent>>> histories(keys);
+        for (int k = 0; k < events; k++) {
+            auto event = std::make_shared<LegacyServerEvent>();
+            event->previous_state = "initial";
+            event->state = "initial";
+            event->reception_timestamp_us = k;
+            event->response_status_code = 200;
+            event->request_headers = requestHeaders;
+            event->response_headers = responseHeaders;
+            event->request_body_data_part.assign(requestBody.str());
+            event->response_body_data_part.assign(responseBody);
+            event->recv_seq = k;
+            histories[k % keys].push_back(event);
+        }
+        double perEvent = static_cast<double>(heapInUse() - base) / events;
+        std::cout << std::setw(30) << std::left << "former layout (bytes/event): " << std::fixed << std::setprecision(1) << perEvent << '\n';
+    }
+
+    // Current layout:
+    base = heapInUse();
+    {
+        std::vector<std::shared_ptr<h2agent::model::MockServerEventsHistory>> histories;
+        for (int k = 0; k < keys; k++) histories.push_back(std::make_shared<h2agent::model::MockServerEventsHistory>(h2agent::model::DataKey("POST", uris[k])));
+        for (int k = 0; k < events; k++) {
+            histories[k % keys]->loadEvent("initial", "initial", std::chrono::microseconds(k), 200, requestHeaders, responseHeaders, requestBody, responseBody, k, 0, true);
+        }
+        double perEvent = static_cast<double>(heapInUse() - base) / events;
+        std::cout << std::setw(30) << std::left << "current layout (bytes/event): " << std::fixed << std::setprecision(1) << perEvent << '\n';
+    }
+
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,208 @@
+/*
+ ________________________________________________________________________________________
+|                                _                     _                          _      |
+|                               | |                   | |                        | |     |
+|   _ __ ___   __ _ _ __    __  | |__   ___ _ __   ___| |__  _ __ ___   __ _ _ __| | __  |
+|  | '_ ` _ \ / _` | '_ \  |__| | '_ \ / _ \ '_ \ / __| '_ \| '_ ` _ \ / _` | '__| |/ /  |  BENCHMARK UTILITY TO COMPARE SINGLE-LOCK AND LOCK-STRIPED MAPS
+|  | | | | | | (_| | |_) |      | |_) |  __/ | | | (__| | | | | | | | | (_| | |  |   <   |  Version 0.0.z
+|  |_| |_| |_|\__,_| .__/       |_.__/ \___|_| |_|\___|_| |_|_| |_| |_|\__,_|_|  |_|\_\  |  https://github.com/testillano/h2agent (tools/map-benchmark)
+|                  | |                                                                   |
+|                  |_|                                                                   |
+|________________________________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <libgen.h> // basename
+
+// Standard
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <random>
+#include <algorithm>
+
+#include <nlohmann/json.hpp>
+
+#include <Map.hpp>
+
+
+const char* progname;
+
+////////////////////////////
+// Command line functions //
+////////////////////////////
+
+void usage(int rc)
+{
+    auto& ss = (rc == 0) ? std::cout : std::cerr;
+
+    ss << "Usage: " << progname << " [options]\n\nOptions:\n\n"
+
+       << "[-k|--keys <value>]\n"
+       << "  Number of different keys accessed. Defaults to 10000.\n\n"
+
+       << "[-o|--operations <value>]\n"
+       << "  Number of operations per thread. Defaults to 200000.\n\n"
+
+       << "[-w|--write-percentage <value>]\n"
+       << "  Percentage of write operations (the rest are reads). Defaults to 20.\n\n"
+
+       << "[-t|--max-threads <value>]\n"
+       << "  Maximum number of threads (from 1, doubling up to this value). Defaults to 64.\n\n"
+
+       << "[-h|--help]\n"
+       << "  This help.\n\n"
+
+       << "Compares the single-lock map against the lock-striped one used for traffic registries\n"
+       << "(" << h2agent::model::TrafficMapStripes << " stripes), printing the throughput for each number of threads.\n\n"
+
+       << "Examples: " << '\n'
+       << "   " << progname << '\n'
+       << "   " << progname << " --keys 100 --write-percentage 50 --max-threads 16" << '\n'
+
+       << '\n';
+
+    exit(rc);
+}
+
+bool cmdOptionExists(char** begin, char** end, const std::string& option,
+                     std::string& value)
+{
+    char** itr = std::find(begin, end, option);
+    bool exists = (itr != end);
+
+    if (exists && ++itr != end)
+    {
+        value = *itr;
+    }
+
+    return exists;
+}
+
+template<typename MapType>
+double measure(int threads, const std::vector<std::string> &keys, int operations, int writePercentage)
+{
+    MapType map;
+    for (const auto &key : keys) map.add(key, nlohmann::json(0));
+
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            std::mt19937 gen(t);
+            std::uniform_int_distribution<std::size_t> keyDist(0, keys.size() - 1);
+            std::uniform_int_distribution<int> opDist(0, 99);
+            nlohmann::json value{};
+            while (!go.load()) std::this_thread::yield();
+
+            for (int k = 0; k < operations; k++) {
+                const std::string &key = keys[keyDist(gen)];
+                if (opDist(gen) < writePercentage) map.add(key, nlohmann::json(k));
+                else map.tryGet(key, value);
+            }
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    go = true;
+    for (auto &w : workers) w.join();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    return (static_cast<double>(threads) * operations) / elapsed.count();
+}
+
+
+///////////////////
+// MAIN FUNCTION //
+///////////////////
+
+int main(int argc, char* argv[])
+{
+    progname = basename(argv[0]);
+
+    // Parse command-line ///////////////////////////////////////////////////////////////////////////////////////
+    int keys = 10000;
+    int operations = 200000;
+    int writePercentage = 20;
+    int maxThreads = 64;
+
+    std::string value;
+
+    if (cmdOptionExists(argv, argv + argc, "-h", value)
+            || cmdOptionExists(argv, argv + argc, "--help", value))
+    {
+        usage(EXIT_SUCCESS);
+    }
+
+    try {
+        if (cmdOptionExists(argv, argv + argc, "-k", value)
+                || cmdOptionExists(argv, argv + argc, "--keys", value))
+        {
+            keys = std::stoi(value);
+        }
+
+        if (cmdOptionExists(argv, argv + argc, "-o", value)
+                || cmdOptionExists(argv, argv + argc, "--operations", value))
+        {
+            operations = std::stoi(value);
+        }
+
+        if (cmdOptionExists(argv, argv + argc, "-w", value)
+                || cmdOptionExists(argv, argv + argc, "--write-percentage", value))
+        {
+            writePercentage = std::stoi(value);
+        }
+
+        if (cmdOptionExists(argv, argv + argc, "-t", value)
+                || cmdOptionExists(argv, argv + argc, "--max-threads", value))
+        {
+            maxThreads = std::stoi(value);
+        }
+    }
+    catch (std::exception &e) {
+        usage(EXIT_FAILURE);
+    }
+
+    if (keys <= 0 || operations <= 0 || writePercentage < 0 || writePercentage > 100 || maxThreads <= 0) usage(EXIT_FAILURE);
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    std::vector<std::string> keyList;
+    for (int k = 0; k < keys; k++) keyList.push_back("key-" + std::to_string(k));
+
+    std::cout << "Keys: " << keys << " | Operations per thread: " << operations << " | Writes: " << writePercentage << "%\n\n";
+    std::cout << std::setw(8) << "threads" << std::setw(20) << "single (ops/s)" << std::setw(20) << "striped (ops/s)" << std::setw(10) << "ratio" << '\n';
+
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        double single = measure<h2agent::model::Map<std::string, nlohmann::json>>(threads, keyList, operations, writePercentage);
+        double striped = measure<h2agent::model::Map<std::string, nlohmann::json, h2agent::model::TrafficMapStripes>>(threads, keyList, operations, writePercentage);
+        std::cout << std::setw(8) << threads << std::setw(20) << std::fixed << std::setprecision(0) << single << std::setw(20) << striped
+                  << std::setw(10) << std::setprecision(2) << (striped / single) << std::endl;
+    }
+
+    exit(EXIT_SUCCESS);
+}
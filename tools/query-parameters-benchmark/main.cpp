@@ -0,0 +1,270 @@
+/*
+ ___________________________________________________________________________________________________________________________________________________________
+|                                                                           _                       _                     _                          _      |
+|                                                                          | |                     | |                   | |                        | |     |
+|    __ _ _   _  ___ _ __ _   _   __   _ __   __ _ _ __ __ _ _ __ ___   ___| |_ ___ _ __ ___   __  | |__   ___ _ __   ___| |__  _ __ ___   __ _ _ __| | __  |
+|   / _` | | | |/ _ \ '__| | | | |__| | '_ \ / _` | '__/ _` | '_ ` _ \ / _ \ __/ _ \ '__/ __| |__| | '_ \ / _ \ '_ \ / __| '_ \| '_ ` _ \ / _` | '__| |/ /  |  BENCHMARK UTILITY TO COMPARE QUERY PARAMETERS PROCESSING
+|  | (_| | |_| |  __/ |  | |_| |      | |_) | (_| | | | (_| | | | | | |  __/ ||  __/ |  \__ \      | |_) |  __/ | | | (__| | | | | | | | | (_| | |  |   <   |  Version 0.0.z
+|   \__, |\__,_|\___|_|   \__, |      | .__/ \__,_|_|  \__,_|_| |_| |_|\___|\__\___|_|  |___/      |_.__/ \___|_| |_|\___|_| |_|_| |_| |_|\__,_|_|  |_|\_\  |  https://github.com/testillano/h2agent (tools/query-parameters-benchmark)
+|      | |                 __/ |      | |                                                                                                                   |
+|      |_|                |___/       |_|                                                                                                                   |
+|___________________________________________________________________________________________________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <libgen.h> // basename
+
+// Standard
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <algorithm>
+
+#include <ert/http2comm/URLFunctions.hpp>
+
+#include <functions.hpp>
+
+
+const char* progname;
+
+enum Filter { Sort = 0, PassBy, Ignore };
+const char *FilterNames[] = { "Sort", "PassBy", "Ignore" };
+
+/**
+ * Query parameters extraction as done before the flat parser: a map with decoded
+ * values, another one with the original values, and the sorted literal built from it
+ */
+std::map<std::string, std::string> legacyExtractQueryParameters(const std::string &queryParams, std::string *sortedQueryParameters, char separator) {
+    std::map<std::string, std::string> result, resultOriginal;
+
+    if (queryParams.empty()) return result;
+
+    size_t pos = 0;
+    size_t qpair_end = queryParams.find_first_of(separator);
+    do
+    {
+        std::string qpair = queryParams.substr(pos, ((qpair_end != std::string::npos) ? (qpair_end - pos) : std::string::npos));
+        size_t key_value_divider = qpair.find_first_of('=');
+        std::string key = qpair.substr(0, key_value_divider);
+        std::string value;
+        if (key_value_divider != std::string::npos) value = qpair.substr((key_value_divider + 1));
+
+        if (result.count(key) != 0) {
+            result.clear();
+            return result;
+        }
+
+        if (sortedQueryParameters) resultOriginal.emplace(key, value);
+        result.emplace(key, ert::http2comm::URLFunctions::decode(value));
+        pos = ((qpair_end != std::string::npos) ? (qpair_end + 1) : std::string::npos);
+        qpair_end = queryParams.find_first_of(separator, pos);
+    }
+    while ((qpair_end != std::string::npos) || (pos != std::string::npos));
+
+    if (sortedQueryParameters) {
+        std::string &ref = *sortedQueryParameters;
+        ref.clear();
+        ref.reserve(queryParams.size());
+        for(auto it = resultOriginal.begin(); it != resultOriginal.end(); it ++) {
+            if (it != resultOriginal.begin()) ref += separator;
+            ref += it->first;
+            if (!it->second.empty()) {
+                ref += "=";
+                ref += it->second;
+            }
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////
+// Command line functions //
+////////////////////////////
+
+void usage(int rc)
+{
+    auto& ss = (rc == 0) ? std::cout : std::cerr;
+
+    ss << "Usage: " << progname << " [options]\n\nOptions:\n\n"
+
+       << "[-o|--operations <value>]\n"
+       << "  Number of receptions for each number of parameters and filter. Defaults to 200000.\n\n"
+
+       << "[-p|--max-parameters <value>]\n"
+       << "  Maximum number of query parameters (from 0 up to this value, step 5). Defaults to 30.\n\n"
+
+       << "[-h|--help]\n"
+       << "  This help.\n\n"
+
+       << "Compares the former map based query parameters processing against the flat parser used by the\n"
+       << "traffic server, building the normalized and classification URIs for 'Sort', 'PassBy' and 'Ignore'\n"
+       << "query parameters filters. The query parameters map (only materialized when 'request.uri.param'\n"
+       << "sources are provisioned) is not built by the current procedure.\n\n"
+
+       << "Examples: " << '\n'
+       << "   " << progname << '\n'
+       << "   " << progname << " --operations 50000 --max-parameters 10" << '\n'
+
+       << '\n';
+
+    exit(rc);
+}
+
+bool cmdOptionExists(char** begin, char** end, const std::string& option,
+                     std::string& value)
+{
+    char** itr = std::find(begin, end, option);
+    bool exists = (itr != end);
+
+    if (exists && ++itr != end)
+    {
+        value = *itr;
+    }
+
+    return exists;
+}
+
+template<typename Processing>
+double measure(int operations, Processing processing)
+{
+    static volatile std::size_t sink = 0; // avoids the processing to be optimized out
+    auto start = std::chrono::steady_clock::now();
+    for (int k = 0; k < operations; k++) sink = sink + processing();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    return operations / elapsed.count();
+}
+
+
+///////////////////
+// MAIN FUNCTION //
+///////////////////
+
+int main(int argc, char* argv[])
+{
+    progname = basename(argv[0]);
+
+    // Parse command-line ///////////////////////////////////////////////////////////////////////////////////////
+    int operations = 200000;
+    int maxParameters = 30;
+
+    std::string value;
+
+    if (cmdOptionExists(argv, argv + argc, "-h", value)
+            || cmdOptionExists(argv, argv + argc, "--help", value))
+    {
+        usage(EXIT_SUCCESS);
+    }
+
+    try {
+        if (cmdOptionExists(argv, argv + argc, "-o", value)
+                || cmdOptionExists(argv, argv + argc, "--operations", value))
+        {
+            operations = std::stoi(value);
+        }
+
+        if (cmdOptionExists(argv, argv + argc, "-p", value)
+                || cmdOptionExists(argv, argv + argc, "--max-parameters", value))
+        {
+            maxParameters = std::stoi(value);
+        }
+    }
+    catch (std::exception &e) {
+        usage(EXIT_FAILURE);
+    }
+
+    if (operations <= 0 || maxParameters < 0) usage(EXIT_FAILURE);
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    const std::string uriPath = "/app/v1/subscribers/12345";
+    const char separator = '&';
+
+    std::cout << "Receptions per measure: " << operations << "\n\n";
+    std::cout << std::setw(11) << "parameters" << std::setw(8) << "filter" << std::setw(17) << "legacy (op/s)" << std::setw(17) << "flat (op/s)" << std::setw(10) << "ratio" << '\n';
+
+    for (int parameters = 0; parameters <= maxParameters; parameters += ((parameters < 5) ? 1 : 5)) {
+        // Unsorted query string, some of the values percent-encoded:
+        std::string uriQuery;
+        for (int k = parameters - 1; k >= 0; k--) {
+            if (!uriQuery.empty()) uriQuery += separator;
+            uriQuery += "param" + std::to_string(k) + "=" + ((k % 3 == 0) ? "value%20" : "value") + std::to_string(k);
+        }
+
+        for (int filter = Sort; filter <= Ignore; filter++) {
+            double legacy = measure(operations, [&]() {
+                std::string normalizedUri = uriPath;
+                std::string classificationUri = uriPath;
+                std::map<std::string, std::string> qmap;
+                if (!uriQuery.empty()) {
+                    std::string uriQueryNormalized;
+                    qmap = legacyExtractQueryParameters(uriQuery, &uriQueryNormalized, separator);
+                    normalizedUri += "?";
+                    normalizedUri += uriQueryNormalized;
+                    if (filter == PassBy) {
+                        classificationUri += "?";
+                        classificationUri += uriQuery;
+                    }
+                    else if (filter == Sort) {
+                        classificationUri += "?";
+                        classificationUri += uriQueryNormalized;
+                    }
+                }
+                return normalizedUri.size() + classificationUri.size() + qmap.size();
+            });
+
+            // Reused buffers, as traffic server worker threads do:
+            std::string normalizedUri;
+            std::string classificationUri;
+            std::vector<h2agent::model::QueryParameter> queryParameters;
+            double current = measure(operations, [&]() {
+                normalizedUri.assign(uriPath);
+                queryParameters.clear();
+                if (!uriQuery.empty()) {
+                    h2agent::model::splitQueryParameters(uriQuery, queryParameters, separator);
+                    normalizedUri += '?';
+                    h2agent::model::appendQueryParameters(normalizedUri, queryParameters, separator);
+                }
+                if (filter == PassBy) {
+                    classificationUri.assign(uriPath);
+                    if (!uriQuery.empty()) {
+                        classificationUri += '?';
+                        classificationUri += uriQuery;
+                    }
+                }
+                else if (filter == Sort) classificationUri.assign(normalizedUri);
+                else classificationUri.assign(uriPath);
+                return normalizedUri.size() + classificationUri.size() + queryParameters.size();
+            });
+
+            std::cout << std::setw(11) << parameters << std::setw(8) << FilterNames[filter] << std::setw(17) << std::fixed << std::setprecision(0) << legacy << std::setw(17) << current
+                      << std::setw(10) << std::setprecision(2) << (current / legacy) << std::endl;
+        }
+    }
+
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,187 @@
+/*
+ ________________________________________________________________________________________________________
+|                       _                        _                     _                          _      |
+|                      | |                      | |                   | |                        | |     |
+|   _ __ __ _ _ __   __| | ___  _ __ ___    __  | |__   ___ _ __   ___| |__  _ __ ___   __ _ _ __| | __  |
+|  | '__/ _` | '_ \ / _` |/ _ \| '_ ` _ \  |__| | '_ \ / _ \ '_ \ / __| '_ \| '_ ` _ \ / _` | '__| |/ /  |  BENCHMARK UTILITY TO COMPARE rand() AND THE THREAD-LOCAL RANDOM GENERATOR
+|  | | | (_| | | | | (_| | (_) | | | | | |      | |_) |  __/ | | | (__| | | | | | | | | (_| | |  |   <   |  Version 0.0.z
+|  |_|  \__,_|_| |_|\__,_|\___/|_| |_| |_|      |_.__/ \___|_| |_|\___|_| |_|_| |_| |_|\__,_|_|  |_|\_\  |  https://github.com/testillano/h2agent (tools/random-benchmark)
+|________________________________________________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <libgen.h> // basename
+
+// Standard
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+
+#include <Random.hpp>
+
+
+const char* progname;
+
+////////////////////////////
+// Command line functions //
+////////////////////////////
+
+void usage(int rc)
+{
+    auto& ss = (rc == 0) ? std::cout : std::cerr;
+
+    ss << "Usage: " << progname << " [options]\n\nOptions:\n\n"
+
+       << "[-r|--range <value>]\n"
+       << "  Size of the random range drawn (like a 'random.<min>.<max>' source). Defaults to 1000.\n\n"
+
+       << "[-o|--operations <value>]\n"
+       << "  Number of draws per thread. Defaults to 2000000.\n\n"
+
+       << "[-t|--max-threads <value>]\n"
+       << "  Maximum number of threads (from 1, doubling up to this value). Defaults to 64.\n\n"
+
+       << "[-h|--help]\n"
+       << "  This help.\n\n"
+
+       << "Compares the C library rand() against the thread-local generator used by 'random' and\n"
+       << "'randomset' sources, printing the throughput for each number of threads.\n\n"
+
+       << "Examples: " << '\n'
+       << "   " << progname << '\n'
+       << "   " << progname << " --range 10 --max-threads 16" << '\n'
+
+       << '\n';
+
+    exit(rc);
+}
+
+bool cmdOptionExists(char** begin, char** end, const std::string& option,
+                     std::string& value)
+{
+    char** itr = std::find(begin, end, option);
+    bool exists = (itr != end);
+
+    if (exists && ++itr != end)
+    {
+        value = *itr;
+    }
+
+    return exists;
+}
+
+template<typename Draw>
+double measure(int threads, int operations, Draw draw)
+{
+    std::atomic<bool> go{false};
+    std::atomic<std::int64_t> sink{0}; // avoids the draws to be optimized out
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&]() {
+            std::int64_t acc = 0;
+            while (!go.load()) std::this_thread::yield();
+
+            for (int k = 0; k < operations; k++) acc += draw();
+            sink += acc;
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    go = true;
+    for (auto &w : workers) w.join();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    return (static_cast<double>(threads) * operations) / elapsed.count();
+}
+
+
+///////////////////
+// MAIN FUNCTION //
+///////////////////
+
+int main(int argc, char* argv[])
+{
+    progname = basename(argv[0]);
+
+    // Parse command-line ///////////////////////////////////////////////////////////////////////////////////////
+    int range = 1000;
+    int operations = 2000000;
+    int maxThreads = 64;
+
+    std::string value;
+
+    if (cmdOptionExists(argv, argv + argc, "-h", value)
+            || cmdOptionExists(argv, argv + argc, "--help", value))
+    {
+        usage(EXIT_SUCCESS);
+    }
+
+    try {
+        if (cmdOptionExists(argv, argv + argc, "-r", value)
+                || cmdOptionExists(argv, argv + argc, "--range", value))
+        {
+            range = std::stoi(value);
+        }
+
+        if (cmdOptionExists(argv, argv + argc, "-o", value)
+                || cmdOptionExists(argv, argv + argc, "--operations", value))
+        {
+            operations = std::stoi(value);
+        }
+
+        if (cmdOptionExists(argv, argv + argc, "-t", value)
+                || cmdOptionExists(argv, argv + argc, "--max-threads", value))
+        {
+            maxThreads = std::stoi(value);
+        }
+    }
+    catch (std::exception &e) {
+        usage(EXIT_FAILURE);
+    }
+
+    if (range <= 0 || operations <= 0 || maxThreads <= 0) usage(EXIT_FAILURE);
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    srand(1);
+    h2agent::model::setRandomSeed(1);
+
+    std::cout << "Range: " << range << " | Draws per thread: " << operations << "\n\n";
+    std::cout << std::setw(8) << "threads" << std::setw(20) << "rand (draws/s)" << std::setw(20) << "xoshiro (draws/s)" << std::setw(10) << "ratio" << '\n';
+
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        double legacy = measure(threads, operations, [range]() -> std::int64_t { return rand() % range; });
+        double current = measure(threads, operations, [range]() -> std::int64_t { return h2agent::model::randomInRange(0, range - 1); });
+        std::cout << std::setw(8) << threads << std::setw(20) << std::fixed << std::setprecision(0) << legacy << std::setw(20) << current
+                  << std::setw(10) << std::setprecision(2) << (current / legacy) << std::endl;
+    }
+
+    exit(EXIT_SUCCESS);
+}
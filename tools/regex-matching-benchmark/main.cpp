@@ -0,0 +1,201 @@
+/*
+ ______________________________________________________________________________________________________________________________________________
+|                                                   _       _     _                    _                     _                          _      |
+|                                                  | |     | |   (_)                  | |                   | |                        | |     |
+|   _ __ ___  __ _  _____  __  __   _ __ ___   __ _| |_ ___| |__  _ _ __   __ _   __  | |__   ___ _ __   ___| |__  _ __ ___   __ _ _ __| | __  |
+|  | '__/ _ \/ _` |/ _ \ \/ / |__| | '_ ` _ \ / _` | __/ __| '_ \| | '_ \ / _` | |__| | '_ \ / _ \ '_ \ / __| '_ \| '_ ` _ \ / _` | '__| |/ /  |  BENCHMARK UTILITY TO COMPARE RegexMatching LOOKUPS
+|  | | |  __/ (_| |  __/>  <       | | | | | | (_| | || (__| | | | | | | | (_| |      | |_) |  __/ | | | (__| | | | | | | | | (_| | |  |   <   |  Version 0.0.z
+|  |_|  \___|\__, |\___/_/\_\      |_| |_| |_|\__,_|\__\___|_| |_|_|_| |_|\__, |      |_.__/ \___|_| |_|\___|_| |_|_| |_| |_|\__,_|_|  |_|\_\  |  https://github.com/testillano/h2agent (tools/regex-matching-benchmark)
+|             __/ |                                                        __/ |                                                               |
+|            |___/                                                        |___/                                                                |
+|______________________________________________________________________________________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <libgen.h> // basename
+
+// Standard
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <regex>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+
+#include <nlohmann/json.hpp>
+
+#include <AdminData.hpp>
+#include <AdminServerProvisionData.hpp>
+#include <Configuration.hpp>
+
+
+const char* progname;
+
+////////////////////////////
+// Command line functions //
+////////////////////////////
+
+void usage(int rc)
+{
+    auto& ss = (rc == 0) ? std::cout : std::cerr;
+
+    ss << "Usage: " << progname << " [options]\n\nOptions:\n\n"
+
+       << "[-o|--operations <value>]\n"
+       << "  Number of lookups for each amount of provisions. Defaults to 20000.\n\n"
+
+       << "[-h|--help]\n"
+       << "  This help.\n\n"
+
+       << "Compares the 'RegexMatching' provision lookup, which only evaluates the candidates precomputed at\n"
+       << "load for the longest literal prefix starting the reception key, against the ordered scan of every\n"
+       << "provision regular expression (first match wins), for several numbers of provisions. Each provision\n"
+       << "has its own literal prefix, and a last catch-all provision is shared by all of them.\n\n"
+
+       << "Examples: " << '\n'
+       << "   " << progname << '\n'
+       << "   " << progname << " --operations 5000" << '\n'
+
+       << '\n';
+
+    exit(rc);
+}
+
+bool cmdOptionExists(char** begin, char** end, const std::string& option,
+                     std::string& value)
+{
+    char** itr = std::find(begin, end, option);
+    bool exists = (itr != end);
+
+    if (exists && ++itr != end)
+    {
+        value = *itr;
+    }
+
+    return exists;
+}
+
+template<typename Lookup>
+double measure(int operations, Lookup lookup)
+{
+    static volatile std::size_t sink = 0; // avoids the lookups to be optimized out
+    auto start = std::chrono::steady_clock::now();
+    for (int k = 0; k < operations; k++) sink = sink + lookup(k);
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    return elapsed.count() / operations;
+}
+
+
+///////////////////
+// MAIN FUNCTION //
+///////////////////
+
+int main(int argc, char* argv[])
+{
+    progname = basename(argv[0]);
+
+    // Parse command-line ///////////////////////////////////////////////////////////////////////////////////////
+    int operations = 20000;
+
+    std::string value;
+
+    if (cmdOptionExists(argv, argv + argc, "-h", value)
+            || cmdOptionExists(argv, argv + argc, "--help", value))
+    {
+        usage(EXIT_SUCCESS);
+    }
+
+    try {
+        if (cmdOptionExists(argv, argv + argc, "-o", value)
+                || cmdOptionExists(argv, argv + argc, "--operations", value))
+        {
+            operations = std::stoi(value);
+        }
+    }
+    catch (std::exception &e) {
+        usage(EXIT_FAILURE);
+    }
+
+    if (operations <= 0) usage(EXIT_FAILURE);
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    h2agent::model::Configuration configuration;
+    configuration.setLazyClientConnection(true); // provisions are not executed
+    h2agent::model::AdminData adminData;
+    h2agent::model::common_resources_t commonResources{};
+    commonResources.AdminDataPtr = &adminData;
+    commonResources.ConfigurationPtr = &configuration;
+
+    if (adminData.loadServerMatching(R"({"algorithm":"RegexMatching"})"_json) != h2agent::model::AdminServerMatchingData::Success) {
+        std::cerr << "Cannot configure RegexMatching algorithm" << '\n';
+        exit(EXIT_FAILURE);
+    }
+
+    std::cout << "Lookups per measure: " << operations << "\n\n";
+    std::cout << std::setw(12) << "provisions" << std::setw(20) << "ordered scan (ns)" << std::setw(15) << "indexed (ns)" << std::setw(10) << "ratio" << '\n';
+
+    for (int provisions : { 10, 100, 1000, 5000 }) {
+        nlohmann::json j = nlohmann::json::array();
+        for (int k = 0; k < provisions; k++) j.push_back({{"requestMethod", "GET"}, {"requestUri", "/app/v1/svc-" + std::to_string(k) + "/items/[0-9]+"}, {"responseCode", 200}});
+        j.push_back({{"requestMethod", "GET"}, {"requestUri", "/app/v1/.*"}, {"responseCode", 404}});
+
+        adminData.clearServerProvisions();
+        if (adminData.loadServerProvision(j, commonResources) != h2agent::model::AdminServerProvisionData::Success) {
+            std::cerr << "Cannot load " << provisions << " provisions" << '\n';
+            exit(EXIT_FAILURE);
+        }
+        const h2agent::model::AdminServerProvisionData &provisionData = adminData.getServerProvisionData();
+
+        // Ordered provisions, for the scan:
+        std::vector<std::shared_ptr<h2agent::model::AdminServerProvision>> ordered;
+        for (const auto &item : j) ordered.push_back(provisionData.find("initial", "GET", item["requestUri"]));
+
+        // Uniformly distributed receptions (every provision has the same chance to match):
+        std::vector<std::string> uris;
+        uris.reserve(provisions);
+        for (int k = 0; k < provisions; k++) uris.push_back("/app/v1/svc-" + std::to_string(k) + "/items/" + std::to_string(555000000 + k));
+
+        std::string key; // capacity reused, as done by the lookup
+        double scan = measure(operations, [&](int k) {
+            key = "initial#GET#";
+            key += uris[k % provisions];
+            for (const auto &provision : ordered) {
+                if (std::regex_match(key, provision->getRegex())) return std::size_t(provision->getResponseCode());
+            }
+            return std::size_t(0);
+        });
+        double indexed = measure(operations, [&](int k) {
+            auto provision = provisionData.findRegexMatching("initial", "GET", uris[k % provisions]);
+            return provision ? std::size_t(provision->getResponseCode()) : std::size_t(0);
+        });
+
+        std::cout << std::setw(12) << provisions << std::setw(20) << std::fixed << std::setprecision(0) << scan << std::setw(15) << indexed
+                  << std::setw(10) << std::setprecision(2) << (scan / indexed) << std::endl;
+    }
+
+    exit(EXIT_SUCCESS);
+}
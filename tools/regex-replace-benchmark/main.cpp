@@ -0,0 +1,175 @@
+/*
+ __________________________________________________________________________________________________________________________________
+|                                                  _                       _                     _                          _      |
+|                                                 | |                     | |                   | |                        | |     |
+|   _ __ ___  __ _  _____  __  __   _ __ ___ _ __ | | __ _  ___ ___   __  | |__   ___ _ __   ___| |__  _ __ ___   __ _ _ __| | __  |
+|  | '__/ _ \/ _` |/ _ \ \/ / |__| | '__/ _ \ '_ \| |/ _` |/ __/ _ \ |__| | '_ \ / _ \ '_ \ / __| '_ \| '_ ` _ \ / _` | '__| |/ /  |  BENCHMARK UTILITY TO COMPARE FullMatchingRegexReplace CLASSIFICATIONS
+|  | | |  __/ (_| |  __/>  <       | | |  __/ |_) | | (_| | (_|  __/      | |_) |  __/ | | | (__| | | | | | | | | (_| | |  |   <   |  Version 0.0.z
+|  |_|  \___|\__, |\___/_/\_\      |_|  \___| .__/|_|\__,_|\___\___|      |_.__/ \___|_| |_|\___|_| |_|_| |_| |_|\__,_|_|  |_|\_\  |  https://github.com/testillano/h2agent (tools/regex-replace-benchmark)
+|             __/ |                         | |                                                                                    |
+|            |___/                          |_|                                                                                    |
+|__________________________________________________________________________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <libgen.h> // basename
+
+// Standard
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <regex>
+#include <chrono>
+#include <algorithm>
+
+#include <nlohmann/json.hpp>
+
+#include <AdminServerMatchingData.hpp>
+
+
+const char* progname;
+
+////////////////////////////
+// Command line functions //
+////////////////////////////
+
+void usage(int rc)
+{
+    auto& ss = (rc == 0) ? std::cout : std::cerr;
+
+    ss << "Usage: " << progname << " [options]\n\nOptions:\n\n"
+
+       << "[-o|--operations <value>]\n"
+       << "  Number of classifications for each cardinality. Defaults to 200000.\n\n"
+
+       << "[-h|--help]\n"
+       << "  This help.\n\n"
+
+       << "Compares the plain 'std::regex_replace' classification of the 'FullMatchingRegexReplace' algorithm\n"
+       << "against the memoized one, for several numbers of distinct URIs received (cardinality). Those over\n"
+       << "the cache capacity (" << h2agent::model::AdminServerMatchingData::RegexReplaceCacheCapacity << ") show the cost of misses and evictions.\n\n"
+
+       << "Examples: " << '\n'
+       << "   " << progname << '\n'
+       << "   " << progname << " --operations 50000" << '\n'
+
+       << '\n';
+
+    exit(rc);
+}
+
+bool cmdOptionExists(char** begin, char** end, const std::string& option,
+                     std::string& value)
+{
+    char** itr = std::find(begin, end, option);
+    bool exists = (itr != end);
+
+    if (exists && ++itr != end)
+    {
+        value = *itr;
+    }
+
+    return exists;
+}
+
+template<typename Classification>
+double measure(int operations, Classification classification)
+{
+    static volatile std::size_t sink = 0; // avoids the classifications to be optimized out
+    auto start = std::chrono::steady_clock::now();
+    for (int k = 0; k < operations; k++) sink = sink + classification(k);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    return operations / elapsed.count();
+}
+
+
+///////////////////
+// MAIN FUNCTION //
+///////////////////
+
+int main(int argc, char* argv[])
+{
+    progname = basename(argv[0]);
+
+    // Parse command-line ///////////////////////////////////////////////////////////////////////////////////////
+    int operations = 200000;
+
+    std::string value;
+
+    if (cmdOptionExists(argv, argv + argc, "-h", value)
+            || cmdOptionExists(argv, argv + argc, "--help", value))
+    {
+        usage(EXIT_SUCCESS);
+    }
+
+    try {
+        if (cmdOptionExists(argv, argv + argc, "-o", value)
+                || cmdOptionExists(argv, argv + argc, "--operations", value))
+        {
+            operations = std::stoi(value);
+        }
+    }
+    catch (std::exception &e) {
+        usage(EXIT_FAILURE);
+    }
+
+    if (operations <= 0) usage(EXIT_FAILURE);
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Trims the last timestamp path part:
+    const nlohmann::json matching = R"({"algorithm":"FullMatchingRegexReplace","rgx":"(/ctrl/v2/id-[0-9]+)/ts-[0-9]+","fmt":"$1"})"_json;
+
+    std::cout << "Classifications per measure: " << operations << "\n\n";
+    std::cout << std::setw(12) << "cardinality" << std::setw(23) << "regex_replace (op/s)" << std::setw(18) << "memoized (op/s)" << std::setw(10) << "ratio" << std::setw(12) << "hit ratio" << '\n';
+
+    for (int cardinality : { 10, 100, 1000, 5000, 20000, 100000 }) {
+        std::vector<std::string> uris;
+        uris.reserve(cardinality);
+        for (int k = 0; k < cardinality; k++) uris.push_back("/ctrl/v2/id-" + std::to_string(555000000 + k) + "/ts-" + std::to_string(1615562841 + k));
+
+        // Fresh snapshot (empty cache) for each cardinality:
+        h2agent::model::AdminServerMatchingData matchingData;
+        matchingData.load(matching);
+        auto config = matchingData.getConfig();
+
+        std::string classificationUri;
+        double plain = measure(operations, [&](int k) {
+            classificationUri = std::regex_replace(uris[k % cardinality], config->rgx, config->fmt);
+            return classificationUri.size();
+        });
+        double memoized = measure(operations, [&](int k) {
+            classificationUri = uris[k % cardinality];
+            config->regexReplace(classificationUri);
+            return classificationUri.size();
+        });
+        double hitRatio = double(config->regex_replace_cache.hits()) / double(config->regex_replace_cache.hits() + config->regex_replace_cache.misses());
+
+        std::cout << std::setw(12) << cardinality << std::setw(23) << std::fixed << std::setprecision(0) << plain << std::setw(18) << memoized
+                  << std::setw(10) << std::setprecision(2) << (memoized / plain) << std::setw(12) << hitRatio << std::endl;
+    }
+
+    exit(EXIT_SUCCESS);
+}
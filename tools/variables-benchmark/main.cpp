@@ -0,0 +1,209 @@
+/*
+ ___________________________________________________________________________________________________________
+|                   _       _     _                 _                     _                          _      |
+|                  (_)     | |   | |               | |                   | |                        | |     |
+|  __   ____ _ _ __ _  __ _| |__ | | ___ ___   __  | |__   ___ _ __   ___| |__  _ __ ___   __ _ _ __| | __  |
+|  \ \ / / _` | '__| |/ _` | '_ \| |/ _ Y __| |__| | '_ \ / _ \ '_ \ / __| '_ \| '_ ` _ \ / _` | '__| |/ /  |  BENCHMARK UTILITY TO COMPARE @{var} SUBSTITUTION STRATEGIES
+|   \ V / (_| | |  | | (_| | |_) | |  __|__ \      | |_) |  __/ | | | (__| | | | | | | | | (_| | |  |   <   |  Version 0.0.z
+|    \_/ \__,_|_|  |_|\__,_|_.__/|_|\___|___/      |_.__/ \___|_| |_|\___|_| |_|_| |_| |_|\__,_|_|  |_|\_\  |  https://github.com/testillano/h2agent (tools/variables-benchmark)
+|___________________________________________________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <libgen.h> // basename
+
+// Standard
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <map>
+#include <chrono>
+#include <algorithm>
+
+#include <nlohmann/json.hpp>
+
+#include <TypeConverter.hpp>
+#include <StringTemplate.hpp>
+#include <Vault.hpp>
+
+
+const char* progname;
+
+/**
+ * Variables substitution as done before precompiled templates: one search/replace
+ * over the whole string for each pattern, and a copy of every vault value read
+ */
+void legacyReplaceVariables(std::string &str, const std::map<std::string, std::string> &patterns, const std::map<std::string,std::string> &vars, h2agent::model::Vault *vault) {
+
+    if (patterns.empty()) return;
+    if (vars.empty() && vault->empty()) return;
+
+    nlohmann::json aux{};
+    for (auto pit = patterns.begin(); pit != patterns.end(); pit++) {
+        auto it = vars.find(pit->second);
+        if (it != vars.end()) {
+            h2agent::model::searchReplaceAll(str, pit->first, it->second);
+            continue;
+        }
+        if (vault->tryGet(pit->second, aux)) {
+            h2agent::model::searchReplaceAll(str, pit->first, h2agent::model::jsonToString(aux));
+        }
+    }
+}
+
+////////////////////////////
+// Command line functions //
+////////////////////////////
+
+void usage(int rc)
+{
+    auto& ss = (rc == 0) ? std::cout : std::cerr;
+
+    ss << "Usage: " << progname << " [options]\n\nOptions:\n\n"
+
+       << "[-o|--operations <value>]\n"
+       << "  Number of substitutions for each number of variables. Defaults to 200000.\n\n"
+
+       << "[-v|--max-variables <value>]\n"
+       << "  Maximum number of variables per string (from 0 up to this value). Defaults to 20.\n\n"
+
+       << "[-h|--help]\n"
+       << "  This help.\n\n"
+
+       << "Compares the former search/replace substitution of '@{var}' patterns against the precompiled\n"
+       << "templates used by transformation items, printing the throughput for each number of variables.\n"
+       << "Half of the variables are scoped ones and the other half are vault entries.\n\n"
+
+       << "Examples: " << '\n'
+       << "   " << progname << '\n'
+       << "   " << progname << " --operations 50000 --max-variables 5" << '\n'
+
+       << '\n';
+
+    exit(rc);
+}
+
+bool cmdOptionExists(char** begin, char** end, const std::string& option,
+                     std::string& value)
+{
+    char** itr = std::find(begin, end, option);
+    bool exists = (itr != end);
+
+    if (exists && ++itr != end)
+    {
+        value = *itr;
+    }
+
+    return exists;
+}
+
+template<typename Substitution>
+double measure(int operations, Substitution substitution)
+{
+    static volatile std::size_t sink = 0; // avoids the substitutions to be optimized out
+    auto start = std::chrono::steady_clock::now();
+    for (int k = 0; k < operations; k++) sink = sink + substitution();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    return operations / elapsed.count();
+}
+
+
+///////////////////
+// MAIN FUNCTION //
+///////////////////
+
+int main(int argc, char* argv[])
+{
+    progname = basename(argv[0]);
+
+    // Parse command-line ///////////////////////////////////////////////////////////////////////////////////////
+    int operations = 200000;
+    int maxVariables = 20;
+
+    std::string value;
+
+    if (cmdOptionExists(argv, argv + argc, "-h", value)
+            || cmdOptionExists(argv, argv + argc, "--help", value))
+    {
+        usage(EXIT_SUCCESS);
+    }
+
+    try {
+        if (cmdOptionExists(argv, argv + argc, "-o", value)
+                || cmdOptionExists(argv, argv + argc, "--operations", value))
+        {
+            operations = std::stoi(value);
+        }
+
+        if (cmdOptionExists(argv, argv + argc, "-v", value)
+                || cmdOptionExists(argv, argv + argc, "--max-variables", value))
+        {
+            maxVariables = std::stoi(value);
+        }
+    }
+    catch (std::exception &e) {
+        usage(EXIT_FAILURE);
+    }
+
+    if (operations <= 0 || maxVariables < 0) usage(EXIT_FAILURE);
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    std::map<std::string, std::string> vars;
+    h2agent::model::Vault vault;
+
+    std::cout << "Substitutions per measure: " << operations << "\n\n";
+    std::cout << std::setw(10) << "variables" << std::setw(22) << "search/replace (op/s)" << std::setw(20) << "template (op/s)" << std::setw(10) << "ratio" << '\n';
+
+    for (int variables = 0; variables <= maxVariables; variables++) {
+        // Uri-like string with the variables interleaved:
+        std::string str = "/app/v1/resource";
+        std::map<std::string, std::string> patterns;
+        for (int k = 0; k < variables; k++) {
+            std::string name = "var" + std::to_string(k);
+            if (k % 2 == 0) vars[name] = "value-" + std::to_string(k);
+            else vault.load(name, nlohmann::json("gvalue-" + std::to_string(k)));
+            str += "/@{" + name + "}";
+            patterns["@{" + name + "}"] = name;
+        }
+
+        h2agent::model::StringTemplate strTemplate;
+        strTemplate.compile(str);
+        std::string rendered;
+
+        double legacy = measure(operations, [&]() {
+            std::string result = str;
+            legacyReplaceVariables(result, patterns, vars, &vault);
+            return result.size();
+        });
+        double current = measure(operations, [&]() {
+            strTemplate.render(rendered, vars, &vault);
+            return rendered.size();
+        });
+        std::cout << std::setw(10) << variables << std::setw(22) << std::fixed << std::setprecision(0) << legacy << std::setw(20) << current
+                  << std::setw(10) << std::setprecision(2) << (current / legacy) << std::endl;
+    }
+
+    exit(EXIT_SUCCESS);
+}
@@ -69,6 +69,13 @@ TEST_F(MyTrafficHttp2ServerUnitTest, DataConfigurationAfterDisablePurge) {
               "{\"needsStorage\":false,\"purgeExecution\":false,\"storeEvents\":true,\"storeEventsKeyHistory\":true}");
 }
 
+// Test dataConfigurationAsJsonString with retention limits
+TEST_F(MyTrafficHttp2ServerUnitTest, DataConfigurationRetention) {
+    mock_server_data_->setRetention(100, 1048576);
+    EXPECT_EQ(server_->dataConfigurationAsJsonString(),
+              "{\"maxBytes\":1048576,\"maxEventsPerKey\":100,\"needsStorage\":false,\"purgeExecution\":true,\"storeEvents\":true,\"storeEventsKeyHistory\":true}");
+}
+
 // Test dataConfigurationAsJsonString with all disabled
 TEST_F(MyTrafficHttp2ServerUnitTest, DataConfigurationAllDisabled) {
     server_->discardData();
@@ -161,21 +168,29 @@ TEST_F(MyTrafficHttp2ServerUnitTest, ResponseDelayMsNoVariable) {
 
 // Test responseDelayMs with valid variable
 TEST_F(MyTrafficHttp2ServerUnitTest, ResponseDelayMsWithVariable) {
-    vault_->add("__core:response-delay-ms:12345", "500");
+    vault_->load("__core:response-delay-ms:12345", "500");
     auto delay = server_->responseDelayMs(12345);
     EXPECT_EQ(delay.count(), 500);
 }
 
 // Test responseDelayMs with invalid (non-numeric) variable
 TEST_F(MyTrafficHttp2ServerUnitTest, ResponseDelayMsInvalidVariable) {
-    vault_->add("__core:response-delay-ms:12345", "not_a_number");
+    vault_->load("__core:response-delay-ms:12345", "not_a_number");
     auto delay = server_->responseDelayMs(12345);
     EXPECT_EQ(delay.count(), 0);
 }
 
 // Test responseDelayMs with out-of-range variable
 TEST_F(MyTrafficHttp2ServerUnitTest, ResponseDelayMsOutOfRange) {
-    vault_->add("__core:response-delay-ms:12345", "99999999999999999999999999999");
+    vault_->load("__core:response-delay-ms:12345", "99999999999999999999999999999");
+    auto delay = server_->responseDelayMs(12345);
+    EXPECT_EQ(delay.count(), 0);
+}
+
+// Test responseDelayMs variable released at stream close
+TEST_F(MyTrafficHttp2ServerUnitTest, ResponseDelayMsReleasedAtStreamClose) {
+    vault_->load("__core:response-delay-ms:12345", "500");
+    server_->streamClose(12345);
     auto delay = server_->responseDelayMs(12345);
     EXPECT_EQ(delay.count(), 0);
 }
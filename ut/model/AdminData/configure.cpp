@@ -386,6 +386,16 @@ TEST_F(Configure_test, LoadMatching)
     std::string result = std::regex_replace ("123-ab-foo-bar", config->rgx, config->fmt);
     EXPECT_EQ(result, "123");
 
+    // Memoized replacement:
+    result = "123-ab-foo-bar";
+    EXPECT_FALSE(config->regexReplace(result)); // miss
+    EXPECT_EQ(result, "123");
+    result = "123-ab-foo-bar";
+    EXPECT_TRUE(config->regexReplace(result)); // hit
+    EXPECT_EQ(result, "123");
+    EXPECT_EQ(config->regex_replace_cache.hits(), 1);
+    EXPECT_EQ(config->regex_replace_cache.misses(), 1);
+
     //EXPECT_EQ(Configure_test::adata_.getServerMatchingData().getRgx(), re);
 
     EXPECT_EQ(Configure_test::adata_.loadServerMatching(MatchingConfiguration_RegexMatching__Success), h2agent::model::AdminServerMatchingData::Success);
@@ -468,6 +478,69 @@ TEST_F(Configure_test, FindProvisionRegex)
     EXPECT_TRUE(Configure_test::adata_.clearServerProvisions());
 }
 
+TEST_F(Configure_test, FindProvisionRegexFirstMatchWins)
+{
+    EXPECT_EQ(Configure_test::adata_.loadServerMatching(MatchingConfiguration_RegexMatching__Success), h2agent::model::AdminServerMatchingData::Success);
+
+    // Different literal prefixes (even none) must keep the insertion order:
+    nlohmann::json provisions = nlohmann::json::array();
+    provisions.push_back(R"({"requestMethod":"GET","requestUri":"/foo/bar/[0-9]+","responseCode":201})"_json);
+    provisions.push_back(R"({"requestMethod":"GET","requestUri":"/foo/.*","responseCode":202})"_json);
+    provisions.push_back(R"({"requestMethod":"GET","requestUri":"/foo/bar/123","responseCode":203})"_json);
+    provisions.push_back(R"({"inState":"initial|other","requestMethod":"GET","requestUri":"/foo/baz","responseCode":204})"_json);
+    EXPECT_EQ(Configure_test::adata_.loadServerProvision(provisions, common_resources_), h2agent::model::AdminServerProvisionData::Success);
+
+    auto provision = Configure_test::adata_.getServerProvisionData().findRegexMatching("initial", "GET", "/foo/bar/123");
+    ASSERT_TRUE(provision != nullptr);
+    EXPECT_EQ(provision->getResponseCode(), 201);
+
+    provision = Configure_test::adata_.getServerProvisionData().findRegexMatching("initial", "GET", "/foo/baz");
+    ASSERT_TRUE(provision != nullptr);
+    EXPECT_EQ(provision->getResponseCode(), 202);
+
+    // Top-level alternation ("initial" or "other#GET#/foo/baz") has no literal prefix:
+    provision = Configure_test::adata_.getServerProvisionData().findRegexMatching("other", "GET", "/foo/baz");
+    ASSERT_TRUE(provision != nullptr);
+    EXPECT_EQ(provision->getResponseCode(), 204);
+    EXPECT_TRUE(Configure_test::adata_.getServerProvisionData().findRegexMatching("initial", "GET", "/bar") == nullptr);
+
+    // Reloading an existing key keeps its position but replaces the provision:
+    EXPECT_EQ(Configure_test::adata_.loadServerProvision(R"({"requestMethod":"GET","requestUri":"/foo/bar/[0-9]+","responseCode":205})"_json, common_resources_), h2agent::model::AdminServerProvisionData::Success);
+    provision = Configure_test::adata_.getServerProvisionData().findRegexMatching("initial", "GET", "/foo/bar/123");
+    ASSERT_TRUE(provision != nullptr);
+    EXPECT_EQ(provision->getResponseCode(), 205);
+
+    EXPECT_TRUE(Configure_test::adata_.clearServerProvisions());
+    EXPECT_TRUE(Configure_test::adata_.getServerProvisionData().findRegexMatching("initial", "GET", "/foo/bar/123") == nullptr);
+}
+
+TEST_F(Configure_test, FindProvisionRegexNestedPrefixes)
+{
+    EXPECT_EQ(Configure_test::adata_.loadServerMatching(MatchingConfiguration_RegexMatching__Success), h2agent::model::AdminServerMatchingData::Success);
+
+    // Candidates of a prefix include those of the shorter prefixes starting it, by insertion order:
+    nlohmann::json provisions = nlohmann::json::array();
+    provisions.push_back(R"({"requestMethod":"GET","requestUri":"/foo/bar/baz/7.*","responseCode":201})"_json);
+    provisions.push_back(R"({"requestMethod":"GET","requestUri":"/foo/bar/.*","responseCode":202})"_json);
+    provisions.push_back(R"({"requestMethod":"GET","requestUri":"/foo/.*","responseCode":203})"_json);
+    EXPECT_EQ(Configure_test::adata_.loadServerProvision(provisions, common_resources_), h2agent::model::AdminServerProvisionData::Success);
+
+    auto provision = Configure_test::adata_.getServerProvisionData().findRegexMatching("initial", "GET", "/foo/bar/baz/7");
+    ASSERT_TRUE(provision != nullptr);
+    EXPECT_EQ(provision->getResponseCode(), 201);
+
+    provision = Configure_test::adata_.getServerProvisionData().findRegexMatching("initial", "GET", "/foo/bar/baz/123");
+    ASSERT_TRUE(provision != nullptr);
+    EXPECT_EQ(provision->getResponseCode(), 202);
+
+    provision = Configure_test::adata_.getServerProvisionData().findRegexMatching("initial", "GET", "/foo/baz");
+    ASSERT_TRUE(provision != nullptr);
+    EXPECT_EQ(provision->getResponseCode(), 203);
+
+    EXPECT_TRUE(Configure_test::adata_.getServerProvisionData().findRegexMatching("initial", "GET", "/fo") == nullptr);
+    EXPECT_TRUE(Configure_test::adata_.clearServerProvisions());
+}
+
 TEST_F(Configure_test, FindProvision)
 {
     // Bad content only happens for RegexMatching:
@@ -132,3 +132,69 @@ TEST_F(DataPart_test, DecodeMultipartEmptyBoundary)
     EXPECT_FALSE(dp_multipart_.isJson());
 }
 
+
+TEST_F(DataPart_test, JsonPointerSelection)
+{
+    h2agent::model::JsonPointerSelection selection;
+    EXPECT_TRUE(selection.empty());
+    EXPECT_FALSE(selection.add("")); // whole document
+    EXPECT_FALSE(selection.add("foo"));
+    EXPECT_FALSE(selection.add("/a~2b"));
+    EXPECT_TRUE(selection.add("/a~1b/~0c/01/1"));
+    EXPECT_TRUE(selection.add("/a~1b/~0c/01/1")); // duplicated
+    ASSERT_EQ(selection.paths().size(), 1);
+
+    const auto &tokens = selection.paths()[0];
+    ASSERT_EQ(tokens.size(), 4);
+    EXPECT_EQ(tokens[0].key, "a/b");
+    EXPECT_EQ(tokens[1].key, "~c");
+    EXPECT_FALSE(tokens[2].numeric); // leading zero: object key only
+    EXPECT_TRUE(tokens[3].numeric);
+    EXPECT_EQ(tokens[3].index, 1);
+}
+
+TEST_F(DataPart_test, DecodeSelection)
+{
+    nghttp2::asio_http2::header_map headers;
+    headers.emplace("content-type", nghttp2::asio_http2::header_value{"application/json"});
+    const nlohmann::json document = R"({"subscriber":{"imsi":"214010000000001","msisdn":"34600000001"},"items":[{"id":1},{"id":2,"tags":["x","y"]}],"big":{"ignored":[1,2,3]},"flag":true})"_json;
+
+    h2agent::model::JsonPointerSelection selection;
+    EXPECT_TRUE(selection.add("/subscriber/imsi"));
+    EXPECT_TRUE(selection.add("/items/1"));
+    EXPECT_TRUE(selection.add("/items/1/tags/0")); // within a selected node
+    EXPECT_TRUE(selection.add("/missing/node"));
+
+    h2agent::model::DataPart dp(document.dump());
+    dp.decodeSelection(headers, selection);
+    EXPECT_TRUE(dp.isJson());
+    EXPECT_EQ(dp.getJson(), R"({"subscriber":{"imsi":"214010000000001"},"items":[null,{"id":2,"tags":["x","y"]}]})"_json);
+    EXPECT_EQ(dp.getJson().at("/subscriber/imsi"_json_pointer), document.at("/subscriber/imsi"_json_pointer));
+    EXPECT_EQ(dp.getJson().at("/items/1/tags/0"_json_pointer), "x");
+
+    // Full decode is still available:
+    dp.decode(headers);
+    EXPECT_EQ(dp.getJson(), document);
+    EXPECT_TRUE(dp.isJson());
+}
+
+TEST_F(DataPart_test, DecodeSelectionFallback)
+{
+    h2agent::model::JsonPointerSelection selection;
+    EXPECT_TRUE(selection.add("/foo"));
+
+    // Not json content:
+    nghttp2::asio_http2::header_map headers;
+    headers.emplace("content-type", nghttp2::asio_http2::header_value{"text/plain"});
+    dp_text_.decodeSelection(headers, selection);
+    EXPECT_EQ(dp_text_.getJson(), nlohmann::json(HelloWorld));
+    EXPECT_FALSE(dp_text_.isJson());
+
+    // Invalid json content (parse error description, as full decode does):
+    headers.clear();
+    headers.emplace("content-type", nghttp2::asio_http2::header_value{"application/json"});
+    h2agent::model::DataPart dp(std::string(R"({"foo":"bar",)"));
+    dp.decodeSelection(headers, selection);
+    EXPECT_TRUE(dp.isJson());
+    EXPECT_TRUE(dp.getJson().is_string());
+}
@@ -1,5 +1,9 @@
+#include <cstdio>
+#include <fstream>
 #include <thread>
 
+#include <sys/stat.h>
+
 #include <FileManager.hpp>
 
 #include <gmock/gmock.h>
@@ -74,19 +78,19 @@ TEST_F(FileManager_test, FileManager)
     EXPECT_EQ(content, FileManagerSafeFileContent);
     EXPECT_TRUE(success);
 
-    // Write in existent safe file:
+    // Write in existent safe file (cache is refreshed):
     fm.write(path1, FileManagerSafeFileContent, true /* text */, 0);
     success = fm.read(path1, content, true /* text */);
-    EXPECT_EQ(content, FileManagerSafeFileContent);
+    EXPECT_EQ(content, FileManagerSafeFileContent + FileManagerSafeFileContent);
     EXPECT_TRUE(success);
 
     // empty:
     fm.empty(path1);
     fm.empty(path2);
 
-    // read path1 (was cached)
+    // read path1 (was cached, but emptied)
     success = fm.read(path1, content, true /* text */);
-    EXPECT_EQ(content, FileManagerSafeFileContent);
+    EXPECT_EQ(content, "");
     EXPECT_TRUE(success);
 
     // read path2 (not cached: will be read again)
@@ -132,3 +136,65 @@ TEST_F(FileManager_test, FileManager)
     EXPECT_FALSE(success);
 }
 
+
+TEST_F(FileManager_test, ReadCacheDetectsChanges)
+{
+    h2agent::model::FileManager fm(nullptr);
+    fm.enableReadCache(true);
+
+    std::string path = "/tmp/h2agent.ut.Bach.bin";
+    std::string content;
+    std::remove(path.c_str());
+
+    // Missing file:
+    EXPECT_FALSE(fm.read(path, content, false /* binary */));
+
+    // External creation, with line feeds (kept for binary content, removed for text):
+    std::ofstream(path, std::ios::binary) << "a\nb\n";
+    EXPECT_TRUE(fm.read(path, content, false /* binary */));
+    EXPECT_EQ(content, "a\nb\n");
+    EXPECT_TRUE(fm.read(path, content, true /* text */));
+    EXPECT_EQ(content, "ab");
+
+    // External replacement (same size):
+    std::string tmp = path + ".tmp";
+    std::ofstream(tmp, std::ios::binary) << "c\nd\n";
+    ASSERT_EQ(std::rename(tmp.c_str(), path.c_str()), 0);
+    EXPECT_TRUE(fm.read(path, content, false /* binary */));
+    EXPECT_EQ(content, "c\nd\n");
+
+    // External truncation:
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "e";
+    EXPECT_TRUE(fm.read(path, content, false /* binary */));
+    EXPECT_EQ(content, "e");
+
+    // External removal:
+    std::remove(path.c_str());
+    EXPECT_FALSE(fm.read(path, content, false /* binary */));
+    EXPECT_EQ(content, "");
+}
+
+TEST_F(FileManager_test, ReadNotCachedFiles)
+{
+    h2agent::model::FileManager fm(nullptr);
+    std::string content;
+
+    for (bool cache: {false, true}) {
+        fm.enableReadCache(cache);
+
+        // Generated on read (reported size is zero):
+        content.clear();
+        EXPECT_TRUE(fm.read("/proc/self/status", content, true /* text */));
+        EXPECT_THAT(content, ::testing::HasSubstr("Name:"));
+
+        // Named pipe:
+        std::string fifo = "/tmp/h2agent.ut.Handel.fifo";
+        std::remove(fifo.c_str());
+        ASSERT_EQ(::mkfifo(fifo.c_str(), 0666), 0);
+        std::thread writer([&fifo] { std::ofstream(fifo, std::ios::binary) << "a\nb"; });
+        EXPECT_TRUE(fm.read(fifo, content, false /* binary */));
+        EXPECT_EQ(content, "a\nb");
+        writer.join();
+        std::remove(fifo.c_str());
+    }
+}
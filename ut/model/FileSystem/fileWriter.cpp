@@ -0,0 +1,134 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <FileManager.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+class FileWriter_test : public ::testing::Test
+{
+public:
+    std::string path_ = "/tmp/h2agent.ut.FileWriter.txt";
+    std::string path2_ = "/tmp/h2agent.ut.FileWriter2.txt";
+
+    FileWriter_test() {
+        std::remove(path_.c_str());
+        std::remove(path2_.c_str());
+    }
+
+    ~FileWriter_test() {
+        std::remove(path_.c_str());
+        std::remove(path2_.c_str());
+    }
+};
+
+TEST_F(FileWriter_test, WritesAreVisibleOnRead)
+{
+    h2agent::model::FileManager fm(nullptr);
+    fm.enableMetrics(nullptr, "");
+    fm.enableBackgroundWriter(0, false);
+
+    std::string expected;
+    for (int i = 0; i < 100; i++) {
+        std::string chunk = "chunk" + std::to_string(i) + ";";
+        fm.write(path_, chunk, true /* text */, 0);
+        fm.write(path2_, chunk, false /* binary */, 0);
+        expected += chunk;
+    }
+
+    // read waits for pending writes:
+    std::string content;
+    EXPECT_TRUE(fm.read(path_, content, true /* text */));
+    EXPECT_EQ(content, expected);
+    EXPECT_TRUE(fm.read(path2_, content, false /* binary */));
+    EXPECT_EQ(content, expected);
+
+    // empty also waits for them:
+    fm.write(path_, "pending", true /* text */, 0);
+    fm.empty(path_);
+    EXPECT_TRUE(fm.read(path_, content, true /* text */));
+    EXPECT_EQ(content, "");
+}
+
+TEST_F(FileWriter_test, ReadCutsGroupCommitWindow)
+{
+    h2agent::model::FileManager fm(nullptr);
+    fm.enableBackgroundWriter(5000000 /* 5 seconds window */, false);
+
+    fm.write(path_, "data", true /* text */, 0);
+
+    auto start = std::chrono::steady_clock::now();
+    std::string content;
+    EXPECT_TRUE(fm.read(path_, content, true /* text */));
+    EXPECT_EQ(content, "data");
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2)); // not waiting the whole window
+}
+
+TEST_F(FileWriter_test, ConcurrentWritersKeepEveryWrite)
+{
+    h2agent::model::FileManager fm(nullptr);
+    fm.enableBackgroundWriter(100 /* group commit window */, false);
+
+    static constexpr int Writers = 4;
+    static constexpr int PerWriter = 500;
+    std::vector<std::thread> writers;
+    for (int w = 0; w < Writers; w++) {
+        writers.emplace_back([&fm, this] {
+            for (int i = 0; i < PerWriter; i++) fm.write(path_, "x", true /* text */, 1000000);
+        });
+    }
+    for (auto &t: writers) t.join();
+
+    std::string content;
+    EXPECT_TRUE(fm.read(path_, content, true /* text */));
+    EXPECT_EQ(content, std::string(Writers * PerWriter, 'x'));
+
+    // Per file statistics:
+    nlohmann::json files = fm.getJson();
+    ASSERT_EQ(files.size(), 1);
+    EXPECT_EQ(files[0]["backgroundWriter"]["queuedWrites"], 0);
+    EXPECT_GE(files[0]["backgroundWriter"]["groupWrites"].get<int>(), 1);
+    EXPECT_LE(files[0]["backgroundWriter"]["groupWrites"].get<int>(), Writers * PerWriter);
+}
+
+TEST_F(FileWriter_test, CloseDelay)
+{
+    h2agent::model::FileManager fm(nullptr);
+    fm.enableBackgroundWriter(0, false);
+
+    std::string content;
+
+    // Instant close:
+    fm.write(path_, "a", true /* text */, 0);
+    EXPECT_TRUE(fm.read(path_, content, true /* text */));
+    EXPECT_EQ(fm.getJson()[0]["state"], "closed");
+
+    // Kept opened until close delay expires:
+    fm.write(path_, "b", true /* text */, 50000 /* 50 ms */);
+    EXPECT_TRUE(fm.read(path_, content, true /* text */));
+    EXPECT_EQ(content, "ab");
+    EXPECT_EQ(fm.getJson()[0]["state"], "opened");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_EQ(fm.getJson()[0]["state"], "closed");
+}
+
+TEST_F(FileWriter_test, Configuration)
+{
+    h2agent::model::FileManager fm(nullptr);
+    EXPECT_FALSE(fm.getConfigurationJson().contains("backgroundWriter"));
+
+    fm.enableBackgroundWriter(2000, true);
+    nlohmann::json expected = R"({"readCache":"disabled","backgroundWriter":{"flushIntervalUsecs":2000,"fsync":"enabled"}})"_json;
+    EXPECT_EQ(fm.getConfigurationJson(), expected);
+
+    // fsync policy still writes:
+    fm.write(path_, "synced", true /* text */, 0);
+    std::string content;
+    EXPECT_TRUE(fm.read(path_, content, true /* text */));
+    EXPECT_EQ(content, "synced");
+}
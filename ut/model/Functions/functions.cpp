@@ -102,6 +102,42 @@ TEST_F(functions_test, ExtractQueryParameters)
     EXPECT_EQ(qmap_str, "bar=bar_value;foo=foo_value");
 }
 
+TEST_F(functions_test, SplitQueryParameters)
+{
+    std::vector<h2agent::model::QueryParameter> parameters;
+
+    EXPECT_TRUE(h2agent::model::splitQueryParameters("", parameters));
+    EXPECT_TRUE(parameters.empty());
+
+    EXPECT_TRUE(h2agent::model::splitQueryParameters("zeta=1&alpha&mid=", parameters));
+    ASSERT_EQ(parameters.size(), 3);
+    EXPECT_EQ(parameters[0].key, "alpha");
+    EXPECT_TRUE(parameters[0].value.empty());
+    EXPECT_EQ(parameters[1].key, "mid");
+    EXPECT_EQ(parameters[2].key, "zeta");
+    EXPECT_EQ(parameters[2].value, "1");
+
+    std::string normalized = "/app?";
+    h2agent::model::appendQueryParameters(normalized, parameters);
+    EXPECT_EQ(normalized, "/app?alpha&mid&zeta=1");
+
+    // Capacity is reused:
+    auto capacity = parameters.capacity();
+    EXPECT_TRUE(h2agent::model::splitQueryParameters("b=2;a=1", parameters, ';'));
+    EXPECT_EQ(parameters.capacity(), capacity);
+    normalized.clear();
+    h2agent::model::appendQueryParameters(normalized, parameters, ';');
+    EXPECT_EQ(normalized, "a=1;b=2");
+
+    // Repeated key:
+    EXPECT_FALSE(h2agent::model::splitQueryParameters(QueryParametersExampleBadKey, parameters));
+    EXPECT_TRUE(parameters.empty());
+
+    // Map materialization:
+    EXPECT_TRUE(h2agent::model::splitQueryParameters(QueryParametersExampleDefault, parameters));
+    EXPECT_EQ(h2agent::model::queryParametersMap(parameters), qmap_amp_);
+}
+
 TEST_F(functions_test, EncodedQueryParameter)
 {
     EXPECT_EQ(qmap_enc_.size(), 2);
@@ -330,3 +366,18 @@ TEST_F(functions_test, FixMetricsNameMixedCharacters) {
     ASSERT_EQ(expected_output, h2agent::model::fixMetricsName(input));
 }
 
+
+TEST_F(functions_test, RegexLiteralPrefix) {
+    EXPECT_EQ(h2agent::model::regexLiteralPrefix("initial#GET#/app/v1/foo/bar"), "initial#GET#/app/v1/foo/bar");
+    EXPECT_EQ(h2agent::model::regexLiteralPrefix("initial#GET#(/foo/bar/)([0-9]{3})"), "initial#GET#");
+    EXPECT_EQ(h2agent::model::regexLiteralPrefix("initial#GET#/foo/bar/[0-9]+"), "initial#GET#/foo/bar/");
+    EXPECT_EQ(h2agent::model::regexLiteralPrefix("initial#GET#/foo/(bar|baz)"), "initial#GET#/foo/");
+    EXPECT_EQ(h2agent::model::regexLiteralPrefix("initial#GET#/foo/bars?"), "initial#GET#/foo/bar");
+    EXPECT_EQ(h2agent::model::regexLiteralPrefix("initial#GET#/foo/bars*"), "initial#GET#/foo/bar");
+    EXPECT_EQ(h2agent::model::regexLiteralPrefix("initial#GET#/foo/bars{0,2}"), "initial#GET#/foo/bar");
+    EXPECT_EQ(h2agent::model::regexLiteralPrefix("initial#GET#/foo/bars+"), "initial#GET#/foo/bars");
+    EXPECT_EQ(h2agent::model::regexLiteralPrefix("initial#GET#/foo\\.bar"), "initial#GET#/foo");
+    EXPECT_EQ(h2agent::model::regexLiteralPrefix("initial|other#GET#/foo"), "");
+    EXPECT_EQ(h2agent::model::regexLiteralPrefix("initial#GET#/foo/[a|b]"), "initial#GET#/foo/");
+    EXPECT_EQ(h2agent::model::regexLiteralPrefix(".*"), "");
+}
@@ -0,0 +1,65 @@
+#include <Random.hpp>
+
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+
+TEST(Random_test, SameSeedSameSequence)
+{
+    h2agent::model::RandomGenerator g1(1234), g2(1234), g3(4321);
+    bool differs = false;
+    for (int k = 0; k < 100; k++) {
+        std::uint64_t v1 = g1.next();
+        EXPECT_EQ(v1, g2.next());
+        if (v1 != g3.next()) differs = true;
+    }
+    EXPECT_TRUE(differs);
+}
+
+TEST(Random_test, BelowIsWithinBounds)
+{
+    h2agent::model::RandomGenerator g(1);
+    std::set<std::uint64_t> seen;
+    for (int k = 0; k < 10000; k++) {
+        std::uint64_t v = g.below(7);
+        EXPECT_LT(v, 7);
+        seen.insert(v);
+    }
+    EXPECT_EQ(seen.size(), 7);
+    EXPECT_EQ(g.below(1), 0);
+}
+
+TEST(Random_test, RangeIsInclusiveAndSupportsNegatives)
+{
+    std::set<std::int64_t> seen;
+    for (int k = 0; k < 10000; k++) {
+        std::int64_t v = h2agent::model::randomInRange(-3, 3);
+        EXPECT_GE(v, -3);
+        EXPECT_LE(v, 3);
+        seen.insert(v);
+    }
+    EXPECT_EQ(seen.size(), 7);
+    EXPECT_EQ(h2agent::model::randomInRange(5, 5), 5);
+}
+
+TEST(Random_test, IndexIsWithinSize)
+{
+    for (int k = 0; k < 1000; k++) {
+        EXPECT_LT(h2agent::model::randomIndex(3), 3);
+    }
+}
+
+TEST(Random_test, ThreadsGetDifferentSequences)
+{
+    std::uint64_t first{}, second{};
+    std::thread t1([&] { first = h2agent::model::randomGenerator().next(); });
+    t1.join();
+    std::thread t2([&] { second = h2agent::model::randomGenerator().next(); });
+    t2.join();
+    EXPECT_NE(first, second);
+}
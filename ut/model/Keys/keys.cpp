@@ -290,3 +290,21 @@ TEST(keys, eventLocationKeyTwoPartsPresence) {
     h2agent::model::EventLocationKey elkey4("myClientEndpointId", "POST", "/foo/bar", "", "");
     EXPECT_TRUE(elkey4.checkSelection());
 }
+
+TEST(keys, compositeKeyView) {
+    std::string key;
+    h2agent::model::CompositeKeyView("initial", "POST", "/foo/bar").compose(key);
+    EXPECT_EQ(key, "initial#POST#/foo/bar");
+
+    h2agent::model::CompositeKeyView("POST", "/foo/bar").compose(key); // buffer reused
+    EXPECT_EQ(key, "POST#/foo/bar");
+
+    h2agent::model::CompositeKeyView("initial", "POST", "").compose(key); // same than calculateStringKey()
+    std::string expected;
+    h2agent::model::calculateStringKey(expected, "initial", "POST", "");
+    EXPECT_EQ(key, expected);
+
+    h2agent::model::DataKey dataKey("myClientEndpointId", "POST", "/foo/bar");
+    h2agent::model::CompositeKeyView(dataKey).compose(key);
+    EXPECT_EQ(key, dataKey.getKey());
+}
@@ -0,0 +1,155 @@
+#include <EventArena.hpp>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+
+struct Record {
+    std::uint64_t a{};
+    std::uint64_t b{};
+};
+
+TEST(EventArena_test, SlabPoolRecyclesBlocks)
+{
+    h2agent::model::SlabPool pool(sizeof(Record), 4);
+    const std::size_t n = pool.blocksPerSlab();
+    EXPECT_GE(n, 4);
+
+    std::vector<void*> blocks;
+    for (std::size_t k = 0; k < 2 * n + 1; k++) blocks.push_back(pool.allocate());
+    EXPECT_EQ(pool.slabs(), 3);
+    EXPECT_EQ(pool.used(), 2 * n + 1);
+
+    void *last = blocks.back();
+    pool.deallocate(last);
+    blocks.pop_back();
+    EXPECT_EQ(pool.allocate(), last); // recycled
+    blocks.push_back(last);
+
+    for (auto b: blocks) pool.deallocate(b);
+    EXPECT_EQ(pool.used(), 0);
+    EXPECT_EQ(pool.slabs(), 1); // empty slabs released, but the spare one
+
+    for (std::size_t k = 0; k < n; k++) pool.allocate();
+    EXPECT_EQ(pool.slabs(), 1);
+}
+
+TEST(EventArena_test, SlabPoolReleasesEmptySlabs)
+{
+    h2agent::model::SlabPool pool(sizeof(Record), 4);
+    const std::size_t n = pool.blocksPerSlab();
+
+    std::vector<void*> blocks;
+    for (std::size_t k = 0; k < 3 * n; k++) blocks.push_back(pool.allocate());
+    EXPECT_EQ(pool.slabs(), 3);
+
+    for (std::size_t k = 0; k < n; k++) pool.deallocate(blocks[k]);
+    EXPECT_EQ(pool.slabs(), 3); // first empty slab is kept as spare
+
+    for (std::size_t k = n; k < 2 * n; k++) pool.deallocate(blocks[k]);
+    EXPECT_EQ(pool.slabs(), 2); // released while others are in use
+    EXPECT_EQ(pool.used(), n);
+
+    for (std::size_t k = 2 * n; k < 3 * n; k++) pool.deallocate(blocks[k]);
+    EXPECT_EQ(pool.slabs(), 1);
+    EXPECT_EQ(pool.used(), 0);
+}
+
+TEST(EventArena_test, SlabPoolConcurrentThreads)
+{
+    h2agent::model::SlabPool pool(sizeof(Record), 8);
+    std::vector<std::vector<void*>> blocks(4);
+
+    std::vector<std::thread> threads;
+    for (auto &own: blocks) {
+        threads.emplace_back([&pool, &own]() {
+            for (int k = 0; k < 1000; k++) {
+                Record *record = new (pool.allocate()) Record{};
+                record->a = k;
+                own.push_back(record);
+                if (k % 3 == 0) {
+                    pool.deallocate(own.front());
+                    own.erase(own.begin());
+                }
+            }
+        });
+    }
+    for (auto &t: threads) t.join();
+    threads.clear();
+
+    // Blocks released by other threads than the allocating ones:
+    for (std::size_t t = 0; t < blocks.size(); t++) {
+        threads.emplace_back([&pool, &blocks, t]() {
+            for (auto b: blocks[(t + 1) % blocks.size()]) pool.deallocate(b);
+        });
+    }
+    for (auto &t: threads) t.join();
+
+    EXPECT_EQ(pool.used(), 0);
+    EXPECT_LE(pool.slabs(), h2agent::model::EventPoolStripes); // at most one spare per stripe
+}
+
+TEST(EventArena_test, SlabAllocatorSharedObjects)
+{
+    std::vector<std::shared_ptr<Record>> records;
+    for (int k = 0; k < 1000; k++) {
+        auto record = std::allocate_shared<Record>(h2agent::model::SlabAllocator<Record>());
+        record->a = k;
+        records.push_back(record);
+    }
+    for (int k = 0; k < 1000; k++) EXPECT_EQ(records[k]->a, k);
+    records.clear();
+}
+
+TEST(EventArena_test, InternedStrings)
+{
+    h2agent::model::StringInterner interner(2);
+    h2agent::model::InternedString s1, s2, s3, s4;
+
+    s1.assign("initial", interner);
+    s2.assign("initial", interner);
+    EXPECT_EQ(&s1.str(), &s2.str()); // shared
+    EXPECT_EQ(s1.str(), "initial");
+
+    s3.assign("second", interner);
+    s4.assign("third", interner); // interner is full: owned
+    EXPECT_EQ(interner.size(), 2);
+    EXPECT_EQ(s4.str(), "third");
+
+    s4.assign("", interner);
+    EXPECT_TRUE(s4.empty());
+    EXPECT_EQ(s4.str(), "");
+
+    s3.assign("", interner); // "second" released: its entry is reclaimed
+    s4.assign("fourth", interner);
+    h2agent::model::InternedString s5;
+    s5.assign("fourth", interner);
+    EXPECT_EQ(&s4.str(), &s5.str()); // shared
+    EXPECT_EQ(interner.size(), 2);
+}
+
+TEST(EventArena_test, CompactHeaders)
+{
+    nghttp2::asio_http2::header_map headers{{"content-type", {"application/json", false}}, {"x-token", {"secret", true}}};
+    h2agent::model::CompactHeaders compact;
+    EXPECT_TRUE(compact.empty());
+    compact.assign(headers);
+    EXPECT_FALSE(compact.empty());
+
+    std::vector<std::string> names;
+    compact.forEach([&names](std::string &&name, std::string &&, bool) {
+        names.push_back(name);
+    });
+    EXPECT_EQ(names, std::vector<std::string>({"content-type", "x-token"}));
+
+    auto it = compact.map().find("x-token");
+    ASSERT_TRUE(it != compact.map().end());
+    EXPECT_EQ(it->second.value, "secret");
+    EXPECT_TRUE(it->second.sensitive);
+    EXPECT_EQ(compact.map().size(), 2);
+}
@@ -0,0 +1,78 @@
+#include <LruCache.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+
+typedef h2agent::model::LruCache<std::string, std::string, 1> single_stripe_cache_t;
+
+TEST(LruCache_test, GetPut)
+{
+    single_stripe_cache_t cache(4);
+    std::string value;
+
+    EXPECT_FALSE(cache.get("a", value));
+    cache.put("a", "A");
+    EXPECT_TRUE(cache.get("a", value));
+    EXPECT_EQ(value, "A");
+
+    cache.put("a", "AA"); // update
+    EXPECT_TRUE(cache.get("a", value));
+    EXPECT_EQ(value, "AA");
+    EXPECT_EQ(cache.size(), 1);
+
+    EXPECT_EQ(cache.hits(), 2);
+    EXPECT_EQ(cache.misses(), 1);
+}
+
+TEST(LruCache_test, EvictsLeastRecentlyUsed)
+{
+    single_stripe_cache_t cache(3);
+    std::string value;
+
+    cache.put("a", "A");
+    cache.put("b", "B");
+    cache.put("c", "C");
+    EXPECT_TRUE(cache.get("a", value)); // 'b' becomes the least recently used
+    cache.put("d", "D");
+
+    EXPECT_EQ(cache.size(), 3);
+    EXPECT_FALSE(cache.get("b", value));
+    EXPECT_TRUE(cache.get("a", value));
+    EXPECT_TRUE(cache.get("c", value));
+    EXPECT_TRUE(cache.get("d", value));
+}
+
+TEST(LruCache_test, StripedCapacity)
+{
+    h2agent::model::LruCache<std::string, std::string, 4> cache(10);
+    EXPECT_EQ(cache.capacity(), 12); // rounded up to stripes multiple
+
+    for (int k = 0; k < 100; k++) cache.put(std::to_string(k), "value");
+    EXPECT_LE(cache.size(), cache.capacity());
+}
+
+TEST(LruCache_test, Concurrency)
+{
+    h2agent::model::LruCache<std::string, std::string> cache(64);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&cache, t]() {
+            std::string value;
+            for (int k = 0; k < 1000; k++) {
+                std::string key = std::to_string((k + t) % 128);
+                if (!cache.get(key, value)) cache.put(key, key);
+                else EXPECT_EQ(value, key);
+            }
+        });
+    }
+    for (auto &thread : threads) thread.join();
+
+    EXPECT_EQ(cache.hits() + cache.misses(), 8000);
+    EXPECT_LE(cache.size(), cache.capacity());
+}
@@ -0,0 +1,122 @@
+#include <Map.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+
+typedef h2agent::model::Map<std::string, int> single_map_t;
+typedef h2agent::model::Map<std::string, int, 8> striped_map_t;
+
+template <typename MapType>
+class Map_test : public ::testing::Test
+{
+public:
+    MapType map_{};
+};
+
+typedef ::testing::Types<single_map_t, striped_map_t> MapTypes;
+TYPED_TEST_SUITE(Map_test, MapTypes);
+
+TYPED_TEST(Map_test, AddGetRemove)
+{
+    bool exists{};
+    EXPECT_TRUE(this->map_.empty());
+
+    for (int k = 0; k < 100; k++) this->map_.add(std::to_string(k), k);
+    this->map_.add("7", 70); // replace
+    EXPECT_EQ(this->map_.size(), 100);
+    EXPECT_EQ(this->map_.get("7", exists), 70);
+    EXPECT_TRUE(exists);
+
+    int value{};
+    EXPECT_TRUE(this->map_.tryGet("99", value));
+    EXPECT_EQ(value, 99);
+    EXPECT_FALSE(this->map_.tryGet("100", value));
+
+    this->map_.remove("7", exists);
+    EXPECT_TRUE(exists);
+    this->map_.remove("7", exists);
+    EXPECT_FALSE(exists);
+    EXPECT_FALSE(this->map_.exists("7"));
+    EXPECT_EQ(this->map_.size(), 99);
+
+    this->map_.modifyOrInsert("7", [](int &v) { v += 5; });
+    this->map_.modifyOrInsert("7", [](int &v) { v += 5; });
+    EXPECT_EQ(this->map_.get("7", exists), 10);
+    EXPECT_EQ(this->map_.size(), 100);
+
+    this->map_.modifyOrErase("7", [](int &v) { v += 5; return true; });
+    EXPECT_EQ(this->map_.get("7", exists), 15);
+    this->map_.modifyOrErase("7", [](int &v) { return false; });
+    EXPECT_FALSE(this->map_.exists("7"));
+    this->map_.modifyOrErase("7", [](int &v) { return false; }); // missing key is not left behind
+    EXPECT_FALSE(this->map_.exists("7"));
+    EXPECT_EQ(this->map_.size(), 99);
+    this->map_.modifyOrErase(h2agent::model::CompositeKeyView("7", "8"), [](int &v) { v = 78; return true; });
+    EXPECT_EQ(this->map_.get("7#8", exists), 78);
+    EXPECT_EQ(this->map_.size(), 100);
+
+    EXPECT_TRUE(this->map_.clear());
+    EXPECT_FALSE(this->map_.clear());
+    EXPECT_TRUE(this->map_.empty());
+}
+
+TYPED_TEST(Map_test, CompositeKey)
+{
+    bool exists{};
+    h2agent::model::CompositeKeyView key("initial", "POST", "/foo/bar");
+
+    this->map_.add(key, 1);
+    EXPECT_EQ(this->map_.get("initial#POST#/foo/bar", exists), 1);
+    EXPECT_TRUE(this->map_.exists(key));
+
+    int value{};
+    EXPECT_TRUE(this->map_.tryGet(key, value));
+    EXPECT_EQ(value, 1);
+    EXPECT_FALSE(this->map_.tryGet(h2agent::model::CompositeKeyView("initial", "POST", ""), value));
+    EXPECT_TRUE(this->map_.tryRead(key, [&value](const int &v) { value = v + 1; }));
+    EXPECT_EQ(value, 2);
+
+    this->map_.remove(key, exists);
+    EXPECT_TRUE(exists);
+    EXPECT_TRUE(this->map_.empty());
+}
+
+TYPED_TEST(Map_test, WholeContainerAccess)
+{
+    this->map_.add(std::unordered_map<std::string, int>{{"a", 1}, {"b", 2}, {"c", 3}});
+
+    int sum{};
+    this->map_.forEach([&sum](const std::string &, const int &v) { sum += v; });
+    EXPECT_EQ(sum, 6);
+    EXPECT_EQ(this->map_.getJson(), nlohmann::json({{"a", 1}, {"b", 2}, {"c", 3}}));
+
+    TypeParam copy(this->map_);
+    EXPECT_EQ(copy.size(), 3);
+    EXPECT_EQ(copy.getJson(), this->map_.getJson());
+}
+
+TYPED_TEST(Map_test, ConcurrentAccess)
+{
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([this, t]() {
+            for (int k = 0; k < 1000; k++) {
+                std::string key = std::to_string(t) + "." + std::to_string(k);
+                this->map_.add(key, k);
+                this->map_.modifyOrInsert("counter", [](int &v) { v++; });
+            }
+        });
+    }
+    for (auto &th : threads) th.join();
+
+    bool exists{};
+    EXPECT_EQ(this->map_.size(), 8001);
+    EXPECT_EQ(this->map_.get("counter", exists), 8000);
+}
@@ -342,6 +342,109 @@ TEST_F(MockServerData_test, DefaultStateInitial)
     EXPECT_EQ(latestState, "initial");
 }
 
+TEST_F(MockServerData_test, Sessions)
+{
+    h2agent::model::DataKey key("PUT", "/the/put/uri");
+    EXPECT_EQ(data_.findSession(key), nullptr); // sessions are independent from events
+    EXPECT_EQ(data_.sessionsSize(), 0);
+
+    auto vars = std::make_shared<const std::map<std::string, std::string>>(std::map<std::string, std::string> {{"id", "1"}});
+    data_.updateSession(key, "second", vars);
+    auto session = data_.findSession(key);
+    ASSERT_NE(session, nullptr);
+    EXPECT_EQ(session->state, "second");
+    EXPECT_EQ(session->chainVariables, vars); // shared, not copied
+
+    // Foreign state update keeps chain variables:
+    data_.updateSessionState(key, "third");
+    session = data_.findSession(key);
+    ASSERT_NE(session, nullptr);
+    EXPECT_EQ(session->state, "third");
+    EXPECT_EQ(session->chainVariables, vars);
+
+    // Initial state is kept while chain variables exist:
+    data_.updateSession(key, "initial", vars);
+    EXPECT_EQ(data_.sessionsSize(), 1);
+
+    // Initial state without chain variables drops the session:
+    data_.updateSession(key, "initial", std::make_shared<const std::map<std::string, std::string>>());
+    EXPECT_EQ(data_.findSession(key), nullptr);
+    EXPECT_EQ(data_.sessionsSize(), 0);
+
+    // Unprovisioned (empty) state drops chain variables:
+    data_.updateSession(key, "second", vars);
+    data_.updateSession(key, "", vars);
+    EXPECT_EQ(data_.findSession(key), nullptr);
+}
+
+TEST_F(MockServerData_test, SessionsClear)
+{
+    h2agent::model::DataKey key1("DELETE", "/the/uri/111");
+    h2agent::model::DataKey key2("DELETE", "/the/uri/222");
+    data_.updateSession(key1, "state", nullptr);
+    data_.updateSession(key2, "state", nullptr);
+
+    // Removing the latest event, resynchronizes the state with the remaining history:
+    data_.loadEvent(key1, previous_state_, "latest", reception_timestamp_us_, 201, request_headers_, response_headers_, request_body_data_part_, response_body_, 112 /* server sequence */, 20 /* response delay ms */, true /* history */);
+    data_.updateSession(key1, "latest", nullptr);
+    bool somethingDeleted{};
+    EXPECT_TRUE(data_.clear(somethingDeleted, h2agent::model::EventKey(key1, "-1")));
+    EXPECT_TRUE(somethingDeleted);
+    ASSERT_NE(data_.findSession(key1), nullptr);
+    EXPECT_EQ(data_.findSession(key1)->state, "state");
+
+    // Whole key:
+    EXPECT_TRUE(data_.clear(somethingDeleted, h2agent::model::EventKey(key1, "")));
+    EXPECT_EQ(data_.findSession(key1), nullptr);
+    EXPECT_NE(data_.findSession(key2), nullptr);
+
+    // Everything (even sessions without events):
+    h2agent::model::DataKey key3("GET", "/no/events");
+    data_.updateSession(key3, "state", nullptr);
+    EXPECT_TRUE(data_.clear(somethingDeleted, h2agent::model::EventKey("", "", "")));
+    EXPECT_EQ(data_.sessionsSize(), 0);
+}
+
+TEST_F(MockServerData_test, SessionsRetention)
+{
+    h2agent::model::MockServerData data;
+    h2agent::model::DataKey key1("POST", "/the/uri/1");
+    h2agent::model::DataKey key2("POST", "/the/uri/2");
+
+    // Sessions are accounted in the storage:
+    data.updateSession(key1, "state", nullptr);
+    std::int64_t sessionBytes = data.getStorageBytes();
+    EXPECT_GT(sessionBytes, 0);
+    data.updateSessionState(key1, "another");
+    EXPECT_EQ(data.getStorageBytes(), sessionBytes + 2);
+    data.updateSessionState(key1, "initial");
+    EXPECT_EQ(data.sessionsSize(), 0);
+    EXPECT_EQ(data.getStorageBytes(), 0);
+
+    // Evicted keys restart from initial state:
+    data.loadEvent(key1, previous_state_, state_, std::chrono::microseconds(1), 201, request_headers_, response_headers_, request_body_data_part_, response_body_, 1, 0, false /* history */);
+    data.updateSession(key1, "state", nullptr);
+    std::int64_t keyBytes = data.getStorageBytes();
+    data.setRetention(0, keyBytes + keyBytes / 2);
+    data.loadEvent(key2, previous_state_, state_, std::chrono::microseconds(2), 201, request_headers_, response_headers_, request_body_data_part_, response_body_, 2, 0, false /* history */);
+    data.updateSession(key2, "state", nullptr);
+    EXPECT_FALSE(data.exists(key1.getKey()));
+    EXPECT_EQ(data.findSession(key1), nullptr);
+    EXPECT_NE(data.findSession(key2), nullptr);
+
+    // Sessions without events are bounded too:
+    bool somethingDeleted{};
+    data.clear(somethingDeleted, h2agent::model::EventKey("", "", ""));
+    EXPECT_EQ(data.getStorageBytes(), 0);
+    data.setRetention(0, 100 * sessionBytes);
+    for (int k = 0; k < 1000; k++) {
+        data.updateSession(h2agent::model::DataKey("POST", "/the/uri/" + std::to_string(k % 10) + "/" + std::to_string(k)), "state", nullptr);
+        EXPECT_LE(data.getStorageBytes(), 100 * sessionBytes);
+    }
+    EXPECT_LE(data.sessionsSize(), 100);
+    EXPECT_GT(data.sessionsSize(), 0);
+    EXPECT_NE(data.findSession(h2agent::model::DataKey("POST", "/the/uri/9/999")), nullptr); // latest kept
+}
 
 // Sequence tests
 
@@ -378,3 +481,121 @@ TEST_F(MockServerData_test, SequenceFilterByUriRegex)
     auto json = nlohmann::json::parse(result);
     EXPECT_EQ(json.size(), 2); // only key1 events match
 }
+
+TEST_F(MockServerData_test, RetentionMaxEventsPerKey)
+{
+    h2agent::model::MockServerData data;
+    data.setRetention(3, 0);
+    h2agent::model::DataKey key("POST", "/the/uri");
+    for (std::uint64_t seq = 1; seq <= 10; seq++) {
+        data.loadEvent(key, previous_state_, state_, std::chrono::microseconds(seq), 201, request_headers_, response_headers_, request_body_data_part_, response_body_, seq, 0, true /* history */);
+    }
+
+    bool validQuery{};
+    auto json = nlohmann::json::parse(data.asJsonString(h2agent::model::EventLocationKey("POST", "/the/uri", "", ""), validQuery));
+    ASSERT_EQ(json["events"].size(), 3); // ring buffer: the latest ones
+    EXPECT_EQ(json["events"][0]["recvseq"], 8);
+    EXPECT_EQ(json["events"][2]["recvseq"], 10);
+    EXPECT_EQ(data.getEvent(h2agent::model::EventKey(key, "1"))->getReceptionTimestampUs(), 8);
+    EXPECT_EQ(data.getEventByRecvSeq(key, 7), nullptr);
+    EXPECT_TRUE(data.getEventByRecvSeq(key, 9) != nullptr);
+}
+
+TEST_F(MockServerData_test, RetentionMaxBytes)
+{
+    h2agent::model::MockServerData data;
+    h2agent::model::DataKey key1("POST", "/the/uri/1");
+    h2agent::model::DataKey key2("POST", "/the/uri/2");
+    h2agent::model::DataKey key3("POST", "/the/uri/3");
+
+    data.loadEvent(key1, previous_state_, state_, std::chrono::microseconds(1), 201, request_headers_, response_headers_, request_body_data_part_, response_body_, 1, 0, true /* history */);
+    std::int64_t eventBytes = data.getStorageBytes();
+    EXPECT_GT(eventBytes, 0);
+
+    data.setRetention(0, 2 * eventBytes); // room for two events
+    data.loadEvent(key2, previous_state_, state_, std::chrono::microseconds(2), 201, request_headers_, response_headers_, request_body_data_part_, response_body_, 2, 0, true /* history */);
+    EXPECT_EQ(data.size(), 2);
+
+    data.loadEvent(key3, previous_state_, state_, std::chrono::microseconds(3), 201, request_headers_, response_headers_, request_body_data_part_, response_body_, 3, 0, true /* history */);
+    EXPECT_EQ(data.size(), 2); // least recently updated key evicted
+    EXPECT_FALSE(data.exists(key1.getKey()));
+    EXPECT_TRUE(data.exists(key2.getKey()));
+    EXPECT_TRUE(data.exists(key3.getKey()));
+    EXPECT_EQ(data.getStorageBytes(), 2 * eventBytes);
+
+    bool somethingDeleted{};
+    data.clear(somethingDeleted, h2agent::model::EventKey("", "", ""));
+    EXPECT_EQ(data.getStorageBytes(), 0);
+}
+
+TEST_F(MockServerData_test, RetentionMaxBytesRecency)
+{
+    h2agent::model::MockServerData data;
+    h2agent::model::DataKey key1("POST", "/the/uri/1");
+    h2agent::model::DataKey key2("POST", "/the/uri/2");
+    h2agent::model::DataKey key3("POST", "/the/uri/3");
+
+    data.loadEvent(key1, previous_state_, state_, std::chrono::microseconds(1), 201, request_headers_, response_headers_, request_body_data_part_, response_body_, 1, 0, false /* history */);
+    std::int64_t eventBytes = data.getStorageBytes();
+
+    data.setRetention(0, 2 * eventBytes);
+    data.loadEvent(key2, previous_state_, state_, std::chrono::microseconds(2), 201, request_headers_, response_headers_, request_body_data_part_, response_body_, 2, 0, false /* history */);
+    data.loadEvent(key1, previous_state_, state_, std::chrono::microseconds(3), 201, request_headers_, response_headers_, request_body_data_part_, response_body_, 3, 0, false /* history */); // updated again
+    data.loadEvent(key3, previous_state_, state_, std::chrono::microseconds(4), 201, request_headers_, response_headers_, request_body_data_part_, response_body_, 4, 0, false /* history */);
+    EXPECT_EQ(data.size(), 2);
+    EXPECT_TRUE(data.exists(key1.getKey()));
+    EXPECT_FALSE(data.exists(key2.getKey())); // least recently updated
+    EXPECT_TRUE(data.exists(key3.getKey()));
+}
+
+TEST_F(MockServerData_test, RetentionMaxBytesRecencyUpdatedWhileQueued)
+{
+    h2agent::model::MockServerData data;
+    std::vector<h2agent::model::DataKey> keys;
+    for (int k = 1; k <= 5; k++) keys.emplace_back("POST", "/the/uri/" + std::to_string(k));
+
+    data.loadEvent(keys[0], previous_state_, state_, std::chrono::microseconds(1), 201, request_headers_, response_headers_, request_body_data_part_, response_body_, 1, 0, false /* history */);
+    std::int64_t eventBytes = data.getStorageBytes();
+
+    data.setRetention(0, 3 * eventBytes);
+    data.loadEvent(keys[1], previous_state_, state_, std::chrono::microseconds(2), 201, request_headers_, response_headers_, request_body_data_part_, response_body_, 2, 0, false /* history */);
+    data.loadEvent(keys[2], previous_state_, state_, std::chrono::microseconds(3), 201, request_headers_, response_headers_, request_body_data_part_, response_body_, 3, 0, false /* history */);
+    data.loadEvent(keys[3], previous_state_, state_, std::chrono::microseconds(4), 201, request_headers_, response_headers_, request_body_data_part_, response_body_, 4, 0, false /* history */); // evicts first key
+    EXPECT_FALSE(data.exists(keys[0].getKey()));
+
+    // Second key was queued for eviction, but it is updated again before the next one:
+    data.loadEvent(keys[1], previous_state_, state_, std::chrono::microseconds(5), 201, request_headers_, response_headers_, request_body_data_part_, response_body_, 5, 0, false /* history */);
+    data.loadEvent(keys[4], previous_state_, state_, std::chrono::microseconds(6), 201, request_headers_, response_headers_, request_body_data_part_, response_body_, 6, 0, false /* history */);
+    EXPECT_EQ(data.size(), 3);
+    EXPECT_TRUE(data.exists(keys[1].getKey()));
+    EXPECT_FALSE(data.exists(keys[2].getKey())); // least recently updated
+    EXPECT_TRUE(data.exists(keys[3].getKey()));
+    EXPECT_TRUE(data.exists(keys[4].getKey()));
+}
+
+TEST_F(MockServerData_test, RetentionMaxBytesSingleKey)
+{
+    h2agent::model::MockServerData data;
+    h2agent::model::DataKey key("POST", "/the/uri");
+
+    data.loadEvent(key, previous_state_, state_, std::chrono::microseconds(1), 201, request_headers_, response_headers_, request_body_data_part_, response_body_, 1, 0, true /* history */);
+    std::int64_t eventBytes = data.getStorageBytes();
+
+    // A single key beyond the budget is trimmed (oldest events first):
+    data.setRetention(0, 2 * eventBytes);
+    for (std::uint64_t seq = 2; seq <= 5; seq++) {
+        data.loadEvent(key, previous_state_, state_, std::chrono::microseconds(seq), 201, request_headers_, response_headers_, request_body_data_part_, response_body_, seq, 0, true /* history */);
+    }
+    EXPECT_EQ(data.getStorageBytes(), 2 * eventBytes);
+    EXPECT_EQ(data.getEventByRecvSeq(key, 3), nullptr);
+    EXPECT_TRUE(data.getEventByRecvSeq(key, 4) != nullptr);
+    EXPECT_TRUE(data.getEventByRecvSeq(key, 5) != nullptr);
+
+    // And evicted when its latest event alone does not fit:
+    data.setRetention(0, eventBytes / 2);
+    auto event = data.loadEvent(key, previous_state_, state_, std::chrono::microseconds(6), 201, request_headers_, response_headers_, request_body_data_part_, response_body_, 6, 0, true /* history */);
+    EXPECT_EQ(data.size(), 0);
+    EXPECT_EQ(data.getStorageBytes(), 0);
+    ASSERT_TRUE(event != nullptr); // still owned by the caller
+    EXPECT_EQ(event->getRecvSeq(), 6);
+}
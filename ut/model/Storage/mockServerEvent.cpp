@@ -1,5 +1,7 @@
 #include <MockServerEvent.hpp>
 
+#include <thread>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -102,3 +104,35 @@ TEST_F(MockServerEvent_test, GetJsonWithoutSendingTimestamp)
     // Before setSendingTimestampUs is called, field should not be present
     EXPECT_FALSE(data_.getJson().contains("sendingTimestampUs"));
 }
+
+TEST_F(MockServerEvent_test, GetJsonBuiltBeforeSendingTimestamp)
+{
+    // Json view is built on first access, and later updates are merged on queries:
+    EXPECT_FALSE(data_.getJson().contains("sendingTimestampUs"));
+
+    std::chrono::microseconds ts(1715000000100);
+    data_.setSendingTimestampUs(ts);
+    EXPECT_EQ(data_.getJson()["sendingTimestampUs"], 1715000000100);
+}
+
+TEST_F(MockServerEvent_test, GetJsonPath)
+{
+    EXPECT_EQ(data_.getJson("/recvseq"), 111);
+    EXPECT_TRUE(data_.getJson("/sendingTimestampUs").is_null());
+    EXPECT_TRUE(data_.getJson("/missing").is_null());
+    EXPECT_FALSE(data_.getJson().contains("missing")); // queries don't modify the view
+
+    data_.setSendingTimestampUs(std::chrono::microseconds(1715000000100));
+    EXPECT_EQ(data_.getJson("/sendingTimestampUs"), 1715000000100);
+}
+
+TEST_F(MockServerEvent_test, GetJsonWhileSendingTimestampIsSet)
+{
+    std::thread reader([this] {
+        for (int k = 0; k < 200; k++) data_.getJson().dump();
+    });
+    for (int k = 1; k <= 200; k++) data_.setSendingTimestampUs(std::chrono::microseconds(k));
+    reader.join();
+
+    EXPECT_EQ(data_.getJson()["sendingTimestampUs"], 200);
+}
@@ -155,3 +155,63 @@ TEST_F(MockServerEventsHistory_test, RemoveFirstUsingReverse)
     EXPECT_EQ(assertedJson, expectedJson);
 }
 
+TEST_F(MockServerEventsHistory_test, GetAndRemoveByRecvSeq)
+{
+    // Add events with unique sequences (fourth to tenth positions):
+    for (std::uint64_t seq = 1; seq <= 7; seq++) {
+        data_.loadEvent(previous_state_, "state" + std::to_string(seq), reception_timestamp_us_, 201, request_headers_, response_headers_, request_body_data_part_, response_body_, seq /* server sequence */, 20 /* response delay ms */, true /* history */);
+    }
+    EXPECT_EQ(data_.size(), 10);
+
+    // Repeated sequence gives the first one loaded:
+    EXPECT_EQ(data_.getEventByRecvSeq(111), data_.getEvent(1, false));
+    EXPECT_EQ(data_.getEventByRecvSeq(4)->getState(), "state4");
+    EXPECT_EQ(data_.getEventByRecvSeq(8), nullptr);
+
+    // Remove in the middle, and positions are kept coherent:
+    EXPECT_TRUE(data_.removeEventByRecvSeq(4));
+    EXPECT_FALSE(data_.removeEventByRecvSeq(4));
+    EXPECT_EQ(data_.getEventByRecvSeq(4), nullptr);
+    EXPECT_EQ(data_.size(), 9);
+    EXPECT_EQ(data_.getEvent(7, false)->getState(), "state5");
+    EXPECT_EQ(data_.getEvent(3, true)->getState(), "state5");
+    EXPECT_EQ(data_.getJson()["events"].size(), 9);
+
+    // Remove most of them (compaction) and the last one:
+    for (std::uint64_t seq: {1, 2, 3, 5, 7}) EXPECT_TRUE(data_.removeEventByRecvSeq(seq));
+    EXPECT_EQ(data_.size(), 4);
+    EXPECT_EQ(data_.getLastRegisteredRequestState(), "state6");
+    EXPECT_EQ(data_.getEventByRecvSeq(6), data_.getEvent(1, true));
+
+    // Positional removal keeps sequence index:
+    EXPECT_TRUE(data_.removeEvent(1, false));
+    EXPECT_EQ(data_.getEventByRecvSeq(111), data_.getEvent(1, false));
+    EXPECT_EQ(data_.size(), 3);
+}
+
+
+TEST_F(MockServerEventsHistory_test, GetByRecvSeqAfterDropsAndOverwrites)
+{
+    // Ring buffer drops the oldest ones (fixture events and sequences 1 to 17):
+    for (std::uint64_t seq = 1; seq <= 20; seq++) {
+        data_.loadEvent(previous_state_, "state" + std::to_string(seq), reception_timestamp_us_, 201, request_headers_, response_headers_, request_body_data_part_, response_body_, seq /* server sequence */, 20 /* response delay ms */, true /* history */, "", "", 3 /* max events */);
+    }
+    EXPECT_EQ(data_.size(), 3);
+    EXPECT_EQ(data_.getEventByRecvSeq(111), nullptr);
+    EXPECT_EQ(data_.getEventByRecvSeq(17), nullptr);
+    EXPECT_EQ(data_.getEventByRecvSeq(18)->getState(), "state18");
+    EXPECT_EQ(data_.getEventByRecvSeq(20), data_.getEvent(1, true));
+
+    // Sequences loaded out of order are found as well:
+    data_.loadEvent(previous_state_, "state19bis", reception_timestamp_us_, 201, request_headers_, response_headers_, request_body_data_part_, response_body_, 19 /* server sequence */, 20 /* response delay ms */, true /* history */);
+    EXPECT_EQ(data_.getEventByRecvSeq(19)->getState(), "state19");
+    EXPECT_TRUE(data_.removeEventByRecvSeq(19));
+    EXPECT_EQ(data_.getEventByRecvSeq(19)->getState(), "state19bis");
+
+    // No history: the overwritten event is not found anymore:
+    for (std::uint64_t seq = 30; seq <= 40; seq++) {
+        data_.loadEvent(previous_state_, "state" + std::to_string(seq), reception_timestamp_us_, 201, request_headers_, response_headers_, request_body_data_part_, response_body_, seq /* server sequence */, 20 /* response delay ms */, false /* history */);
+    }
+    EXPECT_EQ(data_.getEventByRecvSeq(39), nullptr);
+    EXPECT_EQ(data_.getEventByRecvSeq(40)->getState(), "state40");
+}
@@ -0,0 +1,59 @@
+#include <MpscQueue.hpp>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+
+TEST(MpscQueue_test, PushPopOrder)
+{
+    h2agent::model::MpscQueue<std::unique_ptr<int>> queue;
+    std::unique_ptr<int> value;
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.pop(value));
+
+    queue.push(std::make_unique<int>(1));
+    queue.push(std::make_unique<int>(2));
+    EXPECT_EQ(queue.size(), 2);
+
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(*value, 1);
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(*value, 2);
+    EXPECT_FALSE(queue.pop(value));
+    EXPECT_TRUE(queue.empty());
+
+    queue.push(std::make_unique<int>(3)); // released at destruction
+}
+
+TEST(MpscQueue_test, ConcurrentProducers)
+{
+    static constexpr int Producers = 4;
+    static constexpr int PerProducer = 10000;
+
+    h2agent::model::MpscQueue<int> queue;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < Producers; p++) {
+        producers.emplace_back([&queue, p] {
+            for (int i = 0; i < PerProducer; i++) queue.push(p * PerProducer + i);
+        });
+    }
+
+    // Consume while producing: values of each producer keep their order
+    std::vector<int> last(Producers, -1);
+    int consumed = 0, value = 0;
+    while (consumed < Producers * PerProducer) {
+        if (!queue.pop(value)) continue;
+        int p = value / PerProducer;
+        EXPECT_GT(value, last[p]);
+        last[p] = value;
+        consumed++;
+    }
+
+    for (auto &t: producers) t.join();
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,92 @@
+#include <PendingTable.hpp>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+
+typedef h2agent::model::PendingTable<std::shared_ptr<int>, 8> pending_table_t;
+
+TEST(PendingTable_test, AddTake)
+{
+    pending_table_t table;
+    std::shared_ptr<int> value;
+
+    EXPECT_FALSE(table.add(1, std::make_shared<int>(10)));
+    EXPECT_FALSE(table.add(2, std::make_shared<int>(20)));
+    EXPECT_FALSE(table.take(3, value));
+    EXPECT_FALSE(value);
+
+    EXPECT_TRUE(table.take(2, value));
+    EXPECT_EQ(*value, 20);
+    EXPECT_FALSE(table.take(2, value)); // already taken
+    EXPECT_TRUE(table.take(1, value));
+    EXPECT_EQ(*value, 10);
+    EXPECT_EQ(table.dropped(), 0);
+}
+
+TEST(PendingTable_test, Overflow)
+{
+    pending_table_t table;
+    std::shared_ptr<int> value;
+
+    EXPECT_FALSE(table.add(1, std::make_shared<int>(10)));
+    EXPECT_TRUE(table.add(1 + pending_table_t::capacity(), std::make_shared<int>(90))); // same slot
+    EXPECT_EQ(table.dropped(), 1);
+
+    EXPECT_FALSE(table.take(1, value)); // evicted
+    EXPECT_TRUE(table.take(1 + pending_table_t::capacity(), value));
+    EXPECT_EQ(*value, 90);
+
+    // Same id again is a replacement, not a drop:
+    EXPECT_FALSE(table.add(5, std::make_shared<int>(1)));
+    EXPECT_FALSE(table.add(5, std::make_shared<int>(2)));
+    EXPECT_EQ(table.dropped(), 1);
+}
+
+TEST(PendingTable_test, ConcurrentAccess)
+{
+    h2agent::model::PendingTable<std::shared_ptr<int>, 1024> table;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&table, t]() {
+            std::shared_ptr<int> value;
+            for (std::uint64_t k = t; k < 1024; k += 8) {
+                table.add(k, std::make_shared<int>(static_cast<int>(k)));
+                EXPECT_TRUE(table.take(k, value));
+                EXPECT_EQ(*value, static_cast<int>(k));
+            }
+        });
+    }
+    for (auto &th: threads) th.join();
+
+    EXPECT_EQ(table.dropped(), 0);
+}
+
+
+TEST(PendingTable_test, FindSizeClear)
+{
+    pending_table_t table;
+    std::shared_ptr<int> value;
+
+    EXPECT_TRUE(table.empty());
+    table.add(1, std::make_shared<int>(10));
+    table.add(1, std::make_shared<int>(11)); // replacement
+    table.add(2, std::make_shared<int>(20));
+    EXPECT_EQ(table.size(), 2);
+
+    EXPECT_TRUE(table.find(1, value));
+    EXPECT_EQ(*value, 11);
+    EXPECT_TRUE(table.find(1, value)); // kept
+    EXPECT_FALSE(table.find(3, value));
+
+    EXPECT_TRUE(table.take(1, value));
+    EXPECT_EQ(table.size(), 1);
+
+    table.clear();
+    EXPECT_TRUE(table.empty());
+    EXPECT_FALSE(table.find(2, value));
+}
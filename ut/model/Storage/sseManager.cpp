@@ -3,76 +3,168 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <thread>
+#include <chrono>
+
 class SseManager_test : public ::testing::Test
 {
 public:
     h2agent::model::SseManager mgr_{};
+
+    // Events are distributed by dispatch() (no dispatcher thread started here)
+    std::string received(uint64_t id) {
+        mgr_.dispatch();
+        std::string data;
+        mgr_.take(id, data);
+        return data;
+    }
 };
 
 TEST_F(SseManager_test, NotifyMatchingKey)
 {
-    std::string received;
-    auto id = mgr_.addConnection({"key1"}, [&](const std::string &data) {
-        received = data;
-    });
+    int wakes = 0;
+    auto id = mgr_.addConnection({"key1"}, false, [&] { wakes++; });
 
     mgr_.notify("key1", nlohmann::json("value1"));
-    EXPECT_NE(received.find("\"key\":\"key1\""), std::string::npos);
-    EXPECT_NE(received.find("\"value\":\"value1\""), std::string::npos);
-    EXPECT_NE(received.find("event: vault-set\n"), std::string::npos);
+    std::string data = received(id);
+    EXPECT_NE(data.find("\"key\":\"key1\""), std::string::npos);
+    EXPECT_NE(data.find("\"value\":\"value1\""), std::string::npos);
+    EXPECT_NE(data.find("event: vault-set\n"), std::string::npos);
+    EXPECT_EQ(wakes, 1);
 
     mgr_.removeConnection(id);
 }
 
 TEST_F(SseManager_test, NotifyNonMatchingKeyIsFiltered)
 {
-    std::string received;
-    auto id = mgr_.addConnection({"key1"}, [&](const std::string &data) {
-        received = data;
-    });
+    int wakes = 0;
+    auto id = mgr_.addConnection({"key1"}, false, [&] { wakes++; });
 
     mgr_.notify("other_key", nlohmann::json("val"));
-    EXPECT_TRUE(received.empty());
+    EXPECT_TRUE(received(id).empty());
+    EXPECT_EQ(wakes, 0);
 
     mgr_.removeConnection(id);
 }
 
 TEST_F(SseManager_test, EmptyFilterReceivesAll)
 {
-    int count = 0;
-    auto id = mgr_.addConnection({}, [&](const std::string &) {
-        count++;
-    });
+    auto id = mgr_.addConnection({}, false, [] {});
 
     mgr_.notify("a", nlohmann::json(1));
     mgr_.notify("b", nlohmann::json(2));
-    EXPECT_EQ(count, 2);
+    EXPECT_EQ(mgr_.dispatch(), 2);
+
+    std::string data;
+    EXPECT_TRUE(mgr_.take(id, data));
+    EXPECT_NE(data.find("\"key\":\"a\""), std::string::npos);
+    EXPECT_LT(data.find("\"key\":\"a\""), data.find("\"key\":\"b\""));
+    EXPECT_FALSE(mgr_.take(id, data)); // drained
 
     mgr_.removeConnection(id);
 }
 
 TEST_F(SseManager_test, RemoveConnectionStopsNotifications)
 {
-    int count = 0;
-    auto id = mgr_.addConnection({}, [&](const std::string &) {
-        count++;
-    });
+    auto id = mgr_.addConnection({}, false, [] {});
 
     mgr_.notify("x", nlohmann::json("before"));
+    mgr_.dispatch();
     mgr_.removeConnection(id);
     mgr_.notify("x", nlohmann::json("after"));
+    EXPECT_EQ(mgr_.dispatch(), 0); // nobody subscribed: not even queued
 
-    EXPECT_EQ(count, 1);
+    std::string data;
+    EXPECT_FALSE(mgr_.take(id, data));
 }
 
 TEST_F(SseManager_test, ActiveConnections)
 {
     EXPECT_EQ(mgr_.activeConnections(), 0u);
-    auto id1 = mgr_.addConnection({}, [](const std::string &) {});
-    auto id2 = mgr_.addConnection({"k"}, [](const std::string &) {});
+    auto id1 = mgr_.addConnection({}, false, [] {});
+    auto id2 = mgr_.addConnection({"k"}, false, [] {});
     EXPECT_EQ(mgr_.activeConnections(), 2u);
     mgr_.removeConnection(id1);
     EXPECT_EQ(mgr_.activeConnections(), 1u);
     mgr_.removeConnection(id2);
     EXPECT_EQ(mgr_.activeConnections(), 0u);
 }
+
+TEST_F(SseManager_test, WakeOnlyWhenQueueStopsBeingEmpty)
+{
+    int wakes = 0;
+    auto id = mgr_.addConnection({}, false, [&] { wakes++; });
+
+    mgr_.notify("a", nlohmann::json(1));
+    mgr_.dispatch();
+    mgr_.notify("a", nlohmann::json(2));
+    mgr_.dispatch();
+    EXPECT_EQ(wakes, 1); // still pending
+
+    std::string data;
+    mgr_.take(id, data);
+    mgr_.notify("a", nlohmann::json(3));
+    mgr_.dispatch();
+    EXPECT_EQ(wakes, 2);
+}
+
+TEST_F(SseManager_test, BoundedQueueDropsOldest)
+{
+    auto id = mgr_.addConnection({}, false, [] {});
+    const std::size_t capacity = h2agent::model::SseManager::ConnectionQueueCapacity;
+
+    for (std::size_t i = 0; i < capacity + 3; i++) {
+        mgr_.notify("k" + std::to_string(i), nlohmann::json(i));
+    }
+    while (mgr_.dispatch() != 0) {}
+    EXPECT_EQ(mgr_.droppedEvents(), 3);
+
+    std::string data;
+    EXPECT_TRUE(mgr_.take(id, data));
+    EXPECT_EQ(data.find("\"key\":\"k2\""), std::string::npos);
+    EXPECT_NE(data.find("\"key\":\"k3\""), std::string::npos);
+    EXPECT_NE(data.find("\"key\":\"k" + std::to_string(capacity + 2) + "\""), std::string::npos);
+}
+
+TEST_F(SseManager_test, CoalesceLastValueWins)
+{
+    auto coalescing = mgr_.addConnection({}, true, [] {});
+    auto plain = mgr_.addConnection({}, false, [] {});
+
+    mgr_.notify("a", nlohmann::json("a1"));
+    mgr_.notify("b", nlohmann::json("b1"));
+    mgr_.notify("a", nlohmann::json("a2"));
+    mgr_.dispatch();
+    EXPECT_EQ(mgr_.coalescedEvents(), 1);
+
+    std::string data;
+    EXPECT_TRUE(mgr_.take(coalescing, data));
+    EXPECT_EQ(data.find("a1"), std::string::npos);
+    EXPECT_LT(data.find("a2"), data.find("b1")); // keeps the position of the pending one
+
+    data.clear();
+    EXPECT_TRUE(mgr_.take(plain, data));
+    EXPECT_NE(data.find("a1"), std::string::npos);
+    EXPECT_NE(data.find("a2"), std::string::npos);
+
+    // Once taken, a new value is queued again
+    mgr_.notify("a", nlohmann::json("a3"));
+    mgr_.dispatch();
+    EXPECT_EQ(mgr_.coalescedEvents(), 1);
+}
+
+TEST_F(SseManager_test, DispatcherThread)
+{
+    std::atomic<int> wakes{0};
+    auto id = mgr_.addConnection({"k"}, false, [&] { wakes++; });
+    mgr_.start();
+
+    mgr_.notify("k", nlohmann::json("v"));
+    for (int i = 0; i < 200 && wakes == 0; i++) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    mgr_.stop();
+
+    EXPECT_EQ(wakes, 1);
+    std::string data;
+    EXPECT_TRUE(mgr_.take(id, data));
+    EXPECT_NE(data.find("\"value\":\"v\""), std::string::npos);
+}
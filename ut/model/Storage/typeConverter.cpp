@@ -64,6 +64,52 @@ TEST_F(TypeConverter_test, ReplaceVariables)
     EXPECT_EQ(result, expected);
 }
 
+TEST_F(TypeConverter_test, ReplaceVariablesKeepsMissingAndMalformed)
+{
+    std::string result = "@{missing}/@{var1}/@{a@{var2}/@{";
+    std::map<std::string, std::string> patterns;
+    patterns["@{var1}"] = "var1";
+    h2agent::model::replaceVariables(result, patterns, vars_, &vault_);
+
+    EXPECT_EQ(result, "@{missing}/value1/@{avalue2/@{");
+}
+
+TEST_F(TypeConverter_test, StringTemplate)
+{
+    h2agent::model::StringTemplate strTemplate;
+    strTemplate.compile("var1=@{var1}; var1var2=@{var1}@{var2}; gvar1=@{gvar1}; missing=@{missing}");
+    EXPECT_TRUE(strTemplate.hasVariables());
+
+    std::string result = "previous content";
+    strTemplate.render(result, vars_, &vault_);
+    EXPECT_EQ(result, "var1=value1; var1var2=value1value2; gvar1=gvalue1; missing=@{missing}");
+
+    vault_.add("gvar2", nlohmann::json({{"a", 1}}));
+    strTemplate.compile("@{gvar2}");
+    strTemplate.render(result, vars_, &vault_);
+    EXPECT_EQ(result, "{\"a\":1}");
+
+    strTemplate.compile("no variables: @{var1}", false);
+    EXPECT_FALSE(strTemplate.hasVariables());
+    strTemplate.render(result, vars_, &vault_);
+    EXPECT_EQ(result, "no variables: @{var1}");
+
+    strTemplate.compile("");
+    strTemplate.render(result, vars_, &vault_);
+    EXPECT_EQ(result, "");
+}
+
+TEST_F(TypeConverter_test, SetStringFromTemplate)
+{
+    h2agent::model::StringTemplate strTemplate;
+    strTemplate.compile("hello @{var1}");
+    tconv_.setStringReplacingVariables(strTemplate, vars_, &vault_);
+
+    bool success;
+    EXPECT_EQ(tconv_.getString(success), "hello value1");
+    EXPECT_EQ(tconv_.getNativeType(), h2agent::model::TypeConverter::NativeType::String);
+}
+
 TEST_F(TypeConverter_test, SetString)
 {
     std::string value = "hello";
@@ -331,3 +377,49 @@ TEST_F(TypeConverter_test, SetObjectMissingPath)
     EXPECT_TRUE(success);
 }
 
+
+TEST_F(TypeConverter_test, SetObjectFromPointer)
+{
+    bool success;
+
+    const nlohmann::json::json_pointer integerPointer("/path_to_basics/integer");
+    EXPECT_TRUE(tconv_.setObject(json_, integerPointer));
+    std::int64_t res_integer = tconv_.getInteger(success);
+    EXPECT_EQ(res_integer, -111);
+    EXPECT_TRUE(success);
+    EXPECT_EQ(tconv_.getNativeType(), h2agent::model::TypeConverter::NativeType::Integer);
+
+    EXPECT_TRUE(tconv_.setObject(json_, nlohmann::json::json_pointer("/path_to_object")));
+    nlohmann::json res_object = tconv_.getObject(success);
+    EXPECT_EQ(res_object.dump(), "{\"bar\":2,\"foo\":1}");
+    EXPECT_TRUE(success);
+
+    EXPECT_FALSE(tconv_.setObject(json_, nlohmann::json::json_pointer("/missing/path")));
+}
+
+TEST_F(TypeConverter_test, SetObjectFromSharedDocument)
+{
+    bool success;
+
+    auto shared = std::make_shared<const nlohmann::json>(json_);
+    EXPECT_TRUE(tconv_.setObject(shared, "/path_to_object"));
+    const nlohmann::json &res_object = tconv_.getObject(success);
+    EXPECT_TRUE(success);
+    EXPECT_EQ(&res_object, &(shared->at(nlohmann::json::json_pointer("/path_to_object")))); // not copied
+    EXPECT_EQ(shared.use_count(), 2); // retained
+
+    EXPECT_TRUE(tconv_.setObject(shared, "/path_to_basics/integer"));
+    EXPECT_EQ(tconv_.getInteger(success), -111);
+    EXPECT_TRUE(success);
+
+    EXPECT_TRUE(tconv_.setObject(shared, ""));
+    EXPECT_EQ(&tconv_.getObject(success), shared.get());
+
+    EXPECT_FALSE(tconv_.setObject(shared, "/missing/path"));
+    EXPECT_EQ(shared.use_count(), 1); // released
+
+    // Value retained after the document is released by its owner:
+    EXPECT_TRUE(tconv_.setObject(shared, "/path_to_object"));
+    shared.reset();
+    EXPECT_EQ(tconv_.getString(success), "{\"bar\":2,\"foo\":1}");
+}
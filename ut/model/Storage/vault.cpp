@@ -140,3 +140,83 @@ TEST_F(Vault_test, LoadJsonWithMixedTypes)
     EXPECT_EQ(vault_.get("obj_key", exists), nlohmann::json({{"nested",true}}));
 }
 
+
+// --- Shared immutable values ---
+
+TEST_F(Vault_test, SharedValues)
+{
+    vault_.load("key1", nlohmann::json({{"a", 1}}));
+
+    std::shared_ptr<const nlohmann::json> first, second;
+    EXPECT_TRUE(vault_.tryGet("key1", first));
+    EXPECT_TRUE(vault_.tryGet("key1", second));
+    EXPECT_EQ(first, second); // same document, not copied
+    EXPECT_FALSE(vault_.tryGet("missing", second));
+
+    // Copy-on-write: former readers keep their snapshot
+    vault_.loadAtPath("key1", "/b", nlohmann::json(2));
+    EXPECT_EQ(*first, nlohmann::json({{"a", 1}}));
+    EXPECT_TRUE(vault_.tryGet("key1", second));
+    EXPECT_EQ(*second, nlohmann::json({{"a", 1}, {"b", 2}}));
+
+    std::string read;
+    EXPECT_TRUE(vault_.tryRead("key1", [&read](const nlohmann::json &value) { read = value.dump(); }));
+    EXPECT_EQ(read, "{\"a\":1,\"b\":2}");
+
+    // Invalid path keeps the entry consistent
+    EXPECT_ANY_THROW(vault_.loadAtPath("key2", "invalid", nlohmann::json(2)));
+    bool exists{};
+    vault_.get("key2", exists);
+    EXPECT_FALSE(exists);
+}
+
+// --- Reserved dynamic response delays ---
+
+TEST_F(Vault_test, ResponseDelays)
+{
+    vault_.load("__core:response-delay-ms:1", nlohmann::json("20"));
+    vault_.load("__core:response-delay-ms:2", nlohmann::json(30));
+    vault_.load("__core:response-delay-ms:3", nlohmann::json("not a number"));
+    EXPECT_TRUE(vault_.empty()); // kept apart
+    EXPECT_EQ(vault_.getResponseDelayMs(1), 20);
+    EXPECT_EQ(vault_.getResponseDelayMs(2), 30);
+    EXPECT_EQ(vault_.getResponseDelayMs(3), 0);
+    EXPECT_EQ(vault_.getResponseDelayMs(4), 0);
+
+    EXPECT_TRUE(vault_.loadJson(R"({"__core:response-delay-ms:1": "0"})"_json));
+    EXPECT_EQ(vault_.getResponseDelayMs(1), 0);
+
+    // Every accessor is routed to the delays table:
+    vault_.add("__core:response-delay-ms:5", nlohmann::json("50"));
+    EXPECT_TRUE(vault_.empty());
+    EXPECT_EQ(vault_.getResponseDelayMs(5), 50);
+    bool exists{};
+    EXPECT_EQ(vault_.get("__core:response-delay-ms:5", exists), nlohmann::json(50));
+    EXPECT_TRUE(exists);
+    nlohmann::json value{};
+    EXPECT_TRUE(vault_.tryGet("__core:response-delay-ms:2", value));
+    EXPECT_EQ(value, nlohmann::json(30));
+    EXPECT_FALSE(vault_.tryGet("__core:response-delay-ms:4", value));
+    vault_.loadAtPath("__core:response-delay-ms:6", "/a", nlohmann::json(1));
+    EXPECT_TRUE(vault_.empty());
+    EXPECT_EQ(vault_.getResponseDelayMs(6), 0);
+
+    vault_.remove("__core:response-delay-ms:2", exists);
+    EXPECT_TRUE(exists);
+    EXPECT_EQ(vault_.getResponseDelayMs(2), 0);
+    vault_.remove("__core:response-delay-ms:2", exists);
+    EXPECT_FALSE(exists);
+
+    // Released at stream close:
+    vault_.releaseResponseDelay(3);
+    vault_.remove("__core:response-delay-ms:3", exists);
+    EXPECT_FALSE(exists);
+
+    // Non-numeric reception is a regular variable:
+    vault_.load("__core:response-delay-ms:foo", nlohmann::json("1"));
+    EXPECT_EQ(vault_.size(), 1);
+
+    EXPECT_TRUE(vault_.clear());
+    EXPECT_FALSE(vault_.clear());
+    EXPECT_EQ(vault_.getResponseDelayMs(1), 0);
+}
@@ -80,22 +80,147 @@ TEST_F(WaitManager_test, VaultTimeout)
 
 TEST_F(WaitManager_test, MaxWaitersEnforced)
 {
-    std::vector<std::thread> threads;
+    std::vector<std::uint64_t> ids;
     for (size_t i = 0; i < h2agent::model::WaitManager::MAX_WAITERS; i++) {
-        threads.emplace_back([this] {
+        ids.push_back(wm_.watch("key1", "never", [](bool, const nlohmann::json&, const nlohmann::json&) {}));
+        ASSERT_NE(ids.back(), 0);
+    }
+    EXPECT_TRUE(wm_.isFull());
+
+    // This one should be rejected (429)
+    EXPECT_EQ(wm_.watch("key1", "never", [](bool, const nlohmann::json&, const nlohmann::json&) {}), 0);
+    nlohmann::json rv, pv;
+    bool rejected{};
+    bool met = wm_.waitForVault("key1", "never", 100, rv, pv, &rejected);
+    EXPECT_FALSE(met);
+    EXPECT_TRUE(rejected);
+
+    // Complete all waiters by satisfying condition
+    vault_.load("key1", "never");
+    EXPECT_EQ(wm_.activeWaiters(), 0);
+}
+
+TEST_F(WaitManager_test, MaxBlockingWaitersEnforced)
+{
+    std::vector<std::thread> waiters;
+    for (size_t i = 0; i < h2agent::model::WaitManager::MAX_BLOCKING_WAITERS; i++) {
+        waiters.emplace_back([this] {
             nlohmann::json rv, pv;
-            wm_.waitForVault("key1", "never", 2000, rv, pv);
+            bool rejected{};
+            EXPECT_TRUE(wm_.waitForVault("key1", "done", 5000, rv, pv, &rejected));
+            EXPECT_FALSE(rejected);
         });
     }
+    while (wm_.activeWaiters() < h2agent::model::WaitManager::MAX_BLOCKING_WAITERS) std::this_thread::yield();
+    EXPECT_EQ(wm_.blockingWaiters(), h2agent::model::WaitManager::MAX_BLOCKING_WAITERS);
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    // Blocking waits are rejected (429), asynchronous ones are still accepted:
+    nlohmann::json rv, pv;
+    bool rejected{};
+    EXPECT_FALSE(wm_.waitForVault("key1", "done", 100, rv, pv, &rejected));
+    EXPECT_TRUE(rejected);
+    bool completed{};
+    EXPECT_NE(wm_.watch("key1", "done", [&completed](bool met, const nlohmann::json&, const nlohmann::json&) { completed = met; }), 0);
+
+    // Release all:
+    vault_.load("key1", "done");
+    for (auto &t: waiters) t.join();
+    EXPECT_TRUE(completed);
+    EXPECT_EQ(wm_.blockingWaiters(), 0);
+    EXPECT_EQ(wm_.activeWaiters(), 0);
+}
 
-    // This one should be rejected (429)
+TEST_F(WaitManager_test, VaultTimeoutNotRejected)
+{
     nlohmann::json rv, pv;
-    bool met = wm_.waitForVault("key1", "never", 100, rv, pv);
+    bool rejected = true;
+    EXPECT_FALSE(wm_.waitForVault("key1", "never", 10, rv, pv, &rejected));
+    EXPECT_FALSE(rejected);
+}
+
+TEST_F(WaitManager_test, WatchCompletedOnlyByOwnKey)
+{
+    vault_.load("key1", "initial");
+
+    int completions = 0;
+    nlohmann::json resultValue, previousValue;
+    std::uint64_t id = wm_.watch("key1", nullptr /* any change */, [&](bool met, const nlohmann::json &value, const nlohmann::json &previous) {
+        EXPECT_TRUE(met);
+        resultValue = value;
+        previousValue = previous;
+        completions++;
+    });
+    EXPECT_NE(id, 0);
+    EXPECT_EQ(wm_.activeWaiters(), 1);
+
+    vault_.load("key2", "changed"); // other key
+    vault_.load("key1", "initial"); // same value
+    EXPECT_EQ(completions, 0);
+
+    vault_.load("key1", "changed");
+    EXPECT_EQ(completions, 1);
+    EXPECT_EQ(previousValue, "initial");
+    EXPECT_EQ(resultValue, "changed");
+    EXPECT_EQ(wm_.activeWaiters(), 0);
+
+    vault_.load("key1", "again"); // completed once
+    EXPECT_EQ(completions, 1);
+}
+
+TEST_F(WaitManager_test, WatchAlreadySatisfiedCompletesSynchronously)
+{
+    vault_.load("key1", "target");
+
+    bool met = false;
+    std::uint64_t id = wm_.watch("key1", "target", [&](bool m, const nlohmann::json&, const nlohmann::json&) { met = m; });
+    EXPECT_NE(id, 0);
+    EXPECT_TRUE(met);
+    EXPECT_EQ(wm_.activeWaiters(), 0);
+
+    nlohmann::json previousValue;
+    EXPECT_FALSE(wm_.cancel("key1", id, previousValue));
+}
+
+TEST_F(WaitManager_test, WatchCancel)
+{
+    vault_.load("key1", "initial");
+
+    int completions = 0;
+    std::uint64_t id = wm_.watch("key1", "target", [&](bool, const nlohmann::json&, const nlohmann::json&) { completions++; });
+
+    nlohmann::json previousValue;
+    EXPECT_FALSE(wm_.cancel("key2", id, previousValue));
+    EXPECT_TRUE(wm_.cancel("key1", id, previousValue));
+    EXPECT_EQ(previousValue, "initial");
+    EXPECT_FALSE(wm_.cancel("key1", id, previousValue));
+    EXPECT_EQ(wm_.activeWaiters(), 0);
+
+    vault_.load("key1", "target");
+    EXPECT_EQ(completions, 0);
+}
+
+TEST_F(WaitManager_test, LoadJsonNotifiesEachKey)
+{
+    int completions = 0;
+    auto cb = [&](bool met, const nlohmann::json&, const nlohmann::json&) { if (met) completions++; };
+    wm_.watch("key1", 1, cb);
+    wm_.watch("key2", nullptr /* any change */, cb);
+    wm_.watch("key3", nullptr /* any change */, cb);
+
+    EXPECT_TRUE(vault_.loadJson(nlohmann::json{{"key1", 1}, {"key2", "x"}}));
+    EXPECT_EQ(completions, 2);
+    EXPECT_EQ(wm_.activeWaiters(), 1);
+}
+
+TEST_F(WaitManager_test, ShutdownCompletesWaiters)
+{
+    bool called = false, met = true;
+    wm_.watch("key1", "target", [&](bool m, const nlohmann::json&, const nlohmann::json&) { called = true; met = m; });
+
+    wm_.shutdown();
+    EXPECT_TRUE(called);
     EXPECT_FALSE(met);
+    EXPECT_EQ(wm_.activeWaiters(), 0);
 
-    // Unblock all waiters by satisfying condition
-    vault_.load("key1", "never");
-    for (auto& t : threads) t.join();
+    EXPECT_EQ(wm_.watch("key1", "target", [](bool, const nlohmann::json&, const nlohmann::json&) {}), 0);
 }
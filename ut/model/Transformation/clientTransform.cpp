@@ -598,6 +598,42 @@ TEST_F(ClientTransform_test, UpdateTriggeringPartialUpdate)
     EXPECT_EQ(provision->getCps(), 200u);
 }
 
+TEST_F(ClientTransform_test, UpdateTriggeringArrival)
+{
+    EXPECT_EQ(adata_.loadClientProvision(client_provision_json_, common_resources_), h2agent::model::AdminClientProvisionData::Success);
+    auto provision = adata_.getClientProvisionData().find("initial", "myFlow");
+    ASSERT_TRUE(provision != nullptr);
+
+    EXPECT_EQ(provision->getArrival(), h2agent::model::AdminClientProvision::Arrival::Uniform);
+    EXPECT_TRUE(provision->updateTriggering("1", "100", "50000", "false", "poisson"));
+    EXPECT_EQ(provision->getArrival(), h2agent::model::AdminClientProvision::Arrival::Poisson);
+    EXPECT_TRUE(provision->updateTriggering("", "", "", "", "burst"));
+    EXPECT_EQ(provision->getArrival(), h2agent::model::AdminClientProvision::Arrival::Burst);
+
+    // Invalid value keeps previous one:
+    EXPECT_FALSE(provision->updateTriggering("", "", "", "", "gaussian"));
+    EXPECT_EQ(provision->getArrival(), h2agent::model::AdminClientProvision::Arrival::Burst);
+}
+
+TEST_F(ClientTransform_test, TickingCongestionDropsAreCounted)
+{
+    EXPECT_EQ(adata_.loadClientProvision(client_provision_json_, common_resources_), h2agent::model::AdminClientProvisionData::Success);
+    auto provision = adata_.getClientProvisionData().find("initial", "myFlow");
+    ASSERT_TRUE(provision != nullptr);
+    EXPECT_TRUE(provision->updateTriggering("1", "1000000", "100000", "false"));
+
+    boost::asio::io_context ioContext;
+    provision->startTicking(&ioContext, []() {
+        return false; // always congested
+    });
+    ioContext.run_for(std::chrono::milliseconds(50));
+    provision->stopTicking();
+    ioContext.run_for(std::chrono::milliseconds(10));
+
+    EXPECT_EQ(provision->getSeq(), 0); // nothing triggered
+    EXPECT_GT(provision->getJson()["dynamics"]["droppedSequences"].get<std::uint64_t>(), 0u);
+}
+
 // ==================== NEEDS STORAGE ====================
 
 TEST_F(ClientTransform_test, NeedsStorageFalseForBasicProvision)
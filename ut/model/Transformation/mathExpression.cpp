@@ -0,0 +1,80 @@
+#include <cmath>
+
+#include <MathExpression.hpp>
+#include <Vault.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+
+class MathExpression_test : public ::testing::Test
+{
+public:
+    h2agent::model::Vault vault_{};
+    std::map<std::string, std::string> variables_{};
+
+    MathExpression_test() {
+        ;
+    }
+};
+
+TEST_F(MathExpression_test, WithoutVariables)
+{
+    h2agent::model::MathExpression expression;
+    expression.load("1+1", {});
+    EXPECT_TRUE(expression.isCompiled());
+    EXPECT_EQ(expression.evaluate(variables_, &vault_), 2);
+}
+
+TEST_F(MathExpression_test, NumericVariables)
+{
+    h2agent::model::MathExpression expression;
+    expression.load("200 + @{rc} * (@{factor}-1)", {{"@{rc}", "rc"}, {"@{factor}", "factor"}});
+    EXPECT_TRUE(expression.isCompiled());
+
+    variables_["rc"] = "2";
+    vault_.load("factor", nlohmann::json(2.5));
+    EXPECT_EQ(expression.evaluate(variables_, &vault_), 203);
+
+    // Values updated on every evaluation:
+    variables_["rc"] = "4";
+    EXPECT_EQ(expression.evaluate(variables_, &vault_), 206);
+
+    // Local variable has priority over vault:
+    variables_["factor"] = "1.5";
+    EXPECT_EQ(expression.evaluate(variables_, &vault_), 202);
+}
+
+TEST_F(MathExpression_test, NegativeValueFallback)
+{
+    h2agent::model::MathExpression expression;
+    expression.load("2-@{x}", {{"@{x}", "x"}});
+    EXPECT_TRUE(expression.isCompiled());
+
+    variables_["x"] = "-3";
+    EXPECT_EQ(expression.evaluate(variables_, &vault_), 5); // "2--3"
+}
+
+TEST_F(MathExpression_test, NonNumericValueFallback)
+{
+    h2agent::model::MathExpression expression;
+    expression.load("@{x}+1", {{"@{x}", "x"}});
+    EXPECT_TRUE(expression.isCompiled());
+
+    variables_["x"] = "abc";
+    EXPECT_TRUE(std::isnan(expression.evaluate(variables_, &vault_)));
+
+    // Missing variable:
+    variables_.clear();
+    EXPECT_TRUE(std::isnan(expression.evaluate(variables_, &vault_)));
+}
+
+TEST_F(MathExpression_test, AdjacentPatternsNotCompiled)
+{
+    h2agent::model::MathExpression expression;
+    expression.load("2@{x}+@{x}@{x}", {{"@{x}", "x"}});
+    EXPECT_FALSE(expression.isCompiled());
+
+    variables_["x"] = "3";
+    EXPECT_EQ(expression.evaluate(variables_, &vault_), 56); // "23+33"
+}
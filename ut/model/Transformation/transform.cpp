@@ -891,6 +891,15 @@ TEST_F(Transform_test, SourceRandom)
     EXPECT_EQ(response_body_, "10"); // predictable random between 10 and 10, to ease test.
 }
 
+TEST_F(Transform_test, SourceRandomInvalidRange)
+{
+    h2agent::model::Transformation transformation{};
+
+    // Validations:
+    EXPECT_FALSE(transformation.load(R"({ "source": "random.10.9", "target": "response.body.string" })"_json));
+    EXPECT_TRUE(transformation.load(R"({ "source": "random.-10.-9", "target": "response.body.string" })"_json));
+}
+
 TEST_F(Transform_test, SourceRandomSet)
 {
     // Build test provision:
@@ -2459,6 +2468,60 @@ TEST_F(Transform_test, NeedsStorageTrueForServerEventToPurgeTarget)
     EXPECT_TRUE(provision->needsStorage());
 }
 
+TEST_F(Transform_test, StaticResponseForBasicProvision)
+{
+    provisionAndTransform(request_body_.dump());
+    auto provision = adata_.getServerProvisionData().find("initial", "GET", "/app/v1/foo/bar/1?name=test");
+    ASSERT_TRUE(provision != nullptr);
+    EXPECT_TRUE(provision->isStaticResponse());
+
+    EXPECT_EQ(status_code_, 200);
+    EXPECT_EQ(response_body_, ProvisionConfiguration_GET_responseBodyAsString);
+    EXPECT_EQ(response_headers_.size(), 2);
+    EXPECT_EQ(out_state_, "initial");
+}
+
+TEST_F(Transform_test, StaticResponseFalseWithTransformOrSchema)
+{
+    server_provision_json_["transform"] = R"([{"source":"value.1","target":"var.one"}])"_json;
+    EXPECT_EQ(adata_.loadServerProvision(server_provision_json_, common_resources_), h2agent::model::AdminServerProvisionData::Success);
+    auto provision = adata_.getServerProvisionData().find("initial", "GET", "/app/v1/foo/bar/1?name=test");
+    ASSERT_TRUE(provision != nullptr);
+    EXPECT_FALSE(provision->isStaticResponse());
+
+    server_provision_json_.erase("transform");
+    server_provision_json_["responseSchemaId"] = "myResponseSchema";
+    EXPECT_EQ(adata_.loadServerProvision(server_provision_json_, common_resources_), h2agent::model::AdminServerProvisionData::Success);
+    provision = adata_.getServerProvisionData().find("initial", "GET", "/app/v1/foo/bar/1?name=test");
+    ASSERT_TRUE(provision != nullptr);
+    EXPECT_FALSE(provision->isStaticResponse());
+}
+
+TEST_F(Transform_test, NeedsRequestBody)
+{
+    server_provision_json_["transform"] = R"([{"source":"value.1","target":"var.one"}])"_json;
+    EXPECT_EQ(adata_.loadServerProvision(server_provision_json_, common_resources_), h2agent::model::AdminServerProvisionData::Success);
+    auto provision = adata_.getServerProvisionData().find("initial", "GET", "/app/v1/foo/bar/1?name=test");
+    ASSERT_TRUE(provision != nullptr);
+    EXPECT_FALSE(provision->needsRequestBody());
+
+    // Request body source within onFilterFail fallback:
+    server_provision_json_["transform"] = R"([{"source":"value.1","target":"var.one","filter":{"ConditionVar":"missing"},"onFilterFail":[{"source":"request.body./foo","target":"var.two"}]}])"_json;
+    EXPECT_EQ(adata_.loadServerProvision(server_provision_json_, common_resources_), h2agent::model::AdminServerProvisionData::Success);
+    provision = adata_.getServerProvisionData().find("initial", "GET", "/app/v1/foo/bar/1?name=test");
+    ASSERT_TRUE(provision != nullptr);
+    EXPECT_TRUE(provision->needsRequestBody());
+
+    server_provision_json_.erase("transform");
+    server_provision_json_["requestSchemaId"] = "myRequestSchema";
+    std::uint64_t generation = adata_.getServerProvisionData().getGeneration();
+    EXPECT_EQ(adata_.loadServerProvision(server_provision_json_, common_resources_), h2agent::model::AdminServerProvisionData::Success);
+    EXPECT_GT(adata_.getServerProvisionData().getGeneration(), generation);
+    provision = adata_.getServerProvisionData().find("initial", "GET", "/app/v1/foo/bar/1?name=test");
+    ASSERT_TRUE(provision != nullptr);
+    EXPECT_TRUE(provision->needsRequestBody());
+}
+
 /////////////////////////////////////
 // SCOPED VARIABLE CHAIN PROPAGATION //
 /////////////////////////////////////